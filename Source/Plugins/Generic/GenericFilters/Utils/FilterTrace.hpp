@@ -0,0 +1,367 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <QtCore/QString>
+
+#ifdef DREAM3D_ENABLE_FILTER_TRACE
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
+/**
+ * @brief The FilterTrace namespace holds a small scoped timer API that filters can use to record how long each
+ * phase of their execute() takes. A filter creates one FilterTrace::Session at the top of execute() and wraps
+ * the interesting parts in FilterTrace::ScopedPhase objects, optionally tagging them with the number of items
+ * processed and the number of bytes touched. ScopedPhase objects may be created inside TBB bodies; every
+ * thread gets its own lane in the trace so the thread utilization of a parallel phase can be read off directly.
+ *
+ * The API only records anything when DREAM3D is configured with DREAM3D_ENABLE_FILTER_TRACE=ON. Otherwise
+ * every class is an empty inline shell that the compiler removes. When enabled, a Session writes its trace
+ * at destruction into the directory named by the DREAM3D_TRACE_DIR environment variable (nothing is written
+ * when it is not set). The output is Chrome trace JSON (chrome://tracing, Perfetto) with a per phase summary,
+ * or a flat CSV file when DREAM3D_TRACE_FORMAT=csv.
+ */
+namespace FilterTrace
+{
+#ifdef DREAM3D_ENABLE_FILTER_TRACE
+
+class Session
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit Session(const QString& filterName)
+  : m_FilterName(filterName.toStdString())
+  , m_Start(Clock::now())
+  {
+    const char* outputDir = std::getenv("DREAM3D_TRACE_DIR");
+    if(outputDir != nullptr && outputDir[0] != '\0')
+    {
+      m_OutputDir = outputDir;
+      m_Active = true;
+    }
+    const char* format = std::getenv("DREAM3D_TRACE_FORMAT");
+    m_WriteCsv = (format != nullptr && std::string(format) == "csv");
+  }
+
+  ~Session()
+  {
+    if(m_Active)
+    {
+      write();
+    }
+  }
+
+  Session(const Session&) = delete;            // Copy Constructor Not Implemented
+  Session(Session&&) = delete;                 // Move Constructor Not Implemented
+  Session& operator=(const Session&) = delete; // Copy Assignment Not Implemented
+  Session& operator=(Session&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Returns true if this session will write a trace
+   */
+  bool isActive() const
+  {
+    return m_Active;
+  }
+
+  /**
+   * @brief Returns the number of microseconds since the session was created
+   */
+  int64_t now() const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_Start).count();
+  }
+
+  /**
+   * @brief Records a completed phase. This is normally called by ScopedPhase and is thread safe.
+   */
+  void record(const char* name, int64_t startUs, int64_t endUs, uint64_t items, uint64_t bytes)
+  {
+    if(!m_Active)
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Events.push_back({name, threadIndex(), startUs, endUs - startUs, items, bytes});
+  }
+
+  /**
+   * @brief Records the value of a named counter at the current time. This is thread safe.
+   */
+  void counter(const char* name, uint64_t value)
+  {
+    if(!m_Active)
+    {
+      return;
+    }
+    int64_t timeUs = now();
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Counters.push_back({name, timeUs, value});
+  }
+
+private:
+  struct Event
+  {
+    const char* name;
+    uint32_t thread;
+    int64_t startUs;
+    int64_t durationUs;
+    uint64_t items;
+    uint64_t bytes;
+  };
+
+  struct Counter
+  {
+    const char* name;
+    int64_t timeUs;
+    uint64_t value;
+  };
+
+  struct PhaseSummary
+  {
+    uint64_t calls = 0;
+    int64_t busyUs = 0;
+    int64_t firstUs = 0;
+    int64_t lastUs = 0;
+    uint64_t items = 0;
+    uint64_t bytes = 0;
+    std::set<uint32_t> threads;
+  };
+
+  std::string m_FilterName;
+  Clock::time_point m_Start;
+  std::string m_OutputDir;
+  bool m_Active = false;
+  bool m_WriteCsv = false;
+  std::mutex m_Mutex;
+  std::vector<Event> m_Events;
+  std::vector<Counter> m_Counters;
+  std::map<std::thread::id, uint32_t> m_ThreadIndices;
+
+  /**
+   * @brief Maps the calling thread onto a small lane index. The caller must hold m_Mutex.
+   */
+  uint32_t threadIndex()
+  {
+    std::thread::id id = std::this_thread::get_id();
+    auto iter = m_ThreadIndices.find(id);
+    if(iter == m_ThreadIndices.end())
+    {
+      iter = m_ThreadIndices.emplace(id, static_cast<uint32_t>(m_ThreadIndices.size())).first;
+    }
+    return iter->second;
+  }
+
+  std::string outputFilePath() const
+  {
+    int64_t stamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return m_OutputDir + "/" + m_FilterName + "_" + std::to_string(stamp) + (m_WriteCsv ? ".csv" : ".json");
+  }
+
+  void write()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::ofstream out(outputFilePath(), std::ios::out | std::ios::trunc);
+    if(!out.is_open())
+    {
+      return;
+    }
+    if(m_WriteCsv)
+    {
+      writeCsv(out);
+    }
+    else
+    {
+      writeJson(out);
+    }
+  }
+
+  void writeCsv(std::ofstream& out) const
+  {
+    out << "type,filter,name,thread,start_us,duration_us,items,bytes,value\n";
+    for(const auto& event : m_Events)
+    {
+      out << "phase," << m_FilterName << "," << event.name << "," << event.thread << "," << event.startUs << "," << event.durationUs << "," << event.items << "," << event.bytes << ",\n";
+    }
+    for(const auto& counter : m_Counters)
+    {
+      out << "counter," << m_FilterName << "," << counter.name << ",," << counter.timeUs << ",,,," << counter.value << "\n";
+    }
+  }
+
+  void writeJson(std::ofstream& out) const
+  {
+    out << "{\n\"traceEvents\": [\n";
+    out << R"(  {"name": "process_name", "ph": "M", "pid": 0, "args": {"name": ")" << m_FilterName << "\"}}";
+    for(const auto& event : m_Events)
+    {
+      out << ",\n  {\"name\": \"" << event.name << "\", \"cat\": \"" << m_FilterName << R"(", "ph": "X", "pid": 0, "tid": )" << event.thread << ", \"ts\": " << event.startUs
+          << ", \"dur\": " << event.durationUs << ", \"args\": {\"items\": " << event.items << ", \"bytes\": " << event.bytes << "}}";
+    }
+    for(const auto& counter : m_Counters)
+    {
+      out << ",\n  {\"name\": \"" << counter.name << R"(", "ph": "C", "pid": 0, "ts": )" << counter.timeUs << ", \"args\": {\"value\": " << counter.value << "}}";
+    }
+    out << "\n],\n";
+
+    // Per phase totals. Utilization is the busy time of all calls divided by the wall time the phase spanned
+    // times the number of threads it ran on, so a perfectly balanced parallel phase reports 1.0
+    std::map<std::string, PhaseSummary> summaries;
+    for(const auto& event : m_Events)
+    {
+      PhaseSummary& summary = summaries[event.name];
+      if(summary.calls == 0)
+      {
+        summary.firstUs = event.startUs;
+        summary.lastUs = event.startUs + event.durationUs;
+      }
+      summary.calls++;
+      summary.busyUs += event.durationUs;
+      summary.firstUs = std::min(summary.firstUs, event.startUs);
+      summary.lastUs = std::max(summary.lastUs, event.startUs + event.durationUs);
+      summary.items += event.items;
+      summary.bytes += event.bytes;
+      summary.threads.insert(event.thread);
+    }
+    out << "\"phaseSummary\": [";
+    bool first = true;
+    for(const auto& entry : summaries)
+    {
+      const PhaseSummary& summary = entry.second;
+      int64_t spanUs = summary.lastUs - summary.firstUs;
+      double utilization = spanUs > 0 ? static_cast<double>(summary.busyUs) / (static_cast<double>(spanUs) * static_cast<double>(summary.threads.size())) : 1.0;
+      out << (first ? "\n" : ",\n") << "  {\"name\": \"" << entry.first << "\", \"calls\": " << summary.calls << ", \"busy_us\": " << summary.busyUs << ", \"span_us\": " << spanUs
+          << ", \"threads\": " << summary.threads.size() << ", \"utilization\": " << utilization << ", \"items\": " << summary.items << ", \"bytes\": " << summary.bytes << "}";
+      first = false;
+    }
+    out << "\n],\n\"displayTimeUnit\": \"ms\"\n}\n";
+  }
+};
+
+/**
+ * @brief The ScopedPhase class records the time between its construction and destruction as one phase event
+ * in the given Session. The name is not copied and must be a string literal.
+ */
+class ScopedPhase
+{
+public:
+  ScopedPhase(Session& session, const char* name, uint64_t items = 0, uint64_t bytes = 0)
+  : m_Session(session.isActive() ? &session : nullptr)
+  , m_Name(name)
+  , m_StartUs(m_Session != nullptr ? m_Session->now() : 0)
+  , m_Items(items)
+  , m_Bytes(bytes)
+  {
+  }
+
+  ~ScopedPhase()
+  {
+    if(m_Session != nullptr)
+    {
+      m_Session->record(m_Name, m_StartUs, m_Session->now(), m_Items, m_Bytes);
+    }
+  }
+
+  ScopedPhase(const ScopedPhase&) = delete;            // Copy Constructor Not Implemented
+  ScopedPhase(ScopedPhase&&) = delete;                 // Move Constructor Not Implemented
+  ScopedPhase& operator=(const ScopedPhase&) = delete; // Copy Assignment Not Implemented
+  ScopedPhase& operator=(ScopedPhase&&) = delete;      // Move Assignment Not Implemented
+
+  void addItems(uint64_t items)
+  {
+    m_Items += items;
+  }
+
+  void addBytes(uint64_t bytes)
+  {
+    m_Bytes += bytes;
+  }
+
+private:
+  Session* m_Session = nullptr;
+  const char* m_Name = nullptr;
+  int64_t m_StartUs = 0;
+  uint64_t m_Items = 0;
+  uint64_t m_Bytes = 0;
+};
+
+#else
+
+class Session
+{
+public:
+  explicit Session(const QString& /*filterName*/)
+  {
+  }
+
+  bool isActive() const
+  {
+    return false;
+  }
+
+  void counter(const char* /*name*/, uint64_t /*value*/)
+  {
+  }
+};
+
+class ScopedPhase
+{
+public:
+  ScopedPhase(Session& /*session*/, const char* /*name*/, uint64_t /*items*/ = 0, uint64_t /*bytes*/ = 0)
+  {
+  }
+
+  void addItems(uint64_t /*items*/)
+  {
+  }
+
+  void addBytes(uint64_t /*bytes*/)
+  {
+  }
+};
+
+#endif
+} // namespace FilterTrace
@@ -35,9 +35,15 @@
 
 #include "ReadStlFile.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <string_view>
 #include <tuple>
 
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
@@ -57,6 +63,10 @@
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
 #define STL_HEADER_LENGTH 80
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -73,7 +83,6 @@ namespace ReadStlFileErrors
 {
 constexpr int32_t k_InputFileNotSet = -1100;
 constexpr int32_t k_InputFileDoesNotExist = -1101;
-constexpr int32_t k_UnsupportedFileType = -1102;
 constexpr int32_t k_ErrorOpeningFile = -1103;
 constexpr int32_t k_StlHeaderParseError = -1104;
 constexpr int32_t k_TriangleCountParseError = -1105;
@@ -81,41 +90,46 @@ constexpr int32_t k_TriangleParseError = -1106;
 constexpr int32_t k_AttributeParseError = -1107;
 } // namespace ReadStlFileErrors
 
+namespace
+{
+constexpr size_t k_StlElementCount = 12;
+constexpr size_t k_StlRecordSize = k_StlElementCount * sizeof(float) + sizeof(uint16_t);
+constexpr size_t k_StlDataStart = STL_HEADER_LENGTH + sizeof(int32_t);
+
 /**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * @brief The ParseStlTrianglesImpl class implements a threaded algorithm that decodes the binary
+ * triangle records straight out of the (memory mapped) file into the vertex list, triangle list
+ * and face normals. Each triangle initially gets its own 3 vertices; duplicates are merged afterwards.
  */
-class FindUniqueIdsImpl
+class ParseStlTrianglesImpl
 {
 public:
-  FindUniqueIdsImpl(SharedVertexList::Pointer vertex, const std::vector<std::vector<size_t>>& nodesInBin, int64_t* uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
+  ParseStlTrianglesImpl(const uchar* data, const std::vector<size_t>& recordOffsets, float* nodes, MeshIndexType* triangles, double* normals)
+  : m_Data(data)
+  , m_RecordOffsets(recordOffsets)
+  , m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_Normals(normals)
   {
   }
 
   // -----------------------------------------------------------------------------
   void convert(size_t start, size_t end) const
   {
-    float* verts = m_Vertex->getPointer(0);
-    for(size_t i = start; i < end; i++)
+    float v[k_StlElementCount];
+    for(size_t t = start; t < end; t++)
     {
-      for(size_t j = 0; j < m_NodesInBin[i].size(); j++)
-      {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == static_cast<int64_t>(node1))
-        {
-          for(size_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(verts[node1 * 3] == verts[node2 * 3] && verts[node1 * 3 + 1] == verts[node2 * 3 + 1] && verts[node1 * 3 + 2] == verts[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
-        }
-      }
+      // An empty offset list means every record has a zero length attribute block
+      const uchar* record = m_RecordOffsets.empty() ? m_Data + k_StlDataStart + t * k_StlRecordSize : m_Data + m_RecordOffsets[t];
+      std::memcpy(v, record, sizeof(v));
+
+      m_Normals[3 * t + 0] = static_cast<double>(v[0]);
+      m_Normals[3 * t + 1] = static_cast<double>(v[1]);
+      m_Normals[3 * t + 2] = static_cast<double>(v[2]);
+      std::copy(v + 3, v + k_StlElementCount, m_Nodes + 9 * t);
+      m_Triangles[t * 3] = 3 * t + 0;
+      m_Triangles[t * 3 + 1] = 3 * t + 1;
+      m_Triangles[t * 3 + 2] = 3 * t + 2;
     }
   }
 
@@ -126,11 +140,89 @@ public:
   }
 
 private:
-  SharedVertexList::Pointer m_Vertex;
-  const std::vector<std::vector<size_t>>& m_NodesInBin;
-  int64_t* m_UniqueIds = nullptr;
+  const uchar* m_Data = nullptr;
+  const std::vector<size_t>& m_RecordOffsets;
+  float* m_Nodes = nullptr;
+  MeshIndexType* m_Triangles = nullptr;
+  double* m_Normals = nullptr;
+};
+
+/**
+ * @brief The UpdateTriangleNodesImpl class implements a threaded algorithm that renumbers the triangle
+ * connectivity to the merged (unique) vertex ids
+ */
+class UpdateTriangleNodesImpl
+{
+public:
+  UpdateTriangleNodesImpl(MeshIndexType* triangles, const int64_t* uniqueIds)
+  : m_Triangles(triangles)
+  , m_UniqueIds(uniqueIds)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_Triangles[i] = static_cast<MeshIndexType>(m_UniqueIds[m_Triangles[i]]);
+    }
+  }
+
+private:
+  MeshIndexType* m_Triangles = nullptr;
+  const int64_t* m_UniqueIds = nullptr;
 };
 
+// -----------------------------------------------------------------------------
+// Skips any white space and returns the next token of an ASCII STL file
+std::string_view nextStlToken(const char*& cursor, const char* end)
+{
+  while(cursor < end && std::isspace(static_cast<unsigned char>(*cursor)) != 0)
+  {
+    cursor++;
+  }
+  const char* start = cursor;
+  while(cursor < end && std::isspace(static_cast<unsigned char>(*cursor)) == 0)
+  {
+    cursor++;
+  }
+  return {start, static_cast<size_t>(cursor - start)};
+}
+
+// -----------------------------------------------------------------------------
+// Reads the next 3 tokens as floats. The conversion is always done in the "C" locale.
+bool readStlFloats(const char*& cursor, const char* end, float* values)
+{
+  for(size_t i = 0; i < 3; i++)
+  {
+    std::string_view token = nextStlToken(cursor, end);
+    bool ok = false;
+    values[i] = QByteArray::fromRawData(token.data(), static_cast<int>(token.size())).toFloat(&ok);
+    if(!ok)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Maps a float to an unsigned key with the same ordering so that vertices can be sorted with integer
+// comparisons, which stay a strict weak ordering even when a coordinate is NaN. -0 and +0 share a key
+// since they compare equal.
+uint32_t orderedFloatKey(float value)
+{
+  if(value == 0.0F)
+  {
+    value = 0.0F;
+  }
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x80000000U) != 0 ? ~bits : (bits | 0x80000000U);
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 // Returns 0 for Binary, 1 for ASCII, anything else is an error.
 int32_t getStlFileType(const std::string& path)
@@ -235,19 +327,6 @@ void ReadStlFile::updateFaceInstancePointers()
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void ReadStlFile::initialize()
-{
-  m_minXcoord = std::numeric_limits<float>::max();
-  m_maxXcoord = -std::numeric_limits<float>::max();
-  m_minYcoord = std::numeric_limits<float>::max();
-  m_maxYcoord = -std::numeric_limits<float>::max();
-  m_minZcoord = std::numeric_limits<float>::max();
-  m_maxZcoord = -std::numeric_limits<float>::max();
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -256,7 +335,6 @@ void ReadStlFile::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  initialize();
   DataArrayPath tempPath;
 
   QFileInfo fi(getStlFilePath());
@@ -273,12 +351,7 @@ void ReadStlFile::dataCheck()
   }
 
   int32_t fileType = getStlFileType(getStlFilePath().toStdString());
-  if(fileType == 1)
-  {
-    QString ss = QObject::tr("The Input STL File is ASCII which is not currently supported. Please convert it to a binary STL file using another program.");
-    setErrorCondition(ReadStlFileErrors::k_UnsupportedFileType, ss);
-  }
-  else if(fileType < 0)
+  if(fileType < 0)
   {
     QString ss = QObject::tr("Error reading the STL file.");
     setErrorCondition(fileType, ss);
@@ -325,7 +398,18 @@ void ReadStlFile::execute()
     return;
   }
 
-  readFile();
+  if(getStlFileType(getStlFilePath().toStdString()) == 1)
+  {
+    readAsciiFile();
+  }
+  else
+  {
+    readFile();
+  }
+  if(getErrorCode() < 0 || getCancel())
+  {
+    return;
+  }
   eliminate_duplicate_nodes();
 
   clearErrorCode();
@@ -340,31 +424,44 @@ void ReadStlFile::readFile()
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
 
   // Open File
-  FILE* f = std::fopen(m_StlFilePath.toLatin1().data(), "rb");
-  if(nullptr == f)
+  QFile stlFile(m_StlFilePath);
+  if(!stlFile.open(QIODevice::ReadOnly))
   {
     setErrorCondition(ReadStlFileErrors::k_ErrorOpeningFile, "Error opening STL file");
     return;
   }
 
-  // Read Header
-  char h[STL_HEADER_LENGTH];
-  int32_t triCount = 0;
-  if(std::fread(h, STL_HEADER_LENGTH, 1, f) != 1)
+  const size_t fileSize = static_cast<size_t>(stlFile.size());
+  if(fileSize < STL_HEADER_LENGTH)
   {
     QString msg = QString("Error reading first 8 bytes of STL header. This can't be good.");
     setErrorCondition(ReadStlFileErrors::k_StlHeaderParseError, msg);
-    std::ignore = fclose(f);
+    return;
+  }
+  if(fileSize < k_StlDataStart)
+  {
+    QString msg = QString("Error reading number of triangles from file. This is bad.");
+    setErrorCondition(ReadStlFileErrors::k_TriangleCountParseError, msg);
     return;
   }
 
+  // Map the file into memory so the triangle records can be decoded in parallel. If the
+  // mapping fails (32 bit address space, special file systems) fall back to reading it.
+  QByteArray fileBuffer;
+  const uchar* data = stlFile.map(0, stlFile.size());
+  if(nullptr == data)
+  {
+    fileBuffer = stlFile.readAll();
+    data = reinterpret_cast<const uchar*>(fileBuffer.constData());
+  }
+
   // Look for the tell-tale signs that the file was written from Magics Materialise
   // If the file was written by Magics as a "Color STL" file then the 2byte int
   // values between each triangle will be NON Zero which will screw up the reading.
   // This NON Zero value does NOT indicate a length but is some sort of color
   // value encoded into the file. Instead of being normal like everyone else and
   // using the STL spec they went off and did their own thing.
-  QByteArray headerArray(h, STL_HEADER_LENGTH);
+  QByteArray headerArray(reinterpret_cast<const char*>(data), STL_HEADER_LENGTH);
   QString headerString(headerArray);
   bool magicsFile = false;
   static const QString k_ColorHeader("COLOR=");
@@ -374,148 +471,167 @@ void ReadStlFile::readFile()
     magicsFile = true;
   }
   // Read the number of triangles in the file.
-  if(std::fread(&triCount, sizeof(int32_t), 1, f) != 1)
+  int32_t triCount = 0;
+  std::memcpy(&triCount, data + STL_HEADER_LENGTH, sizeof(int32_t));
+  const size_t numTris = triCount > 0 ? static_cast<size_t>(triCount) : 0ULL;
+
+  // If the file is exactly the size of zero-length attribute records (or is a Magics file which always
+  // uses 50 byte records) every triangle record sits at a fixed stride. Otherwise walk the records once
+  // to honor each "Attribute byte count" and remember where every triangle starts.
+  std::vector<size_t> recordOffsets;
+  const size_t fixedStrideSize = k_StlDataStart + numTris * k_StlRecordSize;
+  if(fileSize != fixedStrideSize && !(magicsFile && fileSize > fixedStrideSize))
   {
-    QString msg = QString("Error reading number of triangles from file. This is bad.");
-    setErrorCondition(ReadStlFileErrors::k_TriangleCountParseError, msg);
-    std::ignore = fclose(f);
-    return;
+    recordOffsets.resize(numTris);
+    size_t offset = k_StlDataStart;
+    for(size_t t = 0; t < numTris; t++)
+    {
+      if(offset + k_StlRecordSize > fileSize)
+      {
+        QString msg = QString("Error reading Triangle '%1'. The file ended before the complete triangle record could be read.").arg(t);
+        setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+        return;
+      }
+      recordOffsets[t] = offset;
+      uint16_t attr = 0;
+      std::memcpy(&attr, data + offset + k_StlElementCount * sizeof(float), sizeof(uint16_t));
+      offset += k_StlRecordSize;
+      if(!magicsFile)
+      {
+        offset += attr; // Skip past the Triangle Attribute data since we don't know how to read it anyways
+      }
+    }
   }
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
-  triangleGeom->resizeTriList(triCount);
-  triangleGeom->resizeVertexList(triCount * 3);
+  triangleGeom->resizeTriList(numTris);
+  triangleGeom->resizeVertexList(numTris * 3);
   float* nodes = triangleGeom->getVertexPointer(0);
   MeshIndexType* triangles = triangleGeom->getTriPointer(0);
 
   // Resize the triangle attribute matrix to hold the normals and update the normals pointer
-  std::vector<size_t> tDims(1, static_cast<size_t>(triCount));
+  std::vector<size_t> tDims(1, numTris);
   sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateFaceInstancePointers();
 
   // Read the triangles
-  static const size_t k_StlElementCount = 12;
-  float v[k_StlElementCount];
-  uint16_t attr;
-  std::vector<uint8_t> triangleAttributeBuffer(std::numeric_limits<uint16_t>::max()); // Just allocate a buffer of max UINT16 elements
-  for(int32_t t = 0; t < triCount; ++t)
-  {
-    size_t objsRead = std::fread(reinterpret_cast<void*>(v), sizeof(float), k_StlElementCount, f); // Read the Triangle
-    if(k_StlElementCount != objsRead)
-    {
-      QString msg = QString("Error reading Triangle '%1'. Object Count was %2 and should have been %3").arg(t, objsRead, k_StlElementCount);
-      setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
-      std::ignore = fclose(f);
-      return;
-    }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, numTris);
+  dataAlg.execute(ParseStlTrianglesImpl(data, recordOffsets, nodes, triangles, m_FaceNormals));
+}
 
-    objsRead = std::fread(reinterpret_cast<void*>(&attr), sizeof(uint16_t), 1, f); // Read the Triangle Attribute Data length
-    if(objsRead != 1)
-    {
-      QString msg = QString("Error reading Number of attributes for triangle '%1'. Object Count was %2 and should have been 1").arg(t, objsRead);
-      setErrorCondition(ReadStlFileErrors::k_AttributeParseError, msg);
-      std::ignore = fclose(f);
-      return;
-    }
-    if(attr > 0 && !magicsFile)
-    {
-      std::ignore = std::fseek(f, static_cast<size_t>(attr), SEEK_CUR); // Skip past the Triangle Attribute data since we don't know how to read it anyways
-    }
-    if(v[3] < m_minXcoord)
-    {
-      m_minXcoord = v[3];
-    }
-    if(v[3] > m_maxXcoord)
-    {
-      m_maxXcoord = v[3];
-    }
-    if(v[4] < m_minYcoord)
-    {
-      m_minYcoord = v[4];
-    }
-    if(v[4] > m_maxYcoord)
-    {
-      m_maxYcoord = v[4];
-    }
-    if(v[5] < m_minZcoord)
-    {
-      m_minZcoord = v[5];
-    }
-    if(v[5] > m_maxZcoord)
-    {
-      m_maxZcoord = v[5];
-    }
-    if(v[6] < m_minXcoord)
-    {
-      m_minXcoord = v[6];
-    }
-    if(v[6] > m_maxXcoord)
-    {
-      m_maxXcoord = v[6];
-    }
-    if(v[7] < m_minYcoord)
-    {
-      m_minYcoord = v[7];
-    }
-    if(v[7] > m_maxYcoord)
-    {
-      m_maxYcoord = v[7];
-    }
-    if(v[8] < m_minZcoord)
-    {
-      m_minZcoord = v[8];
-    }
-    if(v[8] > m_maxZcoord)
-    {
-      m_maxZcoord = v[8];
-    }
-    if(v[9] < m_minXcoord)
-    {
-      m_minXcoord = v[9];
-    }
-    if(v[9] > m_maxXcoord)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadStlFile::readAsciiFile()
+{
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
+
+  QFile stlFile(m_StlFilePath);
+  if(!stlFile.open(QIODevice::ReadOnly))
+  {
+    setErrorCondition(ReadStlFileErrors::k_ErrorOpeningFile, "Error opening STL file");
+    return;
+  }
+  QByteArray buffer = stlFile.readAll();
+  stlFile.close();
+
+  const char* cursor = buffer.constData();
+  const char* end = cursor + buffer.size();
+
+  // A facet is at least ~200 characters of ASCII text which gives a decent reservation estimate
+  std::vector<float> normals;
+  std::vector<float> vertices;
+  normals.reserve(static_cast<size_t>(buffer.size()) / 200 * 3);
+  vertices.reserve(static_cast<size_t>(buffer.size()) / 200 * 9);
+
+  size_t facetVertexCount = 0;
+  while(cursor < end)
+  {
+    std::string_view token = nextStlToken(cursor, end);
+    if(token == "solid")
     {
-      m_maxXcoord = v[9];
+      // The rest of the line is the (optional) name of the solid which may contain anything
+      while(cursor < end && *cursor != '\n')
+      {
+        cursor++;
+      }
     }
-    if(v[10] < m_minYcoord)
+    else if(token == "facet")
     {
-      m_minYcoord = v[10];
+      float normal[3] = {0.0F, 0.0F, 0.0F};
+      if(nextStlToken(cursor, end) != "normal" || !readStlFloats(cursor, end, normal))
+      {
+        QString msg = QString("Error reading the normal of Triangle '%1'.").arg(normals.size() / 3);
+        setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+        return;
+      }
+      normals.insert(normals.end(), normal, normal + 3);
+      facetVertexCount = 0;
     }
-    if(v[10] > m_maxYcoord)
+    else if(token == "vertex")
     {
-      m_maxYcoord = v[10];
+      if(normals.empty())
+      {
+        setErrorCondition(ReadStlFileErrors::k_TriangleParseError, "Found a vertex before the first facet.");
+        return;
+      }
+      float vertex[3] = {0.0F, 0.0F, 0.0F};
+      if(!readStlFloats(cursor, end, vertex))
+      {
+        QString msg = QString("Error reading a vertex of Triangle '%1'.").arg(normals.size() / 3 - 1);
+        setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+        return;
+      }
+      vertices.insert(vertices.end(), vertex, vertex + 3);
+      facetVertexCount++;
     }
-    if(v[11] < m_minZcoord)
+    else if(token == "endfacet" && normals.empty())
     {
-      m_minZcoord = v[11];
+      setErrorCondition(ReadStlFileErrors::k_TriangleParseError, "Found an endfacet before the first facet.");
+      return;
     }
-    if(v[11] > m_maxZcoord)
+    else if(token == "endfacet" && (facetVertexCount != 3 || vertices.size() != normals.size() * 3))
     {
-      m_maxZcoord = v[11];
+      QString msg = QString("Error reading Triangle '%1'. Vertex Count was %2 and should have been 3").arg(normals.size() / 3 - 1).arg(facetVertexCount);
+      setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+      return;
     }
-    m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
-    m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
-    m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
-    nodes[3 * (3 * t + 0) + 0] = v[3];
-    nodes[3 * (3 * t + 0) + 1] = v[4];
-    nodes[3 * (3 * t + 0) + 2] = v[5];
-    nodes[3 * (3 * t + 1) + 0] = v[6];
-    nodes[3 * (3 * t + 1) + 1] = v[7];
-    nodes[3 * (3 * t + 1) + 2] = v[8];
-    nodes[3 * (3 * t + 2) + 0] = v[9];
-    nodes[3 * (3 * t + 2) + 1] = v[10];
-    nodes[3 * (3 * t + 2) + 2] = v[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
     if(getCancel())
     {
-      std::ignore = fclose(f);
       return;
     }
   }
+  buffer.clear();
 
-  std::ignore = fclose(f);
+  const size_t numTris = normals.size() / 3;
+  if(vertices.size() != numTris * 9)
+  {
+    QString msg = QString("Error reading Triangle '%1'. The file ended before the complete triangle could be read.").arg(numTris - 1);
+    setErrorCondition(ReadStlFileErrors::k_TriangleParseError, msg);
+    return;
+  }
+
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  triangleGeom->resizeTriList(numTris);
+  triangleGeom->resizeVertexList(numTris * 3);
+  float* nodes = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+
+  std::vector<size_t> tDims(1, numTris);
+  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFaceInstancePointers();
+
+  std::copy(vertices.begin(), vertices.end(), nodes);
+  for(size_t t = 0; t < numTris; t++)
+  {
+    m_FaceNormals[3 * t + 0] = static_cast<double>(normals[3 * t + 0]);
+    m_FaceNormals[3 * t + 1] = static_cast<double>(normals[3 * t + 1]);
+    m_FaceNormals[3 * t + 2] = static_cast<double>(normals[3 * t + 2]);
+    triangles[t * 3] = 3 * t + 0;
+    triangles[t * 3 + 1] = 3 * t + 1;
+    triangles[t * 3 + 2] = 3 * t + 2;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -535,47 +651,49 @@ void ReadStlFile::eliminate_duplicate_nodes()
   {
     nNodes = static_cast<size_t>(nNodes_);
   }
-  float stepX = (m_maxXcoord - m_minXcoord) / 100.0f;
-  float stepY = (m_maxYcoord - m_minYcoord) / 100.0f;
-  float stepZ = (m_maxZcoord - m_minZcoord) / 100.0f;
-
-  std::vector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
 
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    xBin = static_cast<int32_t>((vertex[i * 3] - m_minXcoord) / stepX);
-    yBin = static_cast<int32_t>((vertex[i * 3 + 1] - m_minYcoord) / stepY);
-    zBin = static_cast<int32_t>((vertex[i * 3 + 2] - m_minZcoord) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
+  // Sort the node ids by their coordinates so that identical nodes end up next to each other. Ties
+  // are broken by the node id which makes the first node of each run the lowest id of its duplicates.
+  // The coordinates are compared through their ordered integer keys, as comparing NaN coordinates
+  // directly would break the sort.
+  std::vector<size_t> sortedNodes(nNodes);
+  std::iota(sortedNodes.begin(), sortedNodes.end(), 0ULL);
+  auto lessThan = [vertex](size_t a, size_t b) {
+    const float* pA = vertex + a * 3;
+    const float* pB = vertex + b * 3;
+    for(size_t c = 0; c < 3; c++)
     {
-      yBin = 99;
-    }
-    if(zBin == 100)
-    {
-      zBin = 99;
+      uint32_t keyA = orderedFloatKey(pA[c]);
+      uint32_t keyB = orderedFloatKey(pB[c]);
+      if(keyA != keyB)
+      {
+        return keyA < keyB;
+      }
     }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
-  }
+    return a < b;
+  };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(sortedNodes.begin(), sortedNodes.end(), lessThan);
+#else
+  std::sort(sortedNodes.begin(), sortedNodes.end(), lessThan);
+#endif
 
   // Create array to hold unique node numbers
   Int64ArrayType::Pointer uniqueIdsPtr = Int64ArrayType::CreateArray(nNodes, std::string("uniqueIds"), true);
   int64_t* uniqueIds = uniqueIdsPtr->getPointer(0);
-  for(MeshIndexType i = 0; i < nNodes_; i++)
+  size_t firstNode = 0;
+  for(size_t i = 0; i < nNodes; i++)
   {
-    uniqueIds[i] = static_cast<int64_t>(i);
+    size_t node = sortedNodes[i];
+    // A node with a NaN coordinate equals no other node, so it is never merged
+    if(i == 0 || vertex[node * 3] != vertex[firstNode * 3] || vertex[node * 3 + 1] != vertex[firstNode * 3 + 1] || vertex[node * 3 + 2] != vertex[firstNode * 3 + 2])
+    {
+      firstNode = node;
+    }
+    uniqueIds[node] = static_cast<int64_t>(firstNode);
   }
-
-  // Parallel algorithm to find duplicate nodes
-  ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0ULL, static_cast<size_t>(100 * 100 * 100));
-  dataAlg.execute(FindUniqueIdsImpl(triangleGeom->getVertices(), nodesInBin, uniqueIds));
+  sortedNodes.clear();
+  sortedNodes.shrink_to_fit();
 
   // renumber the unique nodes
   int64_t uniqueCount = 0;
@@ -612,20 +730,10 @@ void ReadStlFile::eliminate_duplicate_nodes()
   sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays({static_cast<size_t>(uniqueCount)});
 
   // Update the triangle nodes to reflect the unique ids
-  int64_t node1 = 0, node2 = 0, node3 = 0;
-  for(size_t i = 0; i < static_cast<size_t>(nTriangles); i++)
-  {
-    node1 = triangles[i * 3];
-    node2 = triangles[i * 3 + 1];
-    node3 = triangles[i * 3 + 2];
-
-    triangles[i * 3] = uniqueIds[node1];
-    triangles[i * 3 + 1] = uniqueIds[node2];
-    triangles[i * 3 + 2] = uniqueIds[node3];
-  }
-
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, static_cast<size_t>(nTriangles) * 3);
+  dataAlg.execute(UpdateTriangleNodesImpl(triangles, uniqueIds));
 }
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -241,11 +241,6 @@ protected:
    */
   void dataCheck() override;
 
-  /**
-   * @brief Initializes all the private instance variables.
-   */
-  void initialize();
-
 private:
   std::weak_ptr<DataArray<double>> m_FaceNormalsPtr;
   double* m_FaceNormals = nullptr;
@@ -256,13 +251,6 @@ private:
   QString m_StlFilePath = {""};
   QString m_FaceNormalsArrayName = {SIMPL::FaceData::SurfaceMeshFaceNormals};
 
-  float m_minXcoord = {std::numeric_limits<float>::max()};
-  float m_maxXcoord = {-std::numeric_limits<float>::max()};
-  float m_minYcoord = {std::numeric_limits<float>::max()};
-  float m_maxYcoord = {-std::numeric_limits<float>::max()};
-  float m_minZcoord = {std::numeric_limits<float>::max()};
-  float m_maxZcoord = {-std::numeric_limits<float>::max()};
-
   bool m_ScaleOutput = false;
   float m_ScaleFactor = 1.0F;
 
@@ -272,13 +260,20 @@ private:
   void updateFaceInstancePointers();
 
   /**
-   * @brief readFile Reads the .stl file
+   * @brief readFile Reads a binary .stl file. The file is memory mapped and the
+   * triangle records are decoded in parallel.
    */
   void readFile();
 
+  /**
+   * @brief readAsciiFile Reads an ASCII .stl file
+   */
+  void readAsciiFile();
+
   /**
    * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
-   * created vertex list is shared
+   * created vertex list is shared. Duplicates are found by sorting the nodes
+   * by their coordinates.
    */
   void eliminate_duplicate_nodes();
 
@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/ReadStlFile.h"
+#include "ImportExportTestFileLocations.h"
+
+class ReadStlFileTest
+{
+  const QString k_DataContainerName = {"STL"};
+  const QString k_FaceDataName = {"FaceData"};
+  const QString k_VertexDataName = {"VertexData"};
+  const QString k_FaceNormalsName = {"FaceNormals"};
+
+public:
+  ReadStlFileTest() = default;
+  ~ReadStlFileTest() = default;
+
+  ReadStlFileTest(const ReadStlFileTest&) = delete;            // Copy Constructor
+  ReadStlFileTest(ReadStlFileTest&&) = delete;                 // Move Constructor
+  ReadStlFileTest& operator=(const ReadStlFileTest&) = delete; // Copy Assignment
+  ReadStlFileTest& operator=(ReadStlFileTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  ReadStlFile::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& fileName)
+  {
+    ReadStlFile::Pointer filter = ReadStlFile::New();
+    filter->setDataContainerArray(dca);
+    filter->setStlFilePath(UnitTest::ImportExportTestFilesDir + "/" + fileName);
+    filter->setSurfaceMeshDataContainerName({k_DataContainerName, "", ""});
+    filter->setFaceAttributeMatrixName(k_FaceDataName);
+    filter->setVertexAttributeMatrixName(k_VertexDataName);
+    filter->setFaceNormalsArrayName(k_FaceNormalsName);
+    filter->setScaleOutput(false);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Preflights and then executes the filter on a fresh DataContainerArray, which is returned
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer readFile(const QString& fileName)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    ReadStlFile::Pointer filter = createFilter(dca, fileName);
+    filter->preflight();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+
+    dca = DataContainerArray::New();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Both fixtures describe the tetrahedron A(0,0,0), B(1,0,0), C(0,1,0), D(0,0,1) with the facets ACB, ABD, ADC
+  // and BCD, where the second facet writes A as (-0,0,0). The 12 vertices must merge into 4, numbered in the
+  // order they first appear: A, C, B, D.
+  // -----------------------------------------------------------------------------
+  int checkTetrahedron(const DataContainerArray::Pointer& dca, size_t numTris, size_t numVertices)
+  {
+    TriangleGeom::Pointer triangleGeom = dca->getDataContainer(k_DataContainerName)->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(triangleGeom.get());
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfTris(), numTris);
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), numVertices);
+
+    const float expectedVertices[4][3] = {{0.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}, {1.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 1.0F}};
+    float* vertices = triangleGeom->getVertexPointer(0);
+    for(size_t v = 0; v < 4; v++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(vertices[v * 3 + c], expectedVertices[v][c]);
+      }
+    }
+
+    const MeshIndexType expectedTriangles[4][3] = {{0, 1, 2}, {0, 2, 3}, {0, 3, 1}, {2, 1, 3}};
+    MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+    for(size_t t = 0; t < 4; t++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(triangles[t * 3 + c], expectedTriangles[t][c]);
+      }
+    }
+
+    AttributeMatrix::Pointer faceAM = dca->getAttributeMatrix({k_DataContainerName, k_FaceDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(faceAM->getNumberOfTuples(), numTris);
+    DoubleArrayType::Pointer normals = faceAM->getAttributeArrayAs<DoubleArrayType>(k_FaceNormalsName);
+    DREAM3D_REQUIRE_VALID_POINTER(normals.get());
+    const double expectedNormals[4][3] = {{0.0, 0.0, -1.0}, {0.0, -1.0, 0.0}, {-1.0, 0.0, 0.0}, {0.57735026, 0.57735026, 0.57735026}};
+    for(size_t t = 0; t < 4; t++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE(std::abs(normals->getComponent(t, c) - expectedNormals[t][c]) < 1.0E-6);
+      }
+    }
+
+    AttributeMatrix::Pointer vertexAM = dca->getAttributeMatrix({k_DataContainerName, k_VertexDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(vertexAM->getNumberOfTuples(), numVertices);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReadAsciiFile()
+  {
+    DataContainerArray::Pointer dca = readFile("StlTetrahedronAscii.stl");
+    return checkTetrahedron(dca, 4, 4);
+  }
+
+  // -----------------------------------------------------------------------------
+  // The binary fixture adds a fifth facet (NaN,0,0), (NaN,0,0), B. A NaN coordinate equals nothing, so both
+  // of those vertices are kept while B is still merged.
+  // -----------------------------------------------------------------------------
+  int TestReadBinaryFile()
+  {
+    DataContainerArray::Pointer dca = readFile("StlTetrahedronBinary.stl");
+    int err = checkTetrahedron(dca, 5, 6);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+
+    TriangleGeom::Pointer triangleGeom = dca->getDataContainer(k_DataContainerName)->getGeometryAs<TriangleGeom>();
+    float* vertices = triangleGeom->getVertexPointer(0);
+    for(size_t v = 4; v < 6; v++)
+    {
+      DREAM3D_REQUIRE(std::isnan(vertices[v * 3]));
+      DREAM3D_REQUIRE_EQUAL(vertices[v * 3 + 1], 0.0F);
+      DREAM3D_REQUIRE_EQUAL(vertices[v * 3 + 2], 0.0F);
+    }
+
+    MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+    DREAM3D_REQUIRE_EQUAL(triangles[12], 4);
+    DREAM3D_REQUIRE_EQUAL(triangles[13], 5);
+    DREAM3D_REQUIRE_EQUAL(triangles[14], 2);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A vertex or endfacet before the first facet has no triangle to belong to and must be a parse error (-1106)
+  // -----------------------------------------------------------------------------
+  int TestTokensBeforeFirstFacet()
+  {
+    for(const QString& fileName : {QString("StlVertexBeforeFacet.stl"), QString("StlEndfacetBeforeFacet.stl")})
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      ReadStlFile::Pointer filter = createFilter(dca, fileName);
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -1106);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestReadAsciiFile())
+    DREAM3D_REGISTER_TEST(TestReadBinaryFile())
+    DREAM3D_REGISTER_TEST(TestTokensBeforeFirstFacet())
+  }
+
+private:
+};
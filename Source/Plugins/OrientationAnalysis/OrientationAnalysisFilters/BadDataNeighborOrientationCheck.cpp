@@ -44,6 +44,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
@@ -51,6 +52,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/CellFaceMisorientations.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -74,6 +76,8 @@ void BadDataNeighborOrientationCheck::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, BadDataNeighborOrientationCheck));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Required Number of Neighbors", NumberOfNeighbors, FilterParameter::Category::Parameter, BadDataNeighborOrientationCheck));
+  std::vector<QString> linkedProps = {"FaceMisorientationsArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Face Misorientations", UseFaceMisorientations, FilterParameter::Category::Parameter, BadDataNeighborOrientationCheck, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -87,6 +91,10 @@ void BadDataNeighborOrientationCheck::setupFilterParameters()
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Phases", CellPhasesArrayPath, FilterParameter::Category::RequiredArray, BadDataNeighborOrientationCheck, req));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Misorientations", FaceMisorientationsArrayPath, FilterParameter::Category::RequiredArray, BadDataNeighborOrientationCheck, req));
+  }
   parameters.push_back(SeparatorFilterParameter::Create("Cell Ensemble Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -108,6 +116,8 @@ void BadDataNeighborOrientationCheck::readFilterParameters(AbstractFilterParamet
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   setNumberOfNeighbors(reader->readValue("NumberOfNeighbors", getNumberOfNeighbors()));
+  setUseFaceMisorientations(reader->readValue("UseFaceMisorientations", getUseFaceMisorientations()));
+  setFaceMisorientationsArrayPath(reader->readDataArrayPath("FaceMisorientationsArrayPath", getFaceMisorientationsArrayPath()));
   reader->closeFilterGroup();
 }
 
@@ -168,6 +178,20 @@ void BadDataNeighborOrientationCheck::dataCheck()
     dataArrayPaths.push_back(getCellPhasesArrayPath());
   }
 
+  if(m_UseFaceMisorientations)
+  {
+    cDims[0] = 3;
+    m_FaceMisorientationsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getFaceMisorientationsArrayPath(), cDims);
+    if(nullptr != m_FaceMisorientationsPtr.lock())
+    {
+      m_FaceMisorientations = m_FaceMisorientationsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getFaceMisorientationsArrayPath());
+    }
+  }
+
   getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
 }
 
@@ -207,6 +231,18 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
+  // Returns the misorientation across the face between a cell and its neighbor in direction j. The
+  // precomputed face misorientations are used when available; faces without a value keep "current".
+  auto faceMisorientation = [&](size_t cell, int64_t j, uint32_t laueClass, const QuatF& q1, const QuatF& q2, float current) -> float {
+    if(m_UseFaceMisorientations)
+    {
+      float value = m_FaceMisorientations[CellFaceMisorientations::FaceIndex(static_cast<int64_t>(cell), static_cast<int32_t>(j), neighpoints)];
+      return value < 0.0f ? current : value;
+    }
+    OrientationD axisAngle = m_OrientationOps[laueClass]->calculateMisorientation(q1, q2);
+    return axisAngle[3];
+  };
+
   float w = 10000.0f;
 
   uint32_t phase1 = 0, phase2 = 0;
@@ -261,8 +297,7 @@ void BadDataNeighborOrientationCheck::execute()
 
           if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
           {
-            OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-            w = axisAngle[3];
+            w = faceMisorientation(i, j, phase1, q1, q2, w);
           }
           if(w < misorientationTolerance)
           {
@@ -331,8 +366,7 @@ void BadDataNeighborOrientationCheck::execute()
 
               if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
               {
-                OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                w = axisAngle[3];
+                w = faceMisorientation(i, j, phase1, q1, q2, w);
               }
               if(w < misorientationTolerance)
               {
@@ -518,3 +552,27 @@ DataArrayPath BadDataNeighborOrientationCheck::getQuatsArrayPath() const
 {
   return m_QuatsArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void BadDataNeighborOrientationCheck::setUseFaceMisorientations(bool value)
+{
+  m_UseFaceMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool BadDataNeighborOrientationCheck::getUseFaceMisorientations() const
+{
+  return m_UseFaceMisorientations;
+}
+
+// -----------------------------------------------------------------------------
+void BadDataNeighborOrientationCheck::setFaceMisorientationsArrayPath(const DataArrayPath& value)
+{
+  m_FaceMisorientationsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath BadDataNeighborOrientationCheck::getFaceMisorientationsArrayPath() const
+{
+  return m_FaceMisorientationsArrayPath;
+}
@@ -65,6 +65,8 @@ class OrientationAnalysis_EXPORT BadDataNeighborOrientationCheck : public Abstra
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
+  PYB11_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+  PYB11_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -164,6 +166,28 @@ public:
   DataArrayPath getQuatsArrayPath() const;
   Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
+  /**
+   * @brief Setter property for UseFaceMisorientations
+   */
+  void setUseFaceMisorientations(bool value);
+  /**
+   * @brief Getter property for UseFaceMisorientations
+   * @return Value of UseFaceMisorientations
+   */
+  bool getUseFaceMisorientations() const;
+  Q_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+
+  /**
+   * @brief Setter property for FaceMisorientationsArrayPath
+   */
+  void setFaceMisorientationsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FaceMisorientationsArrayPath
+   * @return Value of FaceMisorientationsArrayPath
+   */
+  DataArrayPath getFaceMisorientationsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -239,6 +263,8 @@ protected:
 private:
   std::weak_ptr<DataArray<float>> m_QuatsPtr;
   float* m_Quats = nullptr;
+  std::weak_ptr<DataArray<float>> m_FaceMisorientationsPtr;
+  float* m_FaceMisorientations = nullptr;
   std::weak_ptr<DataArray<bool>> m_GoodVoxelsPtr;
   bool* m_GoodVoxels = nullptr;
   std::weak_ptr<DataArray<int32_t>> m_CellPhasesPtr;
@@ -252,6 +278,8 @@ private:
   DataArrayPath m_CellPhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases};
   DataArrayPath m_CrystalStructuresArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures};
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
+  bool m_UseFaceMisorientations = {false};
+  DataArrayPath m_FaceMisorientationsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "FaceMisorientations"};
 
   LaueOpsContainer m_OrientationOps;
 
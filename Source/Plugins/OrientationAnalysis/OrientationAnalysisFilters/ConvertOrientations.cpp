@@ -49,6 +49,7 @@
 #include "EbsdLib/OrientationMath/OrientationConverter.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/OrientationBatchConverter.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -222,6 +223,15 @@ void generateRepresentation(ConvertOrientations* filter, typename DataArray<T>::
   using ArrayType = DataArray<T>;
   using ArrayPointerType = typename ArrayType::Pointer;
   using OCType = OrientationConverter<ArrayType, T>;
+
+  // The common conversions are written directly into the output array in parallel. Everything
+  // else goes through the OrientationConverter classes and is copied into the output array.
+  if(OrientationBatchConverter::Convert<T>(inputOrientations->getPointer(0), inputOrientations->getNumberOfComponents(), outputOrientations->getPointer(0),
+                                           outputOrientations->getNumberOfComponents(), inputOrientations->getNumberOfTuples(), filter->getInputType(), filter->getOutputType()))
+  {
+    return;
+  }
+
   std::vector<typename OCType::Pointer> converters(8);
 
   converters[0] = EulerConverter<ArrayType, T>::New();
@@ -34,14 +34,22 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindAvgOrientations.h"
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include <Eigen/Dense>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -49,6 +57,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/OrientationBatchConverter.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -58,6 +67,251 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+/**
+ * @brief The FinalizeAvgOrientationsImpl class normalizes the summed quaternion of each feature and
+ * writes the matching Euler angles in the same pass so no intermediate quaternion array is needed.
+ */
+class FinalizeAvgOrientationsImpl
+{
+public:
+  FinalizeAvgOrientationsImpl(float* avgQuats, float* featureEulers, const std::vector<float>& counts)
+  : m_AvgQuats(avgQuats)
+  , m_FeatureEulers(featureEulers)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      float* avgQuatsPtr = m_AvgQuats + i * 4;                                    // Get the pointer to the current average quaternion
+      QuatF qAvg(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Create a copy of the quaternion
+      qAvg.scalarDivide(m_Counts[i]);
+      qAvg = qAvg.unitQuaternion();
+      qAvg.copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
+
+      OrientationBatchConverter::Kernels<float>::qu2eu(avgQuatsPtr, m_FeatureEulers + (3 * i));
+    }
+  }
+
+private:
+  float* m_AvgQuats;
+  float* m_FeatureEulers;
+  const std::vector<float>& m_Counts;
+};
+
+/**
+ * @brief The FindFirstElementsImpl class records the index of the first Element of each Feature within
+ * each contiguous block of Elements. Merging the blocks in order recovers the serial "first Element".
+ */
+class FindFirstElementsImpl
+{
+public:
+  FindFirstElementsImpl(const int32_t* featureIds, const int32_t* cellPhases, size_t totalPoints, size_t blockSize, std::vector<std::vector<size_t>>& firstElements)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_TotalPoints(totalPoints)
+  , m_BlockSize(blockSize)
+  , m_FirstElements(firstElements)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      std::vector<size_t>& firstElements = m_FirstElements[block];
+      size_t end = std::min(m_TotalPoints, (block + 1) * m_BlockSize);
+      for(size_t i = block * m_BlockSize; i < end; i++)
+      {
+        if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0 && firstElements[m_FeatureIds[i]] == std::numeric_limits<size_t>::max())
+        {
+          firstElements[m_FeatureIds[i]] = i;
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds;
+  const int32_t* m_CellPhases;
+  size_t m_TotalPoints;
+  size_t m_BlockSize;
+  std::vector<std::vector<size_t>>& m_FirstElements;
+};
+
+/**
+ * @brief The AccumulateAvgQuatsImpl class rotates each Element's quaternion to the symmetric equivalent
+ * nearest its Feature's reference orientation and adds it into the accumulator of the Element's block.
+ * Each accumulator entry holds either the quaternion sum or the upper triangle of the summed outer
+ * product (for the eigenvector average), followed by the Element count.
+ */
+class AccumulateAvgQuatsImpl
+{
+public:
+  static constexpr size_t k_MeanStride = 5;
+  static constexpr size_t k_EigenStride = 11;
+
+  AccumulateAvgQuatsImpl(const int32_t* featureIds, const int32_t* cellPhases, const float* quats, const uint32_t* crystalStructures, const std::vector<LaueOps::Pointer>& orientationOps,
+                         const std::vector<float>& referenceQuats, size_t totalPoints, size_t blockSize, bool outerProduct, std::vector<std::vector<double>>& accumulators)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_ReferenceQuats(referenceQuats)
+  , m_TotalPoints(totalPoints)
+  , m_BlockSize(blockSize)
+  , m_OuterProduct(outerProduct)
+  , m_Accumulators(accumulators)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const size_t stride = m_OuterProduct ? k_EigenStride : k_MeanStride;
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      double* accumulator = m_Accumulators[block].data();
+      size_t end = std::min(m_TotalPoints, (block + 1) * m_BlockSize);
+      for(size_t i = block * m_BlockSize; i < end; i++)
+      {
+        if(m_FeatureIds[i] <= 0 || m_CellPhases[i] <= 0)
+        {
+          continue;
+        }
+        const float* refQuatPtr = m_ReferenceQuats.data() + m_FeatureIds[i] * 4;
+        QuatF refQuat(refQuatPtr[0], refQuatPtr[1], refQuatPtr[2], refQuatPtr[3]);
+        const float* voxQuatPtr = m_Quats + i * 4;
+        QuatF voxquat(voxQuatPtr[0], voxQuatPtr[1], voxQuatPtr[2], voxQuatPtr[3]);
+        QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[m_CellPhases[i]]]->getNearestQuat(refQuat, voxquat);
+
+        const double q[4] = {nearestQuat.x(), nearestQuat.y(), nearestQuat.z(), nearestQuat.w()};
+        double* featureAccumulator = accumulator + m_FeatureIds[i] * stride;
+        if(m_OuterProduct)
+        {
+          size_t index = 0;
+          for(size_t r = 0; r < 4; r++)
+          {
+            for(size_t c = r; c < 4; c++)
+            {
+              featureAccumulator[index++] += q[r] * q[c];
+            }
+          }
+        }
+        else
+        {
+          for(size_t c = 0; c < 4; c++)
+          {
+            featureAccumulator[c] += q[c];
+          }
+        }
+        featureAccumulator[stride - 1] += 1.0;
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds;
+  const int32_t* m_CellPhases;
+  const float* m_Quats;
+  const uint32_t* m_CrystalStructures;
+  const std::vector<LaueOps::Pointer>& m_OrientationOps;
+  const std::vector<float>& m_ReferenceQuats;
+  size_t m_TotalPoints;
+  size_t m_BlockSize;
+  bool m_OuterProduct;
+  std::vector<std::vector<double>>& m_Accumulators;
+};
+
+/**
+ * @brief The ReduceAvgQuatsImpl class sums the block accumulators of each Feature in block order and
+ * writes the summed quaternion and count consumed by FinalizeAvgOrientationsImpl. For the eigenvector
+ * average the eigenvector of the largest eigenvalue is written with a count of one.
+ */
+class ReduceAvgQuatsImpl
+{
+public:
+  ReduceAvgQuatsImpl(const std::vector<std::vector<double>>& accumulators, const std::vector<float>& referenceQuats, bool outerProduct, float* avgQuats, std::vector<float>& counts)
+  : m_Accumulators(accumulators)
+  , m_ReferenceQuats(referenceQuats)
+  , m_OuterProduct(outerProduct)
+  , m_AvgQuats(avgQuats)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const size_t stride = m_OuterProduct ? AccumulateAvgQuatsImpl::k_EigenStride : AccumulateAvgQuatsImpl::k_MeanStride;
+    std::vector<double> sum(stride, 0.0);
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      std::fill(sum.begin(), sum.end(), 0.0);
+      for(const auto& accumulator : m_Accumulators)
+      {
+        const double* featureAccumulator = accumulator.data() + i * stride;
+        for(size_t c = 0; c < stride; c++)
+        {
+          sum[c] += featureAccumulator[c];
+        }
+      }
+      // Features without any valid Elements keep the identity sum and a zero count, as in the running average
+      if(sum[stride - 1] == 0.0)
+      {
+        continue;
+      }
+
+      float* avgQuatsPtr = m_AvgQuats + i * 4;
+      if(!m_OuterProduct)
+      {
+        for(size_t c = 0; c < 4; c++)
+        {
+          avgQuatsPtr[c] = static_cast<float>(sum[c]);
+        }
+        m_Counts[i] = static_cast<float>(sum[stride - 1]);
+        continue;
+      }
+
+      Eigen::Matrix4d outerProduct;
+      size_t index = 0;
+      for(Eigen::Index r = 0; r < 4; r++)
+      {
+        for(Eigen::Index c = r; c < 4; c++)
+        {
+          outerProduct(r, c) = sum[index];
+          outerProduct(c, r) = sum[index];
+          index++;
+        }
+      }
+      // Eigenvalues are sorted in increasing order, so the last column belongs to the largest one
+      Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> solver(outerProduct);
+      Eigen::Vector4d avgQuat = solver.eigenvectors().col(3);
+      const float* refQuatPtr = m_ReferenceQuats.data() + i * 4;
+      if(avgQuat[0] * refQuatPtr[0] + avgQuat[1] * refQuatPtr[1] + avgQuat[2] * refQuatPtr[2] + avgQuat[3] * refQuatPtr[3] < 0.0)
+      {
+        avgQuat = -avgQuat;
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        avgQuatsPtr[c] = static_cast<float>(avgQuat[static_cast<Eigen::Index>(c)]);
+      }
+      m_Counts[i] = 1.0f;
+    }
+  }
+
+private:
+  const std::vector<std::vector<double>>& m_Accumulators;
+  const std::vector<float>& m_ReferenceQuats;
+  bool m_OuterProduct;
+  float* m_AvgQuats;
+  std::vector<float>& m_Counts;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -74,6 +328,21 @@ FindAvgOrientations::~FindAvgOrientations() = default;
 void FindAvgOrientations::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Averaging Method");
+    parameter->setPropertyName("AveragingMethod");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(FindAvgOrientations, this, AveragingMethod));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(FindAvgOrientations, this, AveragingMethod));
+
+    std::vector<QString> choices;
+    choices.push_back("Running Average");
+    choices.push_back("Reference Orientation (Parallel)");
+    choices.push_back("Reference Orientation, Eigenvector Average (Parallel)");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
   parameters.push_back(SeparatorFilterParameter::Create("Element Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Category::Element);
@@ -111,6 +380,7 @@ void FindAvgOrientations::setupFilterParameters()
 void FindAvgOrientations::readFilterParameters(AbstractFilterParametersReader* reader, int index)
 {
   reader->openFilterGroup(this, index);
+  setAveragingMethod(reader->readValue("AveragingMethod", getAveragingMethod()));
   setAvgEulerAnglesArrayPath(reader->readDataArrayPath("AvgEulerAnglesArrayPath", getAvgEulerAnglesArrayPath()));
   setAvgQuatsArrayPath(reader->readDataArrayPath("AvgQuatsArrayPath", getAvgQuatsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
@@ -204,26 +474,48 @@ void FindAvgOrientations::execute()
   }
   std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
 
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
   std::vector<float> counts(totalFeatures, 0.0f);
 
-  int32_t phase = 0;
-
   m_AvgQuatsPtr.lock()->initializeWithZeros();
 
-  float* avgQuatsPtr = nullptr;
-  float* currentVoxelQuatPtr = nullptr;
   // Initialize all Average Quats to Identity
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    avgQuatsPtr = m_AvgQuats + i * 4; // Get the pointer to the current average quaternion
+    float* avgQuatsPtr = m_AvgQuats + i * 4; // Get the pointer to the current average quaternion
     QuatF::identity().copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
   }
   // Initialize all Euler Angles to Zero
   m_FeatureEulerAnglesPtr.lock()->initializeWithZeros();
 
+  if(m_AveragingMethod != 0)
+  {
+    findReferenceAverages(m_OrientationOps, counts);
+  }
+  else
+  {
+    findRunningAverages(m_OrientationOps, counts);
+  }
+
+  if(totalFeatures > 1)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1ULL, totalFeatures);
+    dataAlg.execute(FinalizeAvgOrientationsImpl(m_AvgQuats, m_FeatureEulerAngles, counts));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindAvgOrientations::findRunningAverages(const LaueOpsContainer& orientationOps, std::vector<float>& counts)
+{
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  int32_t phase = 0;
+  float* avgQuatsPtr = nullptr;
+  float* currentVoxelQuatPtr = nullptr;
+
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
@@ -237,24 +529,72 @@ void FindAvgOrientations::execute()
 
       currentVoxelQuatPtr = m_Quats + i * 4;                                                                         // Get the pointer to the current voxel's Quaternion
       QuatF voxquat(currentVoxelQuatPtr[0], currentVoxelQuatPtr[1], currentVoxelQuatPtr[2], currentVoxelQuatPtr[3]); // Makes a copy into voxquat!!!!
-      QuatF nearestQuat = m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
+      QuatF nearestQuat = orientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
 
       // QuatF qSum(m_AvgQuats + m_FeatureIds[i] * 4); // Makes a copy into qSum!!!!
       curavgquat = curavgquat + nearestQuat;
       curavgquat.copyInto(avgQuatsPtr, Quaternion<float>::Order::VectorScalar); // Copy back into the m_AvgQuats storage
     }
   }
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindAvgOrientations::findReferenceAverages(const LaueOpsContainer& orientationOps, std::vector<float>& counts)
+{
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
+  bool outerProduct = (m_AveragingMethod == 2);
+  size_t stride = outerProduct ? AccumulateAvgQuatsImpl::k_EigenStride : AccumulateAvgQuatsImpl::k_MeanStride;
+
+  // Every block owns a full set of Feature accumulators, so limit the number of blocks such that the
+  // accumulators stay within the size of the Element quaternion array
+  size_t numBlocks = std::max(1U, std::thread::hardware_concurrency());
+  numBlocks = std::min(numBlocks, std::max<size_t>(1ULL, (2ULL * totalPoints) / (std::max<size_t>(1ULL, totalFeatures) * stride)));
+  size_t blockSize = (totalPoints + numBlocks - 1) / numBlocks;
+  numBlocks = blockSize > 0 ? (totalPoints + blockSize - 1) / blockSize : 0;
+
+  // Phase 1: the reference orientation of each Feature is its first Element rotated to the symmetric
+  // equivalent nearest the identity, which is where the running average starts as well
+  std::vector<std::vector<size_t>> firstElements(numBlocks, std::vector<size_t>(totalFeatures, std::numeric_limits<size_t>::max()));
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numBlocks);
+    dataAlg.execute(FindFirstElementsImpl(m_FeatureIds, m_CellPhases, totalPoints, blockSize, firstElements));
+  }
+  std::vector<float> referenceQuats(totalFeatures * 4, 0.0f);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    avgQuatsPtr = m_AvgQuats + i * 4;                                           // Get the pointer to the current average quaternion
-    QuatF qAvg(avgQuatsPtr[0], avgQuatsPtr[1], avgQuatsPtr[2], avgQuatsPtr[3]); // Create a copy of the quaternion
-    qAvg.scalarDivide(counts[i]);
-    qAvg = qAvg.unitQuaternion();
-    qAvg.copyInto(avgQuatsPtr, QuatF::Order::VectorScalar);
+    QuatF refQuat = QuatF::identity();
+    for(const auto& blockFirstElements : firstElements)
+    {
+      size_t element = blockFirstElements[i];
+      if(element != std::numeric_limits<size_t>::max())
+      {
+        const float* voxQuatPtr = m_Quats + element * 4;
+        QuatF voxquat(voxQuatPtr[0], voxQuatPtr[1], voxQuatPtr[2], voxQuatPtr[3]);
+        refQuat = orientationOps[m_CrystalStructures[m_CellPhases[element]]]->getNearestQuat(QuatF::identity(), voxquat);
+        break;
+      }
+    }
+    refQuat.copyInto(referenceQuats.data() + i * 4, QuatF::Order::VectorScalar);
+  }
+  firstElements.clear();
+
+  // Phase 2: accumulate the symmetry reduced quaternions into the per block Feature accumulators
+  std::vector<std::vector<double>> accumulators(numBlocks, std::vector<double>(totalFeatures * stride, 0.0));
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numBlocks);
+    dataAlg.execute(AccumulateAvgQuatsImpl(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, orientationOps, referenceQuats, totalPoints, blockSize, outerProduct, accumulators));
+  }
 
-    OrientationF eu = OrientationTransformation::qu2eu<Quaternion<float>, Orientation<float>>(qAvg);
-    eu.copyInto(m_FeatureEulerAngles + (3 * i), 3);
+  if(totalFeatures > 1)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1ULL, totalFeatures);
+    dataAlg.execute(ReduceAvgQuatsImpl(accumulators, referenceQuats, outerProduct, m_AvgQuats, counts));
   }
 }
 
@@ -429,3 +769,15 @@ DataArrayPath FindAvgOrientations::getAvgEulerAnglesArrayPath() const
 {
   return m_AvgEulerAnglesArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void FindAvgOrientations::setAveragingMethod(int value)
+{
+  m_AveragingMethod = value;
+}
+
+// -----------------------------------------------------------------------------
+int FindAvgOrientations::getAveragingMethod() const
+{
+  return m_AveragingMethod;
+}
@@ -65,6 +65,7 @@ class OrientationAnalysis_EXPORT FindAvgOrientations : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
   PYB11_PROPERTY(DataArrayPath AvgQuatsArrayPath READ getAvgQuatsArrayPath WRITE setAvgQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath AvgEulerAnglesArrayPath READ getAvgEulerAnglesArrayPath WRITE setAvgEulerAnglesArrayPath)
+  PYB11_PROPERTY(int AveragingMethod READ getAveragingMethod WRITE setAveragingMethod)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -164,6 +165,17 @@ public:
   DataArrayPath getAvgEulerAnglesArrayPath() const;
   Q_PROPERTY(DataArrayPath AvgEulerAnglesArrayPath READ getAvgEulerAnglesArrayPath WRITE setAvgEulerAnglesArrayPath)
 
+  /**
+   * @brief Setter property for AveragingMethod
+   */
+  void setAveragingMethod(int value);
+  /**
+   * @brief Getter property for AveragingMethod
+   * @return Value of AveragingMethod
+   */
+  int getAveragingMethod() const;
+  Q_PROPERTY(int AveragingMethod READ getAveragingMethod WRITE setAveragingMethod)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -236,6 +248,22 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief Sums the symmetry reduced quaternions of each Feature against its running average, visiting
+   * the Elements serially.
+   * @param orientationOps
+   * @param counts Number of Elements summed for each Feature
+   */
+  void findRunningAverages(const LaueOpsContainer& orientationOps, std::vector<float>& counts);
+
+  /**
+   * @brief Sums the symmetry reduced quaternions of each Feature against a fixed reference orientation
+   * (the Feature's first Element) in parallel, optionally as an eigenvector average.
+   * @param orientationOps
+   * @param counts Number of Elements summed for each Feature
+   */
+  void findReferenceAverages(const LaueOpsContainer& orientationOps, std::vector<float>& counts);
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_FeatureIdsPtr;
   int32_t* m_FeatureIds = nullptr;
@@ -256,6 +284,7 @@ private:
   DataArrayPath m_CrystalStructuresArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures};
   DataArrayPath m_AvgQuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::AvgQuats};
   DataArrayPath m_AvgEulerAnglesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::CellData::EulerAngles};
+  int m_AveragingMethod = {0};
 
   LaueOpsContainer m_OrientationOps;
 
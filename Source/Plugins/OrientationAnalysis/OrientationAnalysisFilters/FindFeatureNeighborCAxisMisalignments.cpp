@@ -56,6 +56,7 @@
 #include "EbsdLib/Core/Quaternion.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/FeatureNeighborMetrics.hpp"
 #include "OrientationAnalysis/OrientationAnalysisUtilities.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -231,85 +232,67 @@ void FindFeatureNeighborCAxisMisalignments::execute()
   // reference variable to the pointer with the correct variable name that allows
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  NeighborList<float>& misalignmentList = *(m_CAxisMisalignmentList.lock());
 
-  std::vector<std::vector<float>> misalignmentlists;
-
-  float w = 0.0f;
-  Matrix3fR g1T;
-  g1T.fill(0.0f);
-  Matrix3fR g2T;
-  g2T.fill(0.0f);
-  Eigen::Vector3f c1{0.0f, 0.0f, 0.0f};
-  Eigen::Vector3f c2{0.0f, 0.0f, 0.0f};
-  const Eigen::Vector3f cAxis{0.0f, 0.0f, 1.0f};
-  size_t hexneighborlistsize = 0;
-  //  QuatF q1 = QuaternionMathF::New();
-  //  QuatF q2 = QuaternionMathF::New();
-  //  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
   FloatArrayType::Pointer avgQuatsPtr = m_AvgQuatsPtr.lock();
 
-  uint32_t phase1 = 0, phase2 = 0;
-  size_t nname = 0;
-  misalignmentlists.resize(totalFeatures);
-  float* currentAvgQuatPtr = nullptr;
+  // The sample direction of each Feature's c-axis only depends on the Feature, so it is computed once up front
+  std::vector<Eigen::Vector3f> cAxes(totalFeatures, Eigen::Vector3f(0.0f, 0.0f, 0.0f));
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    currentAvgQuatPtr = avgQuatsPtr->getTuplePointer(i);
-    OrientationF oMatrix1 = OrientationTransformation::qu2om<QuatF, OrientF>({currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]});
+    const Eigen::Vector3f cAxis{0.0f, 0.0f, 1.0f};
+    float* currentAvgQuatPtr = avgQuatsPtr->getTuplePointer(i);
+    OrientationF oMatrix = OrientationTransformation::qu2om<QuatF, OrientF>({currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]});
 
     // transpose the g matrix so when caxis is multiplied by it
     // it will give the sample direction that the caxis is along
-    g1T = OrientationMatrixToGMatrixTranspose(oMatrix1);
-    c1 = g1T * cAxis;
+    Matrix3fR gT = OrientationMatrixToGMatrixTranspose(oMatrix);
+    cAxes[i] = gT * cAxis;
     // normalize so that the dot product can be taken below without
     // dividing by the magnitudes (they would be 1)
-    c1.normalize();
-    misalignmentlists[i].resize(neighborlist[i].size(), -1.0f);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    cAxes[i].normalize();
+  }
+
+  // The angle between two c-axes is symmetric, so each pair is only computed once
+  FeatureNeighborMetrics neighborMetrics(neighborlist, totalFeatures);
+  neighborMetrics.allocateLists(misalignmentList, -1.0f);
+  neighborMetrics.sweep<1>({&misalignmentList}, true, [this, &cAxes](size_t feature, size_t neighbor, std::array<float, 1>& values) {
+    uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature]];
+    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighbor]];
+    if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Hexagonal_High || phase1 == EbsdLib::CrystalStructure::Hexagonal_Low))
     {
-      w = std::numeric_limits<float>::max();
-      nname = neighborlist[i][j];
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      hexneighborlistsize = neighborlist[i].size();
-      if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Hexagonal_High || phase1 == EbsdLib::CrystalStructure::Hexagonal_Low))
+      float w = GeometryMath::CosThetaBetweenVectors(cAxes[feature], cAxes[neighbor]);
+      SIMPLibMath::bound(w, -1.0f, 1.0f);
+      w = acosf(w);
+      if(w > (SIMPLib::Constants::k_PiF / 2))
       {
-        currentAvgQuatPtr = avgQuatsPtr->getTuplePointer(nname);
-        OrientationF oMatrix2 = OrientationTransformation::qu2om<QuatF, OrientF>({currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]});
-
-        // transpose the g matrix so when caxis is multiplied by it
-        // it will give the sample direction that the caxis is along
-        g2T = OrientationMatrixToGMatrixTranspose(oMatrix2);
-        c2 = g2T * cAxis;
-        // normalize so that the dot product can be taken below without
-        // dividing by the magnitudes (they would be 1)
-        c2.normalize();
-
-        w = GeometryMath::CosThetaBetweenVectors(c1, c2);
-        SIMPLibMath::bound(w, -1.0f, 1.0f);
-        w = acosf(w);
-        if(w > (SIMPLib::Constants::k_PiF / 2))
-        {
-          w = SIMPLib::Constants::k_PiF - w;
-        }
-
-        misalignmentlists[i][j] = w * SIMPLib::Constants::k_180OverPiF;
-        if(m_FindAvgMisals)
-        {
-          m_AvgCAxisMisalignments[i] += misalignmentlists[i][j];
-        }
+        w = SIMPLib::Constants::k_PiF - w;
       }
-      else
+      values[0] = w * SIMPLib::Constants::k_180OverPiF;
+    }
+    else
+    {
+      values[0] = NAN;
+    }
+  });
+
+  if(m_FindAvgMisals)
+  {
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      NeighborList<float>::VectorType& misalignments = misalignmentList[i];
+      size_t hexneighborlistsize = misalignments.size();
+      for(const auto& misalignment : misalignments)
       {
-        if(m_FindAvgMisals)
+        if(std::isnan(misalignment))
         {
           hexneighborlistsize--;
         }
-        misalignmentlists[i][j] = NAN;
+        else
+        {
+          m_AvgCAxisMisalignments[i] += misalignment;
+        }
       }
-    }
-    if(m_FindAvgMisals)
-    {
       if(hexneighborlistsize > 0)
       {
         m_AvgCAxisMisalignments[i] /= hexneighborlistsize;
@@ -318,17 +301,8 @@ void FindFeatureNeighborCAxisMisalignments::execute()
       {
         m_AvgCAxisMisalignments[i] = NAN;
       }
-      hexneighborlistsize = 0;
     }
   }
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misaL(new std::vector<float>);
-    misaL->assign(misalignmentlists[i].begin(), misalignmentlists[i].end());
-    m_CAxisMisalignmentList.lock()->setList(static_cast<int32_t>(i), misaL);
-  }
 }
 // -----------------------------------------------------------------------------
 //
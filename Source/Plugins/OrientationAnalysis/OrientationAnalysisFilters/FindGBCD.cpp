@@ -56,6 +56,8 @@
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/LaueOps/LaueOps.h"
 
+#include "Generic/GenericFilters/Utils/FilterTrace.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -584,6 +586,8 @@ void FindGBCD::execute()
     return;
   }
 
+  FilterTrace::Session trace(getNameOfClass());
+
   size_t triangleChunkSize = 50000;
 
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
@@ -594,7 +598,10 @@ void FindGBCD::execute()
     triangleChunkSize = totalFaces;
   }
   // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(triangleChunkSize, k_NumMisoReps);
+  {
+    FilterTrace::ScopedPhase phase(trace, "Size GBCD");
+    sizeGBCD(triangleChunkSize, k_NumMisoReps);
+  }
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
@@ -624,23 +631,28 @@ void FindGBCD::execute()
     {
       triangleChunkSize = totalFaces - i;
     }
-    m_GbcdBinsArray->initializeWithValue(-1);
-    m_GbcdHemiCheckArray->initializeWithValue(false);
+    {
+      FilterTrace::ScopedPhase phase(trace, "Calculate GBCD Bins", triangleChunkSize);
+      m_GbcdBinsArray->initializeWithValue(-1);
+      m_GbcdHemiCheckArray->initializeWithValue(false);
+      CalculateGBCDImpl impl(i, k_NumMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
+                             m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(i, i + triangleChunkSize, triangleChunkSize / std::thread::hardware_concurrency()),
-                      CalculateGBCDImpl(i, k_NumMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                                        m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray));
+      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + triangleChunkSize, triangleChunkSize / std::thread::hardware_concurrency()), [&impl, &trace](const tbb::blocked_range<size_t>& r) {
+        FilterTrace::ScopedPhase threadPhase(trace, "CalculateGBCDImpl", r.size());
+        impl(r);
+      });
 #else
-    CalculateGBCDImpl serial(i, k_NumMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                             m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-    serial.generate(i, i + triangleChunkSize);
+      impl.generate(i, i + triangleChunkSize);
 #endif
+    }
 
     if(getCancel())
     {
       return;
     }
 
+    FilterTrace::ScopedPhase sumPhase(trace, "Sum GBCD Areas", triangleChunkSize);
     int32_t phase = 0;
     int32_t feature = 0;
     double area = 0.0;
@@ -687,6 +699,7 @@ void FindGBCD::execute()
   ss = QObject::tr("2/2 Starting GBCD Normalization Phase");
   notifyStatusMessage(ss);
 
+  FilterTrace::ScopedPhase normalizePhase(trace, "Normalize GBCD", totalPhases * totalGBCDBins, totalPhases * totalGBCDBins * sizeof(double));
   for(int32_t i = 0; i < totalPhases; i++)
   {
     size_t phaseShift = i * totalGBCDBins;
@@ -35,12 +35,15 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -49,6 +52,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Utilities/ParallelData3DAlgorithm.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/Orientation.hpp"
@@ -210,6 +214,180 @@ private:
   const SizeVec3Type& m_UDims;
 };
 
+/**
+ * @brief The FindKernelAvgMisorientationsSlabImpl class computes the KAM for a range of slabs, where a
+ * slab is a run of consecutive rows of the volume (rows of all planes laid end to end). Every voxel
+ * only visits the forward half of its kernel and the misorientation of each pair is added to both the
+ * voxel and its neighbor, so overlapping kernels share a single calculateMisorientation call per pair
+ * instead of evaluating it once from each side. Voxels in the halo rows preceding a slab are visited
+ * as well so that pairs straddling the slab boundary reach the voxels the slab owns; the output array
+ * doubles as the running sum and the counts array holds the running number of pairs.
+ */
+class FindKernelAvgMisorientationsSlabImpl
+{
+public:
+  FindKernelAvgMisorientationsSlabImpl(FindKernelAvgMisorientations* filter, const FloatArrayType& quatPtr, const Int32ArrayType& cellPhases, const Int32ArrayType& featureIds,
+                                       const UInt32ArrayType& crystalStructures, const IntVec3Type& kernelSize, FloatArrayType& kernelAverageMisorientations, const SizeVec3Type& udims,
+                                       int64_t rowsPerSlab, std::vector<int32_t>& counts)
+  : m_Filter(filter)
+  , m_Quats(quatPtr)
+  , m_CellPhases(cellPhases)
+  , m_FeatureIds(featureIds)
+  , m_CrystalStructures(crystalStructures)
+  , m_KernelSize(kernelSize)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  , m_UDims(udims)
+  , m_RowsPerSlab(rowsPerSlab)
+  , m_Counts(counts)
+  {
+  }
+
+  void convert(int64_t rowStart, int64_t rowEnd) const
+  {
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+
+    int64_t xPoints = static_cast<int64_t>(m_UDims[0]);
+    int64_t yPoints = static_cast<int64_t>(m_UDims[1]);
+    int64_t zPoints = static_cast<int64_t>(m_UDims[2]);
+    int64_t kernelX = m_KernelSize[0];
+    int64_t kernelY = m_KernelSize[1];
+    int64_t kernelZ = m_KernelSize[2];
+
+    int64_t ownBegin = rowStart * xPoints;
+    int64_t ownEnd = rowEnd * xPoints;
+    for(int64_t point = ownBegin; point < ownEnd; point++)
+    {
+      m_KernelAverageMisorientations[point] = 0.0f;
+      m_Counts[point] = 0;
+    }
+
+    int64_t progCounter = 0;
+    int64_t progIncrement = (ownEnd - ownBegin) / 100;
+
+    int64_t haloRows = kernelZ * yPoints + kernelY;
+    int64_t firstRow = std::max<int64_t>(0, rowStart - haloRows);
+    for(int64_t globalRow = firstRow; globalRow < rowEnd; globalRow++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t plane = globalRow / yPoints;
+      int64_t row = globalRow % yPoints;
+      for(int64_t col = 0; col < xPoints; col++)
+      {
+        int64_t point = globalRow * xPoints + col;
+        bool pointOwned = (point >= ownBegin);
+        if(pointOwned)
+        {
+          if(progCounter > progIncrement)
+          {
+            m_Filter->sendThreadSafeProgressMessage(progCounter);
+            progCounter = 0;
+          }
+          progCounter++;
+        }
+
+        int32_t featureId = m_FeatureIds[point];
+        if(featureId <= 0)
+        {
+          continue;
+        }
+        int32_t pointPhase = m_CellPhases[point];
+        bool pointValid = pointOwned && pointPhase > 0;
+        float* currentQuatPtr = m_Quats.getTuplePointer(point);
+        QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+
+        // Forward half of the kernel: (j > 0) or (j == 0 && k > 0) or (j == 0 && k == 0 && l >= 0)
+        for(int64_t j = 0; j <= kernelZ && plane + j < zPoints; j++)
+        {
+          for(int64_t k = (j == 0 ? 0 : -kernelY); k <= kernelY && row + k < yPoints; k++)
+          {
+            if(row + k < 0)
+            {
+              continue;
+            }
+            for(int64_t l = (j == 0 && k == 0 ? 0 : -kernelX); l <= kernelX && col + l < xPoints; l++)
+            {
+              if(col + l < 0)
+              {
+                continue;
+              }
+              int64_t neighbor = point + (j * xPoints * yPoints) + (k * xPoints) + l;
+              if(m_FeatureIds[neighbor] != featureId)
+              {
+                continue;
+              }
+              int32_t neighborPhase = m_CellPhases[neighbor];
+              bool neighborValid = neighbor != point && neighbor >= ownBegin && neighbor < ownEnd && neighborPhase > 0;
+              if(!pointValid && !neighborValid)
+              {
+                continue;
+              }
+
+              currentQuatPtr = m_Quats.getTuplePointer(neighbor);
+              QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+
+              float angle = 0.0f;
+              if(pointValid)
+              {
+                OrientationF axisAngle = orientationOps[m_CrystalStructures[pointPhase]]->calculateMisorientation(q1, q2);
+                angle = axisAngle[3];
+                m_KernelAverageMisorientations[point] = m_KernelAverageMisorientations[point] + (angle * SIMPLib::Constants::k_180OverPiD);
+                m_Counts[point]++;
+              }
+              if(neighborValid)
+              {
+                if(!pointValid || neighborPhase != pointPhase)
+                {
+                  OrientationF axisAngle = orientationOps[m_CrystalStructures[neighborPhase]]->calculateMisorientation(q2, q1);
+                  angle = axisAngle[3];
+                }
+                m_KernelAverageMisorientations[neighbor] = m_KernelAverageMisorientations[neighbor] + (angle * SIMPLib::Constants::k_180OverPiD);
+                m_Counts[neighbor]++;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for(int64_t point = ownBegin; point < ownEnd; point++)
+    {
+      if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0 && m_Counts[point] > 0)
+      {
+        m_KernelAverageMisorientations[point] = m_KernelAverageMisorientations[point] / static_cast<float>(m_Counts[point]);
+      }
+      else
+      {
+        m_KernelAverageMisorientations[point] = 0.0f;
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    int64_t totalRows = static_cast<int64_t>(m_UDims[1] * m_UDims[2]);
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      int64_t rowStart = static_cast<int64_t>(slab) * m_RowsPerSlab;
+      convert(rowStart, std::min(rowStart + m_RowsPerSlab, totalRows));
+    }
+  }
+
+private:
+  FindKernelAvgMisorientations* m_Filter;
+  const FloatArrayType& m_Quats;
+  const Int32ArrayType& m_CellPhases;
+  const Int32ArrayType& m_FeatureIds;
+  const UInt32ArrayType& m_CrystalStructures;
+  const IntVec3Type& m_KernelSize;
+  FloatArrayType& m_KernelAverageMisorientations;
+  const SizeVec3Type& m_UDims;
+  int64_t m_RowsPerSlab;
+  std::vector<int32_t>& m_Counts;
+};
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -234,6 +412,7 @@ void FindKernelAvgMisorientations::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Kernel Radius", KernelSize, FilterParameter::Category::Parameter, FindKernelAvgMisorientations));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Reuse Pair Misorientations", ReusePairMisorientations, FilterParameter::Category::Parameter, FindKernelAvgMisorientations));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
 
   {
@@ -270,6 +449,7 @@ void FindKernelAvgMisorientations::readFilterParameters(AbstractFilterParameters
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setKernelSize(reader->readIntVec3("KernelSize", getKernelSize()));
+  setReusePairMisorientations(reader->readValue("ReusePairMisorientations", getReusePairMisorientations()));
   reader->closeFilterGroup();
 }
 
@@ -362,6 +542,22 @@ void FindKernelAvgMisorientations::execute()
 
   m_TotalElements = udims[0] * udims[1] * udims[2];
 
+  if(m_ReusePairMisorientations)
+  {
+    // Slabs are a few kernel depths thick so the halo rows revisited by each slab stay a small fraction of its work
+    int64_t haloRows = static_cast<int64_t>(m_KernelSize[2]) * static_cast<int64_t>(udims[1]) + m_KernelSize[1];
+    int64_t rowsPerSlab = std::max<int64_t>(4 * haloRows, 32);
+    int64_t totalRows = static_cast<int64_t>(udims[1] * udims[2]);
+    size_t numSlabs = static_cast<size_t>((totalRows + rowsPerSlab - 1) / rowsPerSlab);
+    std::vector<int32_t> counts(m_TotalElements, 0);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numSlabs);
+    dataAlg.execute(FindKernelAvgMisorientationsSlabImpl(this, *m_QuatsPtr.lock(), *m_CellPhasesPtr.lock(), *m_FeatureIdsPtr.lock(), *m_CrystalStructuresPtr.lock(), m_KernelSize,
+                                                         *m_KernelAverageMisorientationsPtr.lock(), udims, rowsPerSlab, counts));
+    return;
+  }
+
 #if(SIMPL_USE_PARALLEL_ALGORITHMS == 1)
   tbb::parallel_for(tbb::blocked_range3d<int64_t, int64_t, int64_t>(0, udims[2], 0, udims[1], 0, udims[0]),
                     FindKernelAvgMisorientationsImpl(this, *m_QuatsPtr.lock(), *m_CellPhasesPtr.lock(), *m_FeatureIdsPtr.lock(), *m_CrystalStructuresPtr.lock(), m_KernelSize,
@@ -571,3 +767,15 @@ IntVec3Type FindKernelAvgMisorientations::getKernelSize() const
 {
   return m_KernelSize;
 }
+
+// -----------------------------------------------------------------------------
+void FindKernelAvgMisorientations::setReusePairMisorientations(bool value)
+{
+  m_ReusePairMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindKernelAvgMisorientations::getReusePairMisorientations() const
+{
+  return m_ReusePairMisorientations;
+}
@@ -63,6 +63,7 @@ class OrientationAnalysis_EXPORT FindKernelAvgMisorientations : public AbstractF
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(QString KernelAverageMisorientationsArrayName READ getKernelAverageMisorientationsArrayName WRITE setKernelAverageMisorientationsArrayName)
   PYB11_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
+  PYB11_PROPERTY(bool ReusePairMisorientations READ getReusePairMisorientations WRITE setReusePairMisorientations)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -162,6 +163,17 @@ public:
   IntVec3Type getKernelSize() const;
   Q_PROPERTY(IntVec3Type KernelSize READ getKernelSize WRITE setKernelSize)
 
+  /**
+   * @brief Setter property for ReusePairMisorientations
+   */
+  void setReusePairMisorientations(bool value);
+  /**
+   * @brief Getter property for ReusePairMisorientations
+   * @return Value of ReusePairMisorientations
+   */
+  bool getReusePairMisorientations() const;
+  Q_PROPERTY(bool ReusePairMisorientations READ getReusePairMisorientations WRITE setReusePairMisorientations)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -259,6 +271,7 @@ private:
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
   QString m_KernelAverageMisorientationsArrayName = {SIMPL::CellData::KernelAverageMisorientations};
   IntVec3Type m_KernelSize = {};
+  bool m_ReusePairMisorientations = {false};
 
   // Thread safe Progress Message
   mutable std::mutex m_ProgressMessage_Mutex;
@@ -53,6 +53,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/FeatureNeighborMetrics.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -222,53 +223,47 @@ void FindMisorientations::execute()
   // reference variable to the pointer with the correct variable name that allows
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  NeighborList<float>& misorientationList = *(m_MisorientationList.lock());
 
-  std::vector<std::vector<float>> misorientationlists;
-
-  size_t tempMisoList = 0;
-
-  uint32_t xtalType1 = 0, xtalType2 = 0;
-  int32_t nname = 0;
-  float* currentAvgQuatPtr = nullptr;
-  misorientationlists.resize(totalFeatures);
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    currentAvgQuatPtr = m_AvgQuats + i * 4;
-
+  // The misorientation angle does not depend on which Feature is the reference, so each pair is only computed once
+  FeatureNeighborMetrics neighborMetrics(neighborlist, totalFeatures);
+  neighborMetrics.allocateLists(misorientationList, -1.0f);
+  neighborMetrics.sweep<1>({&misorientationList}, true, [this](size_t feature, size_t neighbor, std::array<float, 1>& values) {
+    float* currentAvgQuatPtr = m_AvgQuats + feature * 4;
     QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-    xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
-    NeighborList<int32_t>::VectorType& featureNeighborList = neighborlist[i];
+    currentAvgQuatPtr = m_AvgQuats + neighbor * 4;
+    QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
 
-    misorientationlists[i].assign(featureNeighborList.size(), -1.0);
+    uint32_t xtalType1 = m_CrystalStructures[m_FeaturePhases[feature]];
+    uint32_t xtalType2 = m_CrystalStructures[m_FeaturePhases[neighbor]];
+    if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(m_OrientationOps.size()))
+    {
+      OrientationD axisAngle = m_OrientationOps[xtalType1]->calculateMisorientation(q1, q2);
+      values[0] = axisAngle[3] * SIMPLib::Constants::k_180OverPiD;
+    }
+    else
+    {
+      values[0] = NAN;
+    }
+  });
 
-    for(size_t j = 0; j < featureNeighborList.size(); j++)
+  if(m_FindAvgMisors)
+  {
+    for(size_t i = 1; i < totalFeatures; i++)
     {
-      nname = featureNeighborList[j];
-      currentAvgQuatPtr = m_AvgQuats + nname * 4;
-      QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-      xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = featureNeighborList.size();
-      if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(m_OrientationOps.size()))
+      NeighborList<float>::VectorType& misorientations = misorientationList[i];
+      size_t tempMisoList = misorientations.size();
+      for(const auto& misorientation : misorientations)
       {
-        OrientationD axisAngle = m_OrientationOps[xtalType1]->calculateMisorientation(q1, q2);
-
-        misorientationlists[i][j] = axisAngle[3] * SIMPLib::Constants::k_180OverPiD;
-        if(m_FindAvgMisors)
+        if(std::isnan(misorientation))
         {
-          m_AvgMisorientations[i] += misorientationlists[i][j];
+          tempMisoList--;
         }
-      }
-      else
-      {
-        if(m_FindAvgMisors)
+        else
         {
-          tempMisoList--;
+          m_AvgMisorientations[i] += misorientation;
         }
-        misorientationlists[i][j] = NAN;
       }
-    }
-    if(m_FindAvgMisors)
-    {
       if(tempMisoList != 0)
       {
         m_AvgMisorientations[i] /= tempMisoList;
@@ -277,17 +272,8 @@ void FindMisorientations::execute()
       {
         m_AvgMisorientations[i] = NAN;
       }
-      tempMisoList = 0;
     }
   }
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misoL(new std::vector<float>);
-    misoL->assign(misorientationlists[i].begin(), misorientationlists[i].end());
-    m_MisorientationList.lock()->setList(static_cast<int32_t>(i), misoL);
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -50,6 +50,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/FeatureNeighborMetrics.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -225,81 +226,39 @@ void FindSlipTransmissionMetrics::execute()
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
 
-  std::vector<std::vector<float>> F1lists;
-  std::vector<std::vector<float>> F1sptlists;
-  std::vector<std::vector<float>> F7lists;
-  std::vector<std::vector<float>> mPrimelists;
+  NeighborList<float>& f1List = *(m_F1List.lock());
+  NeighborList<float>& f1sptList = *(m_F1sptList.lock());
+  NeighborList<float>& f7List = *(m_F7List.lock());
+  NeighborList<float>& mPrimeList = *(m_mPrimeList.lock());
 
-  double mprime = 0.0, F1 = 0.0, F1spt = 0.0, F7 = 0.0;
-  int32_t nname;
+  FeatureNeighborMetrics neighborMetrics(neighborlist, totalFeatures);
+  neighborMetrics.allocateLists(f1List, 0.0f);
+  neighborMetrics.allocateLists(f1sptList, 0.0f);
+  neighborMetrics.allocateLists(f7List, 0.0f);
+  neighborMetrics.allocateLists(mPrimeList, 0.0f);
 
-  // QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  FloatArrayType::Pointer avgQuatPtr = m_AvgQuatsPtr.lock();
+  // F1, F1spt and F7 depend on which Feature the slip is transmitted from, so every ordered pair is computed
+  neighborMetrics.sweep<4>({&mPrimeList, &f1List, &f1sptList, &f7List}, false, [this, &m_OrientationOps](size_t feature, size_t neighbor, std::array<float, 4>& values) {
+    double LD[3] = {0.0f, 0.0f, 1.0f};
 
-  double LD[3] = {0.0f, 0.0f, 1.0f};
+    float* avgQuat = m_AvgQuats + feature * 4;
+    QuatD q1(avgQuat[0], avgQuat[1], avgQuat[2], avgQuat[3]);
+    avgQuat = m_AvgQuats + neighbor * 4;
+    QuatD q2(avgQuat[0], avgQuat[1], avgQuat[2], avgQuat[3]);
 
-  F1lists.resize(totalFeatures);
-  F1sptlists.resize(totalFeatures);
-  F7lists.resize(totalFeatures);
-  mPrimelists.resize(totalFeatures);
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    F1lists[i].assign(neighborlist[i].size(), 0.0f);
-    F1sptlists[i].assign(neighborlist[i].size(), 0.0f);
-    F7lists[i].assign(neighborlist[i].size(), 0.0f);
-    mPrimelists[i].assign(neighborlist[i].size(), 0.0f);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    if(m_CrystalStructures[m_FeaturePhases[feature]] == m_CrystalStructures[m_FeaturePhases[neighbor]] && m_FeaturePhases[feature] > 0)
     {
-      nname = neighborlist[i][j];
-      float* avgQuat = m_AvgQuats + i * 4;
-      QuatD q1(avgQuat[0], avgQuat[1], avgQuat[2], avgQuat[3]);
-      avgQuat = m_AvgQuats + nname * 4;
-      QuatD q2(avgQuat[0], avgQuat[1], avgQuat[2], avgQuat[3]);
-
-      if(m_CrystalStructures[m_FeaturePhases[i]] == m_CrystalStructures[m_FeaturePhases[nname]] && m_FeaturePhases[i] > 0)
-      {
-        mprime = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getmPrime(q1, q2, LD);
-        F1 = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1(q1, q2, LD, true);
-        F1spt = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1spt(q1, q2, LD, true);
-        F7 = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF7(q1, q2, LD, true);
-      }
-      else
-      {
-        mprime = 0.0f;
-        F1 = 0.0f;
-        F1spt = 0.0f;
-        F7 = 0.0f;
-      }
-      mPrimelists[i][j] = mprime;
-      F1lists[i][j] = F1;
-      F1sptlists[i][j] = F1spt;
-      F7lists[i][j] = F7;
+      const LaueOps::Pointer& ops = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[feature]]];
+      values[0] = ops->getmPrime(q1, q2, LD);
+      values[1] = ops->getF1(q1, q2, LD, true);
+      values[2] = ops->getF1spt(q1, q2, LD, true);
+      values[3] = ops->getF7(q1, q2, LD, true);
     }
-  }
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1L(new std::vector<float>);
-    f1L->assign(F1lists[i].begin(), F1lists[i].end());
-    m_F1List.lock()->setList(static_cast<int32_t>(i), f1L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>);
-    f1sptL->assign(F1sptlists[i].begin(), F1sptlists[i].end());
-    m_F1sptList.lock()->setList(static_cast<int32_t>(i), f1sptL);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f7L(new std::vector<float>);
-    f7L->assign(F7lists[i].begin(), F7lists[i].end());
-    m_F7List.lock()->setList(static_cast<int32_t>(i), f7L);
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>);
-    mPrimeL->assign(mPrimelists[i].begin(), mPrimelists[i].end());
-    m_mPrimeList.lock()->setList(static_cast<int32_t>(i), mPrimeL);
-  }
+    else
+    {
+      values.fill(0.0f);
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
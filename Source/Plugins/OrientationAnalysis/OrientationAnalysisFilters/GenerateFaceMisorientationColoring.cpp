@@ -45,6 +45,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/LaueOps/CubicLowOps.h"
@@ -57,36 +58,33 @@
 #include "EbsdLib/LaueOps/TrigonalOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/FaceFeaturePairs.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
 using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
 
 /**
  * @brief The CalculateFaceMisorientationColorsImpl class implements a threaded algorithm that computes the misorientation
- * colors for the given list of surface mesh labels
+ * colors for each unique pair of features found in the surface mesh labels
  */
 class CalculateFaceMisorientationColorsImpl
 {
-  int32_t* m_Labels;
+  const FaceFeaturePairs& m_Pairs;
   int32_t* m_Phases;
   float* m_Quats;
   float* m_Colors;
+  uint8_t* m_Mask;
   unsigned int* m_CrystalStructures;
   LaueOpsContainer m_OrientationOps;
 
 public:
-  CalculateFaceMisorientationColorsImpl(int32_t* labels, int32_t* phases, float* quats, float* colors, unsigned int* crystalStructures)
-  : m_Labels(labels)
+  CalculateFaceMisorientationColorsImpl(const FaceFeaturePairs& pairs, int32_t* phases, float* quats, float* colors, uint8_t* mask, unsigned int* crystalStructures)
+  : m_Pairs(pairs)
   , m_Phases(phases)
   , m_Quats(quats)
   , m_Colors(colors)
+  , m_Mask(mask)
   , m_CrystalStructures(crystalStructures)
   {
     m_OrientationOps = LaueOps::GetAllOrientationOps();
@@ -96,14 +94,11 @@ public:
   void generate(size_t start, size_t end) const
   {
     int32_t feature1 = 0, feature2 = 0, phase1 = 0, phase2 = 0;
-    //    QuatF q1 = QuaternionMathF::New();
-    //    QuatF q2 = QuaternionMathF::New();
-    //    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
     for(size_t i = start; i < end; i++)
     {
-      feature1 = m_Labels[2 * i];
-      feature2 = m_Labels[2 * i + 1];
+      feature1 = m_Pairs.getFeature1(i);
+      feature2 = m_Pairs.getFeature2(i);
       if(feature1 > 0)
       {
         phase1 = m_Phases[feature1];
@@ -120,20 +115,22 @@ public:
       {
         phase2 = 0;
       }
+      m_Mask[i] = 1;
       if(phase1 > 0 && phase1 == phase2)
       {
+        m_Mask[i] = 0;
         if((m_CrystalStructures[phase1] == EbsdLib::CrystalStructure::Hexagonal_High) || (m_CrystalStructures[phase1] == EbsdLib::CrystalStructure::Cubic_High))
         {
           float* quatPtr = m_Quats + feature1 * 4;
           QuatD q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
           quatPtr = m_Quats + feature2 * 4;
           QuatD q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
-          // double w = 0.0f, n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
           OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
 
           m_Colors[3 * i + 0] = axisAngle[0] * (axisAngle[3] * SIMPLib::Constants::k_180OverPiD);
           m_Colors[3 * i + 1] = axisAngle[1] * (axisAngle[3] * SIMPLib::Constants::k_180OverPiD);
           m_Colors[3 * i + 2] = axisAngle[2] * (axisAngle[3] * SIMPLib::Constants::k_180OverPiD);
+          m_Mask[i] = 1;
         }
       }
       else
@@ -145,16 +142,10 @@ public:
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  /**
-   * @brief operator () This is called from the TBB stye of code
-   * @param r The range to compute the values
-   */
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
   {
-    generate(r.begin(), r.end());
+    generate(range.min(), range.max());
   }
-#endif
 };
 
 // -----------------------------------------------------------------------------
@@ -327,20 +318,19 @@ void GenerateFaceMisorientationColoring::execute()
     return;
   }
 
-  int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
+  size_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceMisorientationColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceMisorientationColors, m_CrystalStructures), tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateFaceMisorientationColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceMisorientationColors, m_CrystalStructures);
-    serial.generate(0, numTriangles);
-  }
+  // The color only depends on the two features, so compute it once for each pair of features
+  FaceFeaturePairs pairs(m_SurfaceMeshFaceLabels, numTriangles);
+  size_t numPairs = pairs.getNumberOfPairs();
+  std::vector<float> pairColors(numPairs * 3, 0.0f);
+  std::vector<uint8_t> pairMask(numPairs, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, numPairs);
+  dataAlg.execute(CalculateFaceMisorientationColorsImpl(pairs, m_FeaturePhases, m_AvgQuats, pairColors.data(), pairMask.data(), m_CrystalStructures));
+
+  pairs.scatter<float>(pairColors.data(), pairMask.data(), m_SurfaceMeshFaceMisorientationColors, 3);
 }
 // -----------------------------------------------------------------------------
 //
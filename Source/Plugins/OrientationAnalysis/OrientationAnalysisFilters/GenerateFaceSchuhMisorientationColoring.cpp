@@ -34,12 +34,6 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "GenerateFaceSchuhMisorientationColoring.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -51,6 +45,7 @@
 #include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/LaueOps/CubicLowOps.h"
@@ -66,39 +61,36 @@
 #include "EbsdLib/LaueOps/TrigonalOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/FaceFeaturePairs.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
-using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
-
 /**
- * @brief The CalculateFaceSchuhMisorientationColorsImpl class
+ * @brief The CalculateFaceSchuhMisorientationColorsImpl class computes the Schuh misorientation color for
+ * each unique pair of features found in the surface mesh labels
  */
 class CalculateFaceSchuhMisorientationColorsImpl
 {
-  int32_t* m_Labels;
+  const FaceFeaturePairs& m_Pairs;
   int32_t* m_Phases;
   float* m_Quats;
   uint8_t* m_Colors;
   unsigned int* m_CrystalStructures;
-  LaueOpsContainer m_OrientationOps;
 
 public:
-  CalculateFaceSchuhMisorientationColorsImpl(int32_t* labels, int32_t* phases, float* quats, uint8_t* colors, unsigned int* crystalStructures)
-  : m_Labels(labels)
+  CalculateFaceSchuhMisorientationColorsImpl(const FaceFeaturePairs& pairs, int32_t* phases, float* quats, uint8_t* colors, unsigned int* crystalStructures)
+  : m_Pairs(pairs)
   , m_Phases(phases)
   , m_Quats(quats)
   , m_Colors(colors)
   , m_CrystalStructures(crystalStructures)
   {
-    m_OrientationOps = LaueOps::GetAllOrientationOps();
   }
   virtual ~CalculateFaceSchuhMisorientationColorsImpl() = default;
 
   /**
-   * @brief generate Generates the colors for the triangles
-   * @param start The starting SIMPL::SurfaceMesh::Face_t Index
-   * @param end The ending SIMPL::SurfaceMesh::Face_t Index
+   * @brief generate Generates the colors for the feature pairs
+   * @param start The starting pair Index
+   * @param end The ending pair Index
    */
   void generate(size_t start, size_t end) const
   {
@@ -107,12 +99,10 @@ public:
 
     int grain1, grain2, phase1, phase2;
 
-    // QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
     for(size_t i = start; i < end; i++)
     {
-      grain1 = m_Labels[2 * i];
-      grain2 = m_Labels[2 * i + 1];
+      grain1 = m_Pairs.getFeature1(i);
+      grain2 = m_Pairs.getFeature2(i);
       if(grain1 > 0)
       {
         phase1 = m_Phases[grain1];
@@ -140,9 +130,9 @@ public:
         {
           if(m_CrystalStructures[phase1] == EbsdLib::CrystalStructure::Cubic_High)
           {
-            float* quatPtr = m_Quats + i * grain1;
+            float* quatPtr = m_Quats + grain1 * 4;
             QuatD q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
-            quatPtr = m_Quats + i * grain2;
+            quatPtr = m_Quats + grain2 * 4;
             QuatD q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
 
             argb = ops[m_CrystalStructures[phase1]]->generateMisorientationColor(q1, q2);
@@ -155,16 +145,10 @@ public:
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  /**
-   * @brief operator () This is called from the TBB stye of code
-   * @param r The range to compute the values
-   */
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
   {
-    generate(r.begin(), r.end());
+    generate(range.min(), range.max());
   }
-#endif
 };
 
 // -----------------------------------------------------------------------------
@@ -312,22 +296,18 @@ void GenerateFaceSchuhMisorientationColoring::execute()
 
   notifyStatusMessage("Starting");
 
-  // Run the data check to allocate the memory for the centroid array
-  int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
+  size_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceSchuhMisorientationColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceSchuhMisorientationColors, m_CrystalStructures),
-                      tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    CalculateFaceSchuhMisorientationColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceSchuhMisorientationColors, m_CrystalStructures);
-    serial.generate(0, numTriangles);
-  }
+  // The color only depends on the two features, so compute it once for each pair of features
+  FaceFeaturePairs pairs(m_SurfaceMeshFaceLabels, numTriangles);
+  size_t numPairs = pairs.getNumberOfPairs();
+  std::vector<uint8_t> pairColors(numPairs * 3, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, numPairs);
+  dataAlg.execute(CalculateFaceSchuhMisorientationColorsImpl(pairs, m_FeaturePhases, m_AvgQuats, pairColors.data(), m_CrystalStructures));
+
+  pairs.scatter<uint8_t>(pairColors.data(), nullptr, m_SurfaceMeshFaceSchuhMisorientationColors, 3);
 }
 // -----------------------------------------------------------------------------
 //
@@ -93,6 +93,11 @@ public:
     int32_t phase = 0;
     bool calcIPF = false;
     size_t index = 0;
+    // Neighboring elements very often share the same orientation (cleaned or averaged data) so the
+    // last color is reused when the phase and Euler angles have not changed.
+    bool haveLastColor = false;
+    int32_t lastPhase = 0;
+    double lastEuler[3] = {0.0, 0.0, 0.0};
     for(size_t i = start; i < end; i++)
     {
       phase = m_CellPhases[i];
@@ -118,7 +123,15 @@ public:
 
       if(phase < m_NumPhases && calcIPF && m_CrystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
       {
-        argb = ops[m_CrystalStructures[phase]]->generateIPFColor(dEuler, refDir, false);
+        if(!haveLastColor || phase != lastPhase || dEuler[0] != lastEuler[0] || dEuler[1] != lastEuler[1] || dEuler[2] != lastEuler[2])
+        {
+          argb = ops[m_CrystalStructures[phase]]->generateIPFColor(dEuler, refDir, false);
+          haveLastColor = true;
+          lastPhase = phase;
+          lastEuler[0] = dEuler[0];
+          lastEuler[1] = dEuler[1];
+          lastEuler[2] = dEuler[2];
+        }
         m_CellIPFColors[index] = static_cast<uint8_t>(RgbColor::dRed(argb));
         m_CellIPFColors[index + 1] = static_cast<uint8_t>(RgbColor::dGreen(argb));
         m_CellIPFColors[index + 2] = static_cast<uint8_t>(RgbColor::dBlue(argb));
@@ -46,6 +46,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -54,6 +55,7 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/CellFaceMisorientations.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -132,6 +134,8 @@ void NeighborOrientationCorrelation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Confidence Index", MinConfidence, FilterParameter::Category::Parameter, NeighborOrientationCorrelation));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, NeighborOrientationCorrelation));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Cleanup Level", Level, FilterParameter::Category::Parameter, NeighborOrientationCorrelation));
+  std::vector<QString> linkedProps = {"FaceMisorientationsArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Face Misorientations", UseFaceMisorientations, FilterParameter::Category::Parameter, NeighborOrientationCorrelation, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
 
   {
@@ -146,6 +150,10 @@ void NeighborOrientationCorrelation::setupFilterParameters()
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Quaternions", QuatsArrayPath, FilterParameter::Category::RequiredArray, NeighborOrientationCorrelation, req));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Misorientations", FaceMisorientationsArrayPath, FilterParameter::Category::RequiredArray, NeighborOrientationCorrelation, req));
+  }
   parameters.push_back(SeparatorFilterParameter::Create("Cell Ensemble Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -216,6 +224,20 @@ void NeighborOrientationCorrelation::dataCheck()
     dataArrayPaths.push_back(getQuatsArrayPath());
   }
 
+  if(m_UseFaceMisorientations)
+  {
+    cDims[0] = 3;
+    m_FaceMisorientationsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getFaceMisorientationsArrayPath(), cDims);
+    if(nullptr != m_FaceMisorientationsPtr.lock())
+    {
+      m_FaceMisorientations = m_FaceMisorientationsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getFaceMisorientationsArrayPath());
+    }
+  }
+
   getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
 }
 
@@ -336,7 +358,18 @@ void NeighborOrientationCorrelation::execute()
             OrientationD axisAngle(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
             if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
             {
-              axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+              if(m_UseFaceMisorientations)
+              {
+                float faceValue = m_FaceMisorientations[CellFaceMisorientations::FaceIndex(static_cast<int64_t>(i), static_cast<int32_t>(j), neighpoints)];
+                if(faceValue >= 0.0f)
+                {
+                  axisAngle[3] = faceValue;
+                }
+              }
+              else
+              {
+                axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+              }
             }
             if(axisAngle[3] > misorientationToleranceR)
             {
@@ -449,6 +482,11 @@ void NeighborOrientationCorrelation::execute()
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
+    if(m_UseFaceMisorientations)
+    {
+      // The face misorientations are recomputed below instead of being copied with the cell
+      voxelArrayNames.removeAll(m_FaceMisorientationsArrayPath.getDataArrayName());
+    }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     // The idea for this parallel section is to parallelize over each Data Array that
@@ -497,6 +535,16 @@ void NeighborOrientationCorrelation::execute()
       }
     }
 
+    if(m_UseFaceMisorientations)
+    {
+      std::vector<uint8_t> changed(totalPoints, 0);
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        changed[i] = static_cast<uint8_t>(bestNeighbor[i] != -1);
+      }
+      CellFaceMisorientations::Compute(m_Quats, m_CellPhases, m_CrystalStructures, dims, m_FaceMisorientations, changed.data());
+    }
+
     currentLevel = currentLevel - 1;
     m_CurrentLevel = currentLevel;
   }
@@ -702,6 +750,30 @@ DataArrayPath NeighborOrientationCorrelation::getQuatsArrayPath() const
   return m_QuatsArrayPath;
 }
 
+// -----------------------------------------------------------------------------
+void NeighborOrientationCorrelation::setUseFaceMisorientations(bool value)
+{
+  m_UseFaceMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool NeighborOrientationCorrelation::getUseFaceMisorientations() const
+{
+  return m_UseFaceMisorientations;
+}
+
+// -----------------------------------------------------------------------------
+void NeighborOrientationCorrelation::setFaceMisorientationsArrayPath(const DataArrayPath& value)
+{
+  m_FaceMisorientationsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath NeighborOrientationCorrelation::getFaceMisorientationsArrayPath() const
+{
+  return m_FaceMisorientationsArrayPath;
+}
+
 // -----------------------------------------------------------------------------
 void NeighborOrientationCorrelation::setIgnoredDataArrayPaths(const std::vector<DataArrayPath>& value)
 {
@@ -66,6 +66,8 @@ class OrientationAnalysis_EXPORT NeighborOrientationCorrelation : public Abstrac
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
+  PYB11_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+  PYB11_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -176,6 +178,28 @@ public:
   DataArrayPath getQuatsArrayPath() const;
   Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
+  /**
+   * @brief Setter property for UseFaceMisorientations
+   */
+  void setUseFaceMisorientations(bool value);
+  /**
+   * @brief Getter property for UseFaceMisorientations
+   * @return Value of UseFaceMisorientations
+   */
+  bool getUseFaceMisorientations() const;
+  Q_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+
+  /**
+   * @brief Setter property for FaceMisorientationsArrayPath
+   */
+  void setFaceMisorientationsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FaceMisorientationsArrayPath
+   * @return Value of FaceMisorientationsArrayPath
+   */
+  DataArrayPath getFaceMisorientationsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
+
   /**
    * @brief Setter property for IgnoredDataArrayPaths
    */
@@ -261,6 +285,8 @@ private:
   float* m_ConfidenceIndex = nullptr;
   std::weak_ptr<DataArray<float>> m_QuatsPtr;
   float* m_Quats = nullptr;
+  std::weak_ptr<DataArray<float>> m_FaceMisorientationsPtr;
+  float* m_FaceMisorientations = nullptr;
   std::weak_ptr<DataArray<int32_t>> m_CellPhasesPtr;
   int32_t* m_CellPhases = nullptr;
   std::weak_ptr<DataArray<uint32_t>> m_CrystalStructuresPtr;
@@ -273,6 +299,8 @@ private:
   DataArrayPath m_CellPhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases};
   DataArrayPath m_CrystalStructuresArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures};
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
+  bool m_UseFaceMisorientations = {false};
+  DataArrayPath m_FaceMisorientationsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "FaceMisorientations"};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
   size_t m_Progress = 0;
@@ -32,6 +32,7 @@ set(_PublicFilters
   FindAvgOrientations
   FindBoundaryStrengths
   FindCAxisLocations
+  FindCellFaceMisorientations
   FindDistsToCharactGBs
   FindFeatureNeighborCAxisMisalignments
   FindFeatureReferenceCAxisMisorientations
@@ -0,0 +1,164 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The CellFaceMisorientations namespace holds the layout of the cell face misorientation
+ * array created by FindCellFaceMisorientations and consumed by the EBSD cleanup filters.
+ *
+ * The array has 3 components per cell. Component 0, 1 and 2 hold the misorientation angle (radians)
+ * between the cell and its +X, +Y and +Z neighbor. Faces on the +X/+Y/+Z boundary of the geometry or
+ * between cells of a different phase (or with an unknown crystal structure) hold k_NoMisorientation.
+ */
+namespace CellFaceMisorientations
+{
+constexpr float k_NoMisorientation = -1.0f;
+
+/**
+ * @brief Returns the index into the face misorientation array for the face between a cell and its
+ * neighbor, using the usual "neighpoints" direction order (-Z, -Y, -X, +X, +Y, +Z)
+ * @param cell
+ * @param direction
+ * @param neighpoints
+ * @return
+ */
+inline int64_t FaceIndex(int64_t cell, int32_t direction, const int64_t* neighpoints)
+{
+  static const int64_t k_Axis[6] = {2, 1, 0, 0, 1, 2};
+  int64_t owner = direction < 3 ? cell + neighpoints[direction] : cell;
+  return owner * 3 + k_Axis[direction];
+}
+
+/**
+ * @brief The ComputeImpl class computes the face misorientations of a range of cells. When a
+ * changed mask is given only the faces touching a changed cell are recomputed, which is how filters
+ * that copy orientations between cells keep the array up to date.
+ */
+class ComputeImpl
+{
+public:
+  ComputeImpl(const float* quats, const int32_t* phases, const uint32_t* crystalStructures, const int64_t* dims, float* faces, const uint8_t* changed = nullptr)
+  : m_Quats(quats)
+  , m_Phases(phases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Faces(faces)
+  , m_Changed(changed)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_OrientationOps = LaueOps::GetAllOrientationOps();
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t strides[3] = {1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    for(size_t c = range.min(); c < range.max(); c++)
+    {
+      const int64_t cell = static_cast<int64_t>(c);
+      const int64_t pos[3] = {cell % m_Dims[0], (cell / m_Dims[0]) % m_Dims[1], cell / strides[2]};
+      for(int32_t axis = 0; axis < 3; axis++)
+      {
+        if(pos[axis] == m_Dims[axis] - 1)
+        {
+          m_Faces[cell * 3 + axis] = k_NoMisorientation;
+          continue;
+        }
+        const int64_t neighbor = cell + strides[axis];
+        if(nullptr != m_Changed && m_Changed[cell] == 0 && m_Changed[neighbor] == 0)
+        {
+          continue;
+        }
+        m_Faces[cell * 3 + axis] = misorientation(cell, neighbor);
+      }
+    }
+  }
+
+private:
+  const float* m_Quats;
+  const int32_t* m_Phases;
+  const uint32_t* m_CrystalStructures;
+  int64_t m_Dims[3] = {0, 0, 0};
+  float* m_Faces;
+  const uint8_t* m_Changed;
+  std::vector<LaueOps::Pointer> m_OrientationOps;
+
+  float misorientation(int64_t cell, int64_t neighbor) const
+  {
+    if(m_Phases[cell] != m_Phases[neighbor])
+    {
+      return k_NoMisorientation;
+    }
+    uint32_t laueClass = m_CrystalStructures[m_Phases[cell]];
+    if(laueClass >= m_OrientationOps.size())
+    {
+      return k_NoMisorientation;
+    }
+    const float* quatPtr = m_Quats + cell * 4;
+    QuatF q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+    quatPtr = m_Quats + neighbor * 4;
+    QuatF q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+    OrientationF axisAngle = m_OrientationOps[laueClass]->calculateMisorientation(q1, q2);
+    return axisAngle[3];
+  }
+};
+
+/**
+ * @brief Computes (or, with a changed mask, updates) the face misorientations of an image geometry
+ * @param quats
+ * @param phases
+ * @param crystalStructures
+ * @param dims
+ * @param faces 3 * number of cells values
+ * @param changed Optional, one value per cell; non zero marks a cell whose orientation or phase changed
+ */
+inline void Compute(const float* quats, const int32_t* phases, const uint32_t* crystalStructures, const int64_t* dims, float* faces, const uint8_t* changed = nullptr)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, static_cast<size_t>(dims[0] * dims[1] * dims[2]));
+  dataAlg.execute(ComputeImpl(quats, phases, crystalStructures, dims, faces, changed));
+}
+} // namespace CellFaceMisorientations
@@ -0,0 +1,209 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
+/**
+ * @brief The FaceFeaturePairs class collects the unique (ordered) pairs of feature ids found in a
+ * surface mesh Face Labels array. A surface mesh typically has thousands of faces for each pair of
+ * neighboring features, so any value that only depends on the two features (misorientation, colors)
+ * can be computed once per pair and then scattered back onto the faces.
+ */
+class FaceFeaturePairs
+{
+public:
+  /**
+   * @brief FaceFeaturePairs
+   * @param faceLabels The 2 component Face Labels array
+   * @param numFaces
+   */
+  FaceFeaturePairs(const int32_t* faceLabels, size_t numFaces)
+  : m_FacePairIndices(numFaces, 0)
+  {
+    m_Pairs.resize(numFaces);
+    for(size_t i = 0; i < numFaces; i++)
+    {
+      m_Pairs[i] = MakeKey(faceLabels[2 * i], faceLabels[2 * i + 1]);
+    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_sort(m_Pairs.begin(), m_Pairs.end());
+#else
+    std::sort(m_Pairs.begin(), m_Pairs.end());
+#endif
+    m_Pairs.erase(std::unique(m_Pairs.begin(), m_Pairs.end()), m_Pairs.end());
+    m_Pairs.shrink_to_fit();
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numFaces);
+    dataAlg.execute(FindPairIndicesImpl(faceLabels, m_Pairs, m_FacePairIndices));
+  }
+
+  ~FaceFeaturePairs() = default;
+
+  FaceFeaturePairs(const FaceFeaturePairs&) = delete;            // Copy Constructor Not Implemented
+  FaceFeaturePairs(FaceFeaturePairs&&) = delete;                 // Move Constructor Not Implemented
+  FaceFeaturePairs& operator=(const FaceFeaturePairs&) = delete; // Copy Assignment Not Implemented
+  FaceFeaturePairs& operator=(FaceFeaturePairs&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Returns the number of unique feature pairs
+   */
+  size_t getNumberOfPairs() const
+  {
+    return m_Pairs.size();
+  }
+
+  /**
+   * @brief Returns the first feature id (Face Labels component 0) of a pair
+   */
+  int32_t getFeature1(size_t pairIndex) const
+  {
+    return static_cast<int32_t>(static_cast<uint32_t>(m_Pairs[pairIndex] >> 32));
+  }
+
+  /**
+   * @brief Returns the second feature id (Face Labels component 1) of a pair
+   */
+  int32_t getFeature2(size_t pairIndex) const
+  {
+    return static_cast<int32_t>(static_cast<uint32_t>(m_Pairs[pairIndex] & 0xFFFFFFFFULL));
+  }
+
+  /**
+   * @brief Returns the pair index of each face
+   */
+  const std::vector<size_t>& getFacePairIndices() const
+  {
+    return m_FacePairIndices;
+  }
+
+  /**
+   * @brief Copies the per pair values onto every face. Pairs whose mask value is 0 are skipped so
+   * the matching face values are left untouched.
+   * @param pairValues numComps values for each pair
+   * @param pairMask Optional, one value for each pair
+   * @param faceValues numComps values for each face
+   * @param numComps
+   */
+  template <typename T>
+  void scatter(const T* pairValues, const uint8_t* pairMask, T* faceValues, size_t numComps) const
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, m_FacePairIndices.size());
+    dataAlg.execute(ScatterImpl<T>(m_FacePairIndices, pairValues, pairMask, faceValues, numComps));
+  }
+
+  static uint64_t MakeKey(int32_t feature1, int32_t feature2)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(feature1)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(feature2));
+  }
+
+private:
+  std::vector<uint64_t> m_Pairs;
+  std::vector<size_t> m_FacePairIndices;
+
+  class FindPairIndicesImpl
+  {
+  public:
+    FindPairIndicesImpl(const int32_t* faceLabels, const std::vector<uint64_t>& pairs, std::vector<size_t>& facePairIndices)
+    : m_FaceLabels(faceLabels)
+    , m_Pairs(pairs)
+    , m_FacePairIndices(facePairIndices)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        uint64_t key = MakeKey(m_FaceLabels[2 * i], m_FaceLabels[2 * i + 1]);
+        m_FacePairIndices[i] = static_cast<size_t>(std::lower_bound(m_Pairs.begin(), m_Pairs.end(), key) - m_Pairs.begin());
+      }
+    }
+
+  private:
+    const int32_t* m_FaceLabels;
+    const std::vector<uint64_t>& m_Pairs;
+    std::vector<size_t>& m_FacePairIndices;
+  };
+
+  template <typename T>
+  class ScatterImpl
+  {
+  public:
+    ScatterImpl(const std::vector<size_t>& facePairIndices, const T* pairValues, const uint8_t* pairMask, T* faceValues, size_t numComps)
+    : m_FacePairIndices(facePairIndices)
+    , m_PairValues(pairValues)
+    , m_PairMask(pairMask)
+    , m_FaceValues(faceValues)
+    , m_NumComps(numComps)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        size_t pairIndex = m_FacePairIndices[i];
+        if(nullptr != m_PairMask && m_PairMask[pairIndex] == 0)
+        {
+          continue;
+        }
+        for(size_t c = 0; c < m_NumComps; c++)
+        {
+          m_FaceValues[i * m_NumComps + c] = m_PairValues[pairIndex * m_NumComps + c];
+        }
+      }
+    }
+
+  private:
+    const std::vector<size_t>& m_FacePairIndices;
+    const T* m_PairValues;
+    const uint8_t* m_PairMask;
+    T* m_FaceValues;
+    size_t m_NumComps;
+  };
+};
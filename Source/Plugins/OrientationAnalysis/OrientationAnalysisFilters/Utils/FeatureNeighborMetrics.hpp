@@ -0,0 +1,237 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The FeatureNeighborMetrics class evaluates per neighbor pair metrics (misorientation, slip transmission,
+ * c-axis misalignment, ...) over a Feature NeighborList. The neighbor lists are flattened into offset/neighbor
+ * arrays once, together with the position of the reverse entry of every pair, so a metric that does not depend on
+ * the order of the two Features is evaluated once per unordered pair and mirrored into both lists. Any number of
+ * metrics are computed in a single parallel sweep and written straight into the output NeighborLists, which are
+ * sized up front to match the neighbor lists. Feature 0 is skipped, matching the filters that use this class.
+ */
+class FeatureNeighborMetrics
+{
+public:
+  static constexpr size_t k_NoMirror = std::numeric_limits<size_t>::max();
+
+  FeatureNeighborMetrics(NeighborList<int32_t>& neighborList, size_t totalFeatures)
+  : m_Offsets(totalFeatures + 1, 0)
+  {
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      m_Offsets[i + 1] = m_Offsets[i] + neighborList[i].size();
+    }
+    m_Neighbors.resize(m_Offsets[totalFeatures]);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      NeighborList<int32_t>::VectorType& featureNeighborList = neighborList[i];
+      std::copy(featureNeighborList.begin(), featureNeighborList.end(), m_Neighbors.begin() + m_Offsets[i]);
+    }
+
+    m_Mirrors.assign(m_Neighbors.size(), k_NoMirror);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1ULL, totalFeatures);
+    dataAlg.execute(FindMirrorsImpl(m_Offsets, m_Neighbors, m_Mirrors));
+
+    // Only keep one to one mirrors; a Feature listed twice as a neighbor is evaluated from both sides instead
+    std::vector<size_t> mirrors = m_Mirrors;
+    for(size_t e = 0; e < m_Mirrors.size(); e++)
+    {
+      if(mirrors[e] != k_NoMirror && mirrors[mirrors[e]] != e)
+      {
+        m_Mirrors[e] = k_NoMirror;
+      }
+    }
+  }
+
+  ~FeatureNeighborMetrics() = default;
+
+  FeatureNeighborMetrics(const FeatureNeighborMetrics&) = delete;            // Copy Constructor Not Implemented
+  FeatureNeighborMetrics(FeatureNeighborMetrics&&) = delete;                 // Move Constructor Not Implemented
+  FeatureNeighborMetrics& operator=(const FeatureNeighborMetrics&) = delete; // Copy Assignment Not Implemented
+  FeatureNeighborMetrics& operator=(FeatureNeighborMetrics&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Sizes every list of an output NeighborList (except Feature 0) to the number of neighbors of the Feature
+   * @param output
+   * @param initValue
+   */
+  template <typename T>
+  void allocateLists(NeighborList<T>& output, T initValue) const
+  {
+    for(size_t i = 1; i + 1 < m_Offsets.size(); i++)
+    {
+      typename NeighborList<T>::SharedVectorType list(new std::vector<T>(m_Offsets[i + 1] - m_Offsets[i], initValue));
+      output.setList(static_cast<int32_t>(i), list);
+    }
+  }
+
+  /**
+   * @brief Evaluates NumMetrics metrics for every neighbor pair in parallel and stores them in the output lists, which
+   * must have been sized with allocateLists(). The functor is called as metric(feature, neighbor, values) with a
+   * std::array<float, NumMetrics>& to fill in.
+   * @param outputs One NeighborList per metric
+   * @param symmetric Whether every metric gives the same value with the two Features swapped, in which case each
+   * unordered pair is evaluated once (from its lower Feature Id) and mirrored into the neighbor's list
+   * @param metric
+   */
+  template <size_t NumMetrics, typename MetricFunctor>
+  void sweep(const std::array<NeighborList<float>*, NumMetrics>& outputs, bool symmetric, const MetricFunctor& metric) const
+  {
+    std::array<std::vector<float*>, NumMetrics> listPointers;
+    for(size_t m = 0; m < NumMetrics; m++)
+    {
+      listPointers[m].assign(m_Offsets.size() - 1, nullptr);
+      for(size_t i = 1; i + 1 < m_Offsets.size(); i++)
+      {
+        listPointers[m][i] = (*outputs[m])[i].data();
+      }
+    }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1ULL, m_Offsets.size() - 1);
+    dataAlg.execute(SweepImpl<NumMetrics, MetricFunctor>(m_Offsets, m_Neighbors, m_Mirrors, listPointers, symmetric, metric));
+  }
+
+private:
+  std::vector<size_t> m_Offsets;
+  std::vector<int32_t> m_Neighbors;
+  std::vector<size_t> m_Mirrors;
+
+  /**
+   * @brief Finds, for each entry (i, n), the entry of i in the neighbor list of n
+   */
+  class FindMirrorsImpl
+  {
+  public:
+    FindMirrorsImpl(const std::vector<size_t>& offsets, const std::vector<int32_t>& neighbors, std::vector<size_t>& mirrors)
+    : m_Offsets(offsets)
+    , m_Neighbors(neighbors)
+    , m_Mirrors(mirrors)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      size_t numFeatures = m_Offsets.size() - 1;
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        for(size_t e = m_Offsets[i]; e < m_Offsets[i + 1]; e++)
+        {
+          int32_t neighbor = m_Neighbors[e];
+          if(neighbor < 1 || static_cast<size_t>(neighbor) >= numFeatures)
+          {
+            continue;
+          }
+          for(size_t r = m_Offsets[neighbor]; r < m_Offsets[neighbor + 1]; r++)
+          {
+            if(static_cast<size_t>(m_Neighbors[r]) == i)
+            {
+              m_Mirrors[e] = r;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+  private:
+    const std::vector<size_t>& m_Offsets;
+    const std::vector<int32_t>& m_Neighbors;
+    std::vector<size_t>& m_Mirrors;
+  };
+
+  template <size_t NumMetrics, typename MetricFunctor>
+  class SweepImpl
+  {
+  public:
+    SweepImpl(const std::vector<size_t>& offsets, const std::vector<int32_t>& neighbors, const std::vector<size_t>& mirrors, const std::array<std::vector<float*>, NumMetrics>& listPointers,
+              bool symmetric, const MetricFunctor& metric)
+    : m_Offsets(offsets)
+    , m_Neighbors(neighbors)
+    , m_Mirrors(mirrors)
+    , m_ListPointers(listPointers)
+    , m_Symmetric(symmetric)
+    , m_Metric(metric)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      std::array<float, NumMetrics> values;
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        for(size_t e = m_Offsets[i]; e < m_Offsets[i + 1]; e++)
+        {
+          size_t neighbor = static_cast<size_t>(m_Neighbors[e]);
+          size_t mirror = m_Symmetric ? m_Mirrors[e] : k_NoMirror;
+          // The lower Feature of a mirrored pair evaluates it for both
+          if(mirror != k_NoMirror && neighbor < i)
+          {
+            continue;
+          }
+          m_Metric(i, neighbor, values);
+          for(size_t m = 0; m < NumMetrics; m++)
+          {
+            m_ListPointers[m][i][e - m_Offsets[i]] = values[m];
+            if(mirror != k_NoMirror)
+            {
+              m_ListPointers[m][neighbor][mirror - m_Offsets[neighbor]] = values[m];
+            }
+          }
+        }
+      }
+    }
+
+  private:
+    const std::vector<size_t>& m_Offsets;
+    const std::vector<int32_t>& m_Neighbors;
+    const std::vector<size_t>& m_Mirrors;
+    const std::array<std::vector<float*>, NumMetrics>& m_ListPointers;
+    bool m_Symmetric;
+    const MetricFunctor& m_Metric;
+  };
+};
@@ -0,0 +1,354 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+
+/**
+ * @brief The OrientationBatchConverter namespace converts whole arrays of orientations from one
+ * representation to another. Each tuple is read straight from the input pointer and written
+ * straight into the output pointer, so no intermediate array is allocated, and the tuple range is
+ * split across threads. The per tuple math is the EbsdLib OrientationTransformation code so the
+ * results are identical to the OrientationConverter classes.
+ *
+ * The representation indices match the "Input Orientation Type" choices of ConvertOrientations.
+ */
+namespace OrientationBatchConverter
+{
+enum class Representation : int32_t
+{
+  Euler = 0,
+  OrientationMatrix = 1,
+  Quaternion = 2,
+  AxisAngle = 3,
+  Rodrigues = 4
+};
+
+/**
+ * @brief Per tuple conversion kernels. Input tuples are copied into a small stack buffer before
+ * being wrapped by an Orientation so that the input array is never written through.
+ */
+template <typename T>
+struct Kernels
+{
+  using OrientationType = Orientation<T>;
+  using QuaternionType = Quaternion<T>;
+
+  template <size_t N>
+  static OrientationType wrap(const T* in, std::array<T, N>& buffer)
+  {
+    for(size_t c = 0; c < N; c++)
+    {
+      buffer[c] = in[c];
+    }
+    return OrientationType(buffer.data(), N);
+  }
+
+  static QuaternionType quat(const T* in)
+  {
+    return QuaternionType(in[0], in[1], in[2], in[3]);
+  }
+
+  static void eu2qu(const T* in, T* out)
+  {
+    std::array<T, 3> buffer = {0, 0, 0};
+    QuaternionType qu = OrientationTransformation::eu2qu<OrientationType, QuaternionType>(wrap(in, buffer));
+    qu.copyInto(out, QuaternionType::Order::VectorScalar);
+  }
+  static void eu2om(const T* in, T* out)
+  {
+    std::array<T, 3> buffer = {0, 0, 0};
+    OrientationTransformation::eu2om<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 9);
+  }
+  static void eu2ro(const T* in, T* out)
+  {
+    std::array<T, 3> buffer = {0, 0, 0};
+    OrientationTransformation::eu2ro<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 4);
+  }
+  static void om2eu(const T* in, T* out)
+  {
+    std::array<T, 9> buffer = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    OrientationTransformation::om2eu<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 3);
+  }
+  static void om2ax(const T* in, T* out)
+  {
+    std::array<T, 9> buffer = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    OrientationTransformation::om2ax<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 4);
+  }
+  static void qu2eu(const T* in, T* out)
+  {
+    OrientationTransformation::qu2eu<QuaternionType, OrientationType>(quat(in)).copyInto(out, 3);
+  }
+  static void qu2om(const T* in, T* out)
+  {
+    OrientationTransformation::qu2om<QuaternionType, OrientationType>(quat(in)).copyInto(out, 9);
+  }
+  static void qu2ax(const T* in, T* out)
+  {
+    OrientationTransformation::qu2ax<QuaternionType, OrientationType>(quat(in)).copyInto(out, 4);
+  }
+  static void ax2om(const T* in, T* out)
+  {
+    std::array<T, 4> buffer = {0, 0, 0, 0};
+    OrientationTransformation::ax2om<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 9);
+  }
+  static void ax2ro(const T* in, T* out)
+  {
+    std::array<T, 4> buffer = {0, 0, 0, 0};
+    OrientationTransformation::ax2ro<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 4);
+  }
+  static void ro2eu(const T* in, T* out)
+  {
+    std::array<T, 4> buffer = {0, 0, 0, 0};
+    OrientationTransformation::ro2eu<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 3);
+  }
+  static void ro2ax(const T* in, T* out)
+  {
+    std::array<T, 4> buffer = {0, 0, 0, 0};
+    OrientationTransformation::ro2ax<OrientationType, OrientationType>(wrap(in, buffer)).copyInto(out, 4);
+  }
+};
+
+/**
+ * @brief The ConvertImpl class applies a single kernel to a range of tuples
+ */
+template <typename T>
+class ConvertImpl
+{
+public:
+  using KernelType = void (*)(const T*, T*);
+
+  ConvertImpl(const T* input, size_t inputComps, T* output, size_t outputComps, KernelType kernel)
+  : m_Input(input)
+  , m_InputComps(inputComps)
+  , m_Output(output)
+  , m_OutputComps(outputComps)
+  , m_Kernel(kernel)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const T* in = m_Input + range.min() * m_InputComps;
+    T* out = m_Output + range.min() * m_OutputComps;
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_Kernel(in, out);
+      in += m_InputComps;
+      out += m_OutputComps;
+    }
+  }
+
+private:
+  const T* m_Input;
+  size_t m_InputComps;
+  T* m_Output;
+  size_t m_OutputComps;
+  KernelType m_Kernel;
+};
+
+/**
+ * @brief The SanitizeEulersImpl class folds Euler angles into the valid range in place, the same
+ * way the EulerConverter does before converting.
+ */
+template <typename T>
+class SanitizeEulersImpl
+{
+public:
+  SanitizeEulersImpl(T* eulers, size_t numComps)
+  : m_Eulers(eulers)
+  , m_NumComps(numComps)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      T* eu = m_Eulers + i * m_NumComps;
+      eu[0] = static_cast<T>(std::fmod(eu[0], SIMPLib::Constants::k_2PiD));
+      eu[1] = static_cast<T>(std::fmod(eu[1], SIMPLib::Constants::k_PiD));
+      eu[2] = static_cast<T>(std::fmod(eu[2], SIMPLib::Constants::k_2PiD));
+      for(size_t c = 0; c < 3; c++)
+      {
+        if(eu[c] < static_cast<T>(0.0))
+        {
+          eu[c] *= static_cast<T>(-1.0);
+        }
+      }
+    }
+  }
+
+private:
+  T* m_Eulers;
+  size_t m_NumComps;
+};
+
+/**
+ * @brief Returns the kernel for the given pair of representations or nullptr if the pair is not
+ * covered by the batch path.
+ * @param inputType
+ * @param outputType
+ * @return
+ */
+template <typename T>
+typename ConvertImpl<T>::KernelType GetKernel(int32_t inputType, int32_t outputType)
+{
+  using K = Kernels<T>;
+  const auto in = static_cast<Representation>(inputType);
+  const auto out = static_cast<Representation>(outputType);
+  switch(in)
+  {
+  case Representation::Euler:
+    switch(out)
+    {
+    case Representation::OrientationMatrix:
+      return &K::eu2om;
+    case Representation::Quaternion:
+      return &K::eu2qu;
+    case Representation::Rodrigues:
+      return &K::eu2ro;
+    default:
+      break;
+    }
+    break;
+  case Representation::OrientationMatrix:
+    switch(out)
+    {
+    case Representation::Euler:
+      return &K::om2eu;
+    case Representation::AxisAngle:
+      return &K::om2ax;
+    default:
+      break;
+    }
+    break;
+  case Representation::Quaternion:
+    switch(out)
+    {
+    case Representation::Euler:
+      return &K::qu2eu;
+    case Representation::OrientationMatrix:
+      return &K::qu2om;
+    case Representation::AxisAngle:
+      return &K::qu2ax;
+    default:
+      break;
+    }
+    break;
+  case Representation::AxisAngle:
+    switch(out)
+    {
+    case Representation::OrientationMatrix:
+      return &K::ax2om;
+    case Representation::Rodrigues:
+      return &K::ax2ro;
+    default:
+      break;
+    }
+    break;
+  case Representation::Rodrigues:
+    switch(out)
+    {
+    case Representation::Euler:
+      return &K::ro2eu;
+    case Representation::AxisAngle:
+      return &K::ro2ax;
+    default:
+      break;
+    }
+    break;
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Returns true if the pair of representations can be converted by Convert()
+ * @param inputType
+ * @param outputType
+ * @return
+ */
+inline bool IsSupported(int32_t inputType, int32_t outputType)
+{
+  return GetKernel<float>(inputType, outputType) != nullptr;
+}
+
+/**
+ * @brief Converts numTuples orientations from the input representation into the output
+ * representation, writing directly into the output pointer.
+ * @param input Input orientations, packed with the component count of the input representation
+ * @param inputComps
+ * @param output Output orientations, packed with the component count of the output representation
+ * @param outputComps
+ * @param numTuples
+ * @param inputType
+ * @param outputType
+ * @return false if the pair of representations is not supported, in which case nothing was written
+ *
+ * Euler input angles are folded into the valid range in place before converting, matching the
+ * behavior of the EulerConverter.
+ */
+template <typename T>
+bool Convert(T* input, size_t inputComps, T* output, size_t outputComps, size_t numTuples, int32_t inputType, int32_t outputType)
+{
+  typename ConvertImpl<T>::KernelType kernel = GetKernel<T>(inputType, outputType);
+  if(nullptr == kernel)
+  {
+    return false;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  if(static_cast<Representation>(inputType) == Representation::Euler)
+  {
+    dataAlg.setRange(0ULL, numTuples);
+    dataAlg.execute(SanitizeEulersImpl<T>(input, inputComps));
+  }
+  dataAlg.setRange(0ULL, numTuples);
+  dataAlg.execute(ConvertImpl<T>(input, inputComps, output, outputComps, kernel));
+  return true;
+}
+} // namespace OrientationBatchConverter
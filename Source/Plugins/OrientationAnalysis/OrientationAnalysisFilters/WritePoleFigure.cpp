@@ -35,6 +35,7 @@
 
 #include "WritePoleFigure.h"
 
+#include <algorithm>
 #include <csetjmp>
 #include <vector>
 
@@ -56,6 +57,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
@@ -84,6 +86,98 @@ void error_handler(HPDF_STATUS error_no, HPDF_STATUS detail_no, void* /* user_da
   longjmp(env, 1);
 }
 
+namespace
+{
+constexpr size_t k_PhaseBlockSize = 65536;
+
+/**
+ * @brief The CountPhasePointsImpl class counts, for each block of Elements, how many Elements of each
+ * phase take part in the pole figures. The counts give every block its write offset in the per phase array.
+ */
+class CountPhasePointsImpl
+{
+public:
+  CountPhasePointsImpl(const int32_t* cellPhases, const bool* goodVoxels, size_t numPoints, size_t numPhases, std::vector<size_t>& blockCounts)
+  : m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_NumPoints(numPoints)
+  , m_NumPhases(numPhases)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      size_t* counts = m_BlockCounts.data() + block * m_NumPhases;
+      size_t end = std::min(m_NumPoints, (block + 1) * k_PhaseBlockSize);
+      for(size_t i = block * k_PhaseBlockSize; i < end; i++)
+      {
+        if(m_CellPhases[i] > 0 && static_cast<size_t>(m_CellPhases[i]) < m_NumPhases && (nullptr == m_GoodVoxels || m_GoodVoxels[i]))
+        {
+          counts[m_CellPhases[i]]++;
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_CellPhases;
+  const bool* m_GoodVoxels;
+  size_t m_NumPoints;
+  size_t m_NumPhases;
+  std::vector<size_t>& m_BlockCounts;
+};
+
+/**
+ * @brief The GatherPhaseEulersImpl class copies the Euler angles of one phase into a compact array, each
+ * block of Elements writing at its own offset so the Elements keep their original order.
+ */
+class GatherPhaseEulersImpl
+{
+public:
+  GatherPhaseEulersImpl(const float* cellEulerAngles, const int32_t* cellPhases, const bool* goodVoxels, size_t numPoints, int32_t phase, const std::vector<size_t>& blockOffsets, float* phaseEulers)
+  : m_CellEulerAngles(cellEulerAngles)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_NumPoints(numPoints)
+  , m_Phase(phase)
+  , m_BlockOffsets(blockOffsets)
+  , m_PhaseEulers(phaseEulers)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      float* dest = m_PhaseEulers + m_BlockOffsets[block] * 3;
+      size_t end = std::min(m_NumPoints, (block + 1) * k_PhaseBlockSize);
+      for(size_t i = block * k_PhaseBlockSize; i < end; i++)
+      {
+        if(m_CellPhases[i] == m_Phase && (nullptr == m_GoodVoxels || m_GoodVoxels[i]))
+        {
+          dest[0] = m_CellEulerAngles[i * 3];
+          dest[1] = m_CellEulerAngles[i * 3 + 1];
+          dest[2] = m_CellEulerAngles[i * 3 + 2];
+          dest += 3;
+        }
+      }
+    }
+  }
+
+private:
+  const float* m_CellEulerAngles;
+  const int32_t* m_CellPhases;
+  const bool* m_GoodVoxels;
+  size_t m_NumPoints;
+  int32_t m_Phase;
+  const std::vector<size_t>& m_BlockOffsets;
+  float* m_PhaseEulers;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -628,46 +722,39 @@ void WritePoleFigure::execute()
   // Find how many phases we have by getting the number of Crystal Structures
   size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
+  // Count the Elements of every phase in a single pass over blocks of Elements. Each block then knows
+  // where its Elements go in the per phase array, so each phase is gathered without a second counting pass.
+  const bool* goodVoxels = m_UseGoodVoxels ? m_GoodVoxels : nullptr;
+  size_t numBlocks = (numPoints + k_PhaseBlockSize - 1) / k_PhaseBlockSize;
+  std::vector<size_t> blockCounts(numBlocks * numPhases, 0);
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numBlocks);
+    dataAlg.execute(CountPhasePointsImpl(m_CellPhases, goodVoxels, numPoints, numPhases, blockCounts));
+  }
+
   // Loop over all the voxels gathering the Eulers for a specific phase into an array
+  std::vector<size_t> blockOffsets(numBlocks, 0);
   for(size_t phase = 1; phase < numPhases; ++phase)
   {
     size_t count = 0;
-    // First find out how many voxels we are going to have. This is probably faster to loop twice than to
-    // keep allocating memory everytime we find one.
-    for(size_t i = 0; i < numPoints; ++i)
+    for(size_t block = 0; block < numBlocks; block++)
     {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          count++;
-        }
-      }
+      blockOffsets[block] = count;
+      count += blockCounts[block * numPhases + phase];
     }
+    if(count == 0)
+    {
+      continue;
+    } // Skip because we have no Pole Figure data
+
     std::vector<size_t> eulerCompDim(1, 3);
     EbsdLib::FloatArrayType::Pointer subEulers = EbsdLib::FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase", true);
-    subEulers->initializeWithValue(std::numeric_limits<float>::signaling_NaN());
-    float* eu = subEulers->getPointer(0);
-
-    // Now loop through the eulers again and this time add them to the subEulers Array
-    count = 0;
-    for(size_t i = 0; i < numPoints; ++i)
     {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          eu[count * 3] = m_CellEulerAngles[i * 3];
-          eu[count * 3 + 1] = m_CellEulerAngles[i * 3 + 1];
-          eu[count * 3 + 2] = m_CellEulerAngles[i * 3 + 2];
-          count++;
-        }
-      }
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0ULL, numBlocks);
+      dataAlg.execute(GatherPhaseEulersImpl(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, static_cast<int32_t>(phase), blockOffsets, subEulers->getPointer(0)));
     }
-    if(subEulers->getNumberOfTuples() == 0)
-    {
-      continue;
-    } // Skip because we have no Pole Figure data
 
     std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
 
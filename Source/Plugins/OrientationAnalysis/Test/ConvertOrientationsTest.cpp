@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/ConvertOrientations.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class ConvertOrientationsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_InputName = {"Input"};
+  const QString k_OutputName = {"Output"};
+
+  static constexpr size_t k_NumTuples = 2000;
+
+public:
+  ConvertOrientationsTest() = default;
+  ~ConvertOrientationsTest() = default;
+
+  ConvertOrientationsTest(const ConvertOrientationsTest&) = delete;            // Copy Constructor
+  ConvertOrientationsTest(ConvertOrientationsTest&&) = delete;                 // Move Constructor
+  ConvertOrientationsTest& operator=(const ConvertOrientationsTest&) = delete; // Copy Assignment
+  ConvertOrientationsTest& operator=(ConvertOrientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // Returns the legacy converter for the given "Input Orientation Type"
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename OrientationConverter<DataArray<T>, T>::Pointer createConverter(int32_t inputType)
+  {
+    using ArrayType = DataArray<T>;
+    std::vector<typename OrientationConverter<ArrayType, T>::Pointer> converters = {EulerConverter<ArrayType, T>::New(), OrientationMatrixConverter<ArrayType, T>::New(),
+                                                                                    QuaternionConverter<ArrayType, T>::New(), AxisAngleConverter<ArrayType, T>::New(),
+                                                                                    RodriguesConverter<ArrayType, T>::New()};
+    return converters[inputType];
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random orientations of the given representation. Euler input has every other tuple pushed out of the valid
+  // range, including negative angles, so the in place folding is exercised.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename DataArray<T>::Pointer createInput(int32_t inputType)
+  {
+    using ArrayType = DataArray<T>;
+    std::mt19937_64 generator(static_cast<std::mt19937_64::result_type>(1234 + inputType));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    typename ArrayType::Pointer eulers = ArrayType::CreateArray(k_NumTuples, std::vector<size_t>(1, 3), k_InputName, true);
+    for(size_t i = 0; i < k_NumTuples; i++)
+    {
+      eulers->setComponent(i, 0, static_cast<T>(SIMPLib::Constants::k_2PiD * unit(generator)));
+      eulers->setComponent(i, 1, static_cast<T>(SIMPLib::Constants::k_PiD * unit(generator)));
+      eulers->setComponent(i, 2, static_cast<T>(SIMPLib::Constants::k_2PiD * unit(generator)));
+    }
+    if(inputType == 0)
+    {
+      for(size_t i = 1; i < k_NumTuples; i += 2)
+      {
+        eulers->setComponent(i, 0, static_cast<T>(SIMPLib::Constants::k_2PiD * (4.0 * unit(generator) - 2.0)));
+        eulers->setComponent(i, 1, static_cast<T>(SIMPLib::Constants::k_PiD * (6.0 * unit(generator) - 3.0)));
+        eulers->setComponent(i, 2, static_cast<T>(SIMPLib::Constants::k_2PiD * (4.0 * unit(generator) - 2.0)));
+      }
+      return eulers;
+    }
+
+    typename OrientationConverter<ArrayType, T>::Pointer converter = createConverter<T>(0);
+    converter->setInputData(eulers);
+    converter->convertRepresentationTo(OrientationConverter<ArrayType, T>::GetOrientationTypes()[inputType]);
+    typename ArrayType::Pointer input = converter->getOutputData();
+    input->setName(k_InputName);
+    return input;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs ConvertOrientations, which takes the batch path for the pairs tested here, on the input array
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename DataArray<T>::Pointer runFilter(const typename DataArray<T>::Pointer& input, int32_t inputType, int32_t outputType)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New({k_NumTuples}, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    cellAM->insertOrAssign(input);
+
+    ConvertOrientations::Pointer filter = ConvertOrientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setInputType(inputType);
+    filter->setOutputType(outputType);
+    filter->setInputOrientationArrayPath({k_DataContainerName, k_CellDataName, k_InputName});
+    filter->setOutputOrientationArrayName(k_OutputName);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    typename DataArray<T>::Pointer output = cellAM->getAttributeArrayAs<DataArray<T>>(k_OutputName);
+    DREAM3D_REQUIRE_VALID_POINTER(output.get());
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int compareArrays(const typename DataArray<T>::Pointer& expected, const typename DataArray<T>::Pointer& actual)
+  {
+    DREAM3D_REQUIRE_EQUAL(expected->getNumberOfTuples(), actual->getNumberOfTuples());
+    DREAM3D_REQUIRE_EQUAL(expected->getNumberOfComponents(), actual->getNumberOfComponents());
+    for(size_t i = 0; i < expected->getSize(); i++)
+    {
+      if(std::isnan(expected->getValue(i)) && std::isnan(actual->getValue(i)))
+      {
+        continue;
+      }
+      DREAM3D_REQUIRE_EQUAL(expected->getValue(i), actual->getValue(i));
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every pair routed through OrientationBatchConverter must give exactly the OrientationConverter result
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int TestBatchConversions()
+  {
+    using ArrayType = DataArray<T>;
+    const std::vector<std::pair<int32_t, int32_t>> k_Pairs = {{0, 1}, {0, 2}, {0, 4}, {1, 0}, {1, 3}, {2, 0}, {2, 1}, {2, 3}, {3, 1}, {3, 4}, {4, 0}, {4, 3}};
+
+    for(const auto& pair : k_Pairs)
+    {
+      typename ArrayType::Pointer input = createInput<T>(pair.first);
+      typename ArrayType::Pointer legacyInput = std::dynamic_pointer_cast<ArrayType>(input->deepCopy());
+      DREAM3D_REQUIRE_VALID_POINTER(legacyInput.get());
+
+      typename OrientationConverter<ArrayType, T>::Pointer converter = createConverter<T>(pair.first);
+      converter->setInputData(legacyInput);
+      converter->convertRepresentationTo(OrientationConverter<ArrayType, T>::GetOrientationTypes()[pair.second]);
+      typename ArrayType::Pointer expected = converter->getOutputData();
+      DREAM3D_REQUIRE_VALID_POINTER(expected.get());
+
+      typename ArrayType::Pointer actual = runFilter<T>(input, pair.first, pair.second);
+      int err = compareArrays<T>(expected, actual);
+      DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+
+      // The batch path folds the Euler input into the valid range in place
+      if(pair.first == 0)
+      {
+        for(size_t i = 0; i < k_NumTuples; i++)
+        {
+          DREAM3D_REQUIRE(input->getComponent(i, 0) >= static_cast<T>(0.0) && input->getComponent(i, 0) <= static_cast<T>(SIMPLib::Constants::k_2PiD));
+          DREAM3D_REQUIRE(input->getComponent(i, 1) >= static_cast<T>(0.0) && input->getComponent(i, 1) <= static_cast<T>(SIMPLib::Constants::k_PiD));
+          DREAM3D_REQUIRE(input->getComponent(i, 2) >= static_cast<T>(0.0) && input->getComponent(i, 2) <= static_cast<T>(SIMPLib::Constants::k_2PiD));
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestBatchConversions<float>())
+    DREAM3D_REGISTER_TEST(TestBatchConversions<double>())
+  }
+
+private:
+};
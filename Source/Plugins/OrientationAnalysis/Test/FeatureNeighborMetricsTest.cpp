@@ -0,0 +1,306 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <Eigen/Dense>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindFeatureNeighborCAxisMisalignments.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindMisorientations.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindSlipTransmissionMetrics.h"
+#include "OrientationAnalysis/OrientationAnalysisUtilities.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FeatureNeighborMetricsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_FeatureDataName = {"CellFeatureData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_AvgQuatsName = {"AvgQuats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_NeighborListName = {"NeighborList"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_MisorientationListName = {"MisorientationList"};
+  const QString k_AvgMisorientationsName = {"AvgMisorientations"};
+  const QString k_CAxisMisalignmentListName = {"CAxisMisalignmentList"};
+  const QString k_AvgCAxisMisalignmentsName = {"AvgCAxisMisalignments"};
+  const QString k_F1ListName = {"F1List"};
+  const QString k_F1sptListName = {"F1sptList"};
+  const QString k_F7ListName = {"F7List"};
+  const QString k_mPrimeListName = {"mPrimeList"};
+
+  static constexpr size_t k_NumFeatures = 6;
+  const std::vector<int32_t> k_FeaturePhases = {0, 1, 1, 1, 2, 1};
+
+public:
+  FeatureNeighborMetricsTest() = default;
+  ~FeatureNeighborMetricsTest() = default;
+
+  FeatureNeighborMetricsTest(const FeatureNeighborMetricsTest&) = delete;            // Copy Constructor
+  FeatureNeighborMetricsTest(FeatureNeighborMetricsTest&&) = delete;                 // Move Constructor
+  FeatureNeighborMetricsTest& operator=(const FeatureNeighborMetricsTest&) = delete; // Copy Assignment
+  FeatureNeighborMetricsTest& operator=(FeatureNeighborMetricsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // The neighbor lists are not a clean symmetric relation:
+  //   1: {2, 3, 4}    4 does not list 1
+  //   2: {1, 3}
+  //   3: {1, 2, 5, 2} 2 is listed twice but 2 lists 3 once
+  //   4: {}
+  //   5: {3, 1}       1 does not list 5
+  // Features 1, 2, 3 and 5 are phase 1 and Feature 4 is phase 2, with the given crystal structures.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure(uint32_t phase1Structure, uint32_t phase2Structure)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({k_NumFeatures}, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(k_NumFeatures, std::vector<size_t>(1, 4), k_AvgQuatsName, true);
+    avgQuats->initializeWithZeros();
+    avgQuats->setComponent(0, 3, 1.0F);
+    // Rotations by 0.3 * i radians about the normalized axis (i, 1, 2)
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      float angle = 0.3F * static_cast<float>(i);
+      float axis[3] = {static_cast<float>(i), 1.0F, 2.0F};
+      float norm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+      for(size_t c = 0; c < 3; c++)
+      {
+        avgQuats->setComponent(i, c, std::sin(0.5F * angle) * axis[c] / norm);
+      }
+      avgQuats->setComponent(i, 3, std::cos(0.5F * angle));
+    }
+    featureAM->insertOrAssign(avgQuats);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_NumFeatures, std::string(k_PhasesName.toStdString()), true);
+    for(size_t i = 0; i < k_NumFeatures; i++)
+    {
+      phases->setValue(i, k_FeaturePhases[i]);
+    }
+    featureAM->insertOrAssign(phases);
+
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(k_NumFeatures, k_NeighborListName, true);
+    neighborList->setList(1, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({2, 3, 4})));
+    neighborList->setList(2, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({1, 3})));
+    neighborList->setList(3, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({1, 2, 5, 2})));
+    neighborList->setList(4, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>()));
+    neighborList->setList(5, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({3, 1})));
+    featureAM->insertOrAssign(neighborList);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({3}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, phase1Structure);
+    crystalStructures->setValue(2, phase2Structure);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  QuatD getQuat(const DataContainerArray::Pointer& dca, size_t feature)
+  {
+    FloatArrayType::Pointer avgQuats = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""})->getAttributeArrayAs<FloatArrayType>(k_AvgQuatsName);
+    float* quat = avgQuats->getTuplePointer(feature);
+    return QuatD(quat[0], quat[1], quat[2], quat[3]);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every output list must have one value per neighbor entry and each value must match the expected value of the
+  // (feature, neighbor) pair. NaN only matches NaN.
+  // -----------------------------------------------------------------------------
+  template <typename ExpectedFunctor>
+  int checkLists(const DataContainerArray::Pointer& dca, const QString& listName, float tolerance, const ExpectedFunctor& expectedValue)
+  {
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    NeighborList<int32_t>::Pointer neighborList = featureAM->getAttributeArrayAs<NeighborList<int32_t>>(k_NeighborListName);
+    NeighborList<float>::Pointer outputList = featureAM->getAttributeArrayAs<NeighborList<float>>(listName);
+    DREAM3D_REQUIRE_VALID_POINTER(outputList.get());
+
+    size_t numValues = 0;
+    for(size_t i = 1; i < k_NumFeatures; i++)
+    {
+      std::vector<int32_t> neighbors = neighborList->getListReference(static_cast<int32_t>(i));
+      std::vector<float> values = outputList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(values.size(), neighbors.size());
+      for(size_t n = 0; n < neighbors.size(); n++)
+      {
+        float expected = expectedValue(i, static_cast<size_t>(neighbors[n]));
+        if(std::isnan(expected))
+        {
+          DREAM3D_REQUIRE(std::isnan(values[n]));
+          continue;
+        }
+        DREAM3D_REQUIRE(std::abs(values[n] - expected) <= tolerance);
+        numValues++;
+      }
+    }
+    DREAM3D_REQUIRED(numValues, >, 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMisorientations()
+  {
+    DataContainerArray::Pointer dca = createDataStructure(EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High);
+
+    FindMisorientations::Pointer filter = FindMisorientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setNeighborListArrayPath({k_DataContainerName, k_FeatureDataName, k_NeighborListName});
+    filter->setAvgQuatsArrayPath({k_DataContainerName, k_FeatureDataName, k_AvgQuatsName});
+    filter->setFeaturePhasesArrayPath({k_DataContainerName, k_FeatureDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setMisorientationListArrayName(k_MisorientationListName);
+    filter->setAvgMisorientationsArrayName(k_AvgMisorientationsName);
+    filter->setFindAvgMisors(false);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // A mirrored pair is computed from its lower Feature, which may differ from this side in the last bits
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    return checkLists(dca, k_MisorientationListName, 1.0E-3F, [&](size_t feature, size_t neighbor) {
+      if(k_FeaturePhases[feature] != k_FeaturePhases[neighbor])
+      {
+        return NAN;
+      }
+      OrientationD axisAngle = orientationOps[EbsdLib::CrystalStructure::Cubic_High]->calculateMisorientation(getQuat(dca, feature), getQuat(dca, neighbor));
+      return static_cast<float>(axisAngle[3] * SIMPLib::Constants::k_180OverPiD);
+    });
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCAxisMisalignments()
+  {
+    DataContainerArray::Pointer dca = createDataStructure(EbsdLib::CrystalStructure::Hexagonal_High, EbsdLib::CrystalStructure::Cubic_High);
+
+    FindFeatureNeighborCAxisMisalignments::Pointer filter = FindFeatureNeighborCAxisMisalignments::New();
+    filter->setDataContainerArray(dca);
+    filter->setNeighborListArrayPath({k_DataContainerName, k_FeatureDataName, k_NeighborListName});
+    filter->setAvgQuatsArrayPath({k_DataContainerName, k_FeatureDataName, k_AvgQuatsName});
+    filter->setFeaturePhasesArrayPath({k_DataContainerName, k_FeatureDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setCAxisMisalignmentListArrayName(k_CAxisMisalignmentListName);
+    filter->setAvgCAxisMisalignmentsArrayName(k_AvgCAxisMisalignmentsName);
+    filter->setFindAvgMisals(false);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    auto cAxis = [&](size_t feature) {
+      float* quat = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""})->getAttributeArrayAs<FloatArrayType>(k_AvgQuatsName)->getTuplePointer(feature);
+      Orientation<float> oMatrix = OrientationTransformation::qu2om<QuatF, Orientation<float>>({quat[0], quat[1], quat[2], quat[3]});
+      Eigen::Vector3f axis = OrientationUtilities::OrientationMatrixToGMatrixTranspose(oMatrix) * Eigen::Vector3f(0.0f, 0.0f, 1.0f);
+      axis.normalize();
+      return axis;
+    };
+
+    return checkLists(dca, k_CAxisMisalignmentListName, 1.0E-3F, [&](size_t feature, size_t neighbor) {
+      if(k_FeaturePhases[feature] != k_FeaturePhases[neighbor])
+      {
+        return NAN;
+      }
+      float w = GeometryMath::CosThetaBetweenVectors(cAxis(feature), cAxis(neighbor));
+      SIMPLibMath::bound(w, -1.0f, 1.0f);
+      w = acosf(w);
+      if(w > (SIMPLib::Constants::k_PiF / 2))
+      {
+        w = SIMPLib::Constants::k_PiF - w;
+      }
+      return w * SIMPLib::Constants::k_180OverPiF;
+    });
+  }
+
+  // -----------------------------------------------------------------------------
+  // The slip transmission metrics are not symmetric, so every entry is computed from its own side and must match
+  // exactly
+  // -----------------------------------------------------------------------------
+  int TestSlipTransmissionMetrics()
+  {
+    DataContainerArray::Pointer dca = createDataStructure(EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High);
+
+    FindSlipTransmissionMetrics::Pointer filter = FindSlipTransmissionMetrics::New();
+    filter->setDataContainerArray(dca);
+    filter->setNeighborListArrayPath({k_DataContainerName, k_FeatureDataName, k_NeighborListName});
+    filter->setAvgQuatsArrayPath({k_DataContainerName, k_FeatureDataName, k_AvgQuatsName});
+    filter->setFeaturePhasesArrayPath({k_DataContainerName, k_FeatureDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setF1ListArrayName(k_F1ListName);
+    filter->setF1sptListArrayName(k_F1sptListName);
+    filter->setF7ListArrayName(k_F7ListName);
+    filter->setmPrimeListArrayName(k_mPrimeListName);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    const LaueOps::Pointer& ops = orientationOps[EbsdLib::CrystalStructure::Cubic_High];
+    const QString listNames[4] = {k_mPrimeListName, k_F1ListName, k_F1sptListName, k_F7ListName};
+    for(size_t m = 0; m < 4; m++)
+    {
+      int err = checkLists(dca, listNames[m], 0.0F, [&](size_t feature, size_t neighbor) {
+        if(k_FeaturePhases[feature] != k_FeaturePhases[neighbor])
+        {
+          return 0.0F;
+        }
+        double LD[3] = {0.0f, 0.0f, 1.0f};
+        QuatD q1 = getQuat(dca, feature);
+        QuatD q2 = getQuat(dca, neighbor);
+        switch(m)
+        {
+        case 0:
+          return static_cast<float>(ops->getmPrime(q1, q2, LD));
+        case 1:
+          return static_cast<float>(ops->getF1(q1, q2, LD, true));
+        case 2:
+          return static_cast<float>(ops->getF1spt(q1, q2, LD, true));
+        default:
+          return static_cast<float>(ops->getF7(q1, q2, LD, true));
+        }
+      });
+      DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestMisorientations())
+    DREAM3D_REGISTER_TEST(TestCAxisMisalignments())
+    DREAM3D_REGISTER_TEST(TestSlipTransmissionMetrics())
+  }
+
+private:
+};
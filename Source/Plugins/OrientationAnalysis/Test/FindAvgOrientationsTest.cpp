@@ -0,0 +1,276 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindAvgOrientations.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindAvgOrientationsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_FeatureDataName = {"CellFeatureData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_QuatsName = {"Quats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_AvgQuatsName = {"AvgQuats"};
+  const QString k_AvgEulersName = {"AvgEulerAngles"};
+
+  static constexpr size_t k_CellsPerFeature = 5;
+  static constexpr size_t k_NumFeatures = 3;
+  // Every Feature's cells, followed by one phase 0 cell and one cell with Feature Id 0
+  static constexpr size_t k_NumCells = (k_NumFeatures - 1) * k_CellsPerFeature + 2;
+
+public:
+  FindAvgOrientationsTest() = default;
+  ~FindAvgOrientationsTest() = default;
+
+  FindAvgOrientationsTest(const FindAvgOrientationsTest&) = delete;            // Copy Constructor
+  FindAvgOrientationsTest(FindAvgOrientationsTest&&) = delete;                 // Move Constructor
+  FindAvgOrientationsTest& operator=(const FindAvgOrientationsTest&) = delete; // Copy Assignment
+  FindAvgOrientationsTest& operator=(FindAvgOrientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  QuatD axisAngleQuat(double x, double y, double z, double angle)
+  {
+    double norm = std::sqrt(x * x + y * y + z * z);
+    double s = std::sin(0.5 * angle) / norm;
+    return QuatD(s * x, s * y, s * z, std::cos(0.5 * angle));
+  }
+
+  // -----------------------------------------------------------------------------
+  // The mean orientation of each Feature
+  // -----------------------------------------------------------------------------
+  QuatD featureMean(size_t feature)
+  {
+    return feature == 1 ? axisAngleQuat(0.0, 0.0, 1.0, 20.0 * SIMPLib::Constants::k_PiOver180D) : axisAngleQuat(1.0, 1.0, 0.0, 40.0 * SIMPLib::Constants::k_PiOver180D);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Each Feature has its mean orientation and the mean rotated by +/-3 degrees about two perpendicular axes, so the
+  // mean of the five cells is exactly the Feature mean. Every cell is then replaced by a cubic symmetric equivalent
+  // and every other cell is negated into the opposite hemisphere.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {k_NumCells, 1, 1};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(dims, {4ULL}, k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(dims, {1ULL}, k_PhasesName, true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims, {1ULL}, k_FeatureIdsName, true);
+
+    // 90 degrees about X, 180 degrees about Y, 120 degrees about [111] and the identity are all cubic symmetry operators
+    const double halfRoot2 = std::sqrt(0.5);
+    const std::vector<QuatD> symOps = {QuatD(0.0, 0.0, 0.0, 1.0), QuatD(halfRoot2, 0.0, 0.0, halfRoot2), QuatD(0.0, 1.0, 0.0, 0.0), QuatD(0.5, 0.5, 0.5, 0.5)};
+    const double scatter = 3.0 * SIMPLib::Constants::k_PiOver180D;
+
+    size_t cell = 0;
+    for(size_t feature = 1; feature < k_NumFeatures; feature++)
+    {
+      QuatD mean = featureMean(feature);
+      const double perpendicular[2][3] = {{1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}};
+      std::vector<QuatD> featureQuats = {mean};
+      for(const auto& axis : perpendicular)
+      {
+        featureQuats.push_back(mean * axisAngleQuat(axis[0], axis[1], axis[2], scatter));
+        featureQuats.push_back(mean * axisAngleQuat(axis[0], axis[1], axis[2], -scatter));
+      }
+
+      for(size_t c = 0; c < k_CellsPerFeature; c++)
+      {
+        QuatD q = symOps[(c + feature) % symOps.size()] * featureQuats[c];
+        double sign = (c % 2 == 0) ? 1.0 : -1.0;
+        quats->setComponent(cell, 0, static_cast<float>(sign * q.x()));
+        quats->setComponent(cell, 1, static_cast<float>(sign * q.y()));
+        quats->setComponent(cell, 2, static_cast<float>(sign * q.z()));
+        quats->setComponent(cell, 3, static_cast<float>(sign * q.w()));
+        phases->setValue(cell, 1);
+        featureIds->setValue(cell, static_cast<int32_t>(feature));
+        cell++;
+      }
+    }
+
+    // Far from both means, so either cell would move the averages if it were used
+    QuatD wild = axisAngleQuat(1.0, 2.0, 3.0, 1.0);
+    for(size_t c = cell; c < k_NumCells; c++)
+    {
+      quats->setComponent(c, 0, static_cast<float>(wild.x()));
+      quats->setComponent(c, 1, static_cast<float>(wild.y()));
+      quats->setComponent(c, 2, static_cast<float>(wild.z()));
+      quats->setComponent(c, 3, static_cast<float>(wild.w()));
+    }
+    phases->setValue(cell, 0);
+    featureIds->setValue(cell, 1);
+    phases->setValue(cell + 1, 1);
+    featureIds->setValue(cell + 1, 0);
+
+    cellAM->insertOrAssign(quats);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(featureIds);
+
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({k_NumFeatures}, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runFilter(int averagingMethod)
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    FindAvgOrientations::Pointer filter = FindAvgOrientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setAveragingMethod(averagingMethod);
+    filter->setFeatureIdsArrayPath({k_DataContainerName, k_CellDataName, k_FeatureIdsName});
+    filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+    filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setAvgQuatsArrayPath({k_DataContainerName, k_FeatureDataName, k_AvgQuatsName});
+    filter->setAvgEulerAnglesArrayPath({k_DataContainerName, k_FeatureDataName, k_AvgEulersName});
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Both reference orientation methods must recover each Feature's mean, up to cubic symmetry
+  // -----------------------------------------------------------------------------
+  int TestReferenceAverages()
+  {
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    const LaueOps::Pointer& ops = orientationOps[EbsdLib::CrystalStructure::Cubic_High];
+
+    for(int averagingMethod : {1, 2})
+    {
+      DataContainerArray::Pointer dca = runFilter(averagingMethod);
+      AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+      FloatArrayType::Pointer avgQuats = featureAM->getAttributeArrayAs<FloatArrayType>(k_AvgQuatsName);
+      DREAM3D_REQUIRE_VALID_POINTER(avgQuats.get());
+
+      for(size_t feature = 1; feature < k_NumFeatures; feature++)
+      {
+        QuatD mean = featureMean(feature);
+        QuatF expected(static_cast<float>(mean.x()), static_cast<float>(mean.y()), static_cast<float>(mean.z()), static_cast<float>(mean.w()));
+        float* avgQuat = avgQuats->getTuplePointer(feature);
+        QuatF actual = ops->getNearestQuat(expected, QuatF(avgQuat[0], avgQuat[1], avgQuat[2], avgQuat[3]));
+        DREAM3D_REQUIRE(std::abs(actual.x() - expected.x()) < 1.0E-5F);
+        DREAM3D_REQUIRE(std::abs(actual.y() - expected.y()) < 1.0E-5F);
+        DREAM3D_REQUIRE(std::abs(actual.z() - expected.z()) < 1.0E-5F);
+        DREAM3D_REQUIRE(std::abs(actual.w() - expected.w()) < 1.0E-5F);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The running average must still give exactly what its serial loop gives, including the identity the sum starts at
+  // -----------------------------------------------------------------------------
+  int TestRunningAverage()
+  {
+    DataContainerArray::Pointer dca = runFilter(0);
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    FloatArrayType::Pointer avgQuats = featureAM->getAttributeArrayAs<FloatArrayType>(k_AvgQuatsName);
+    FloatArrayType::Pointer avgEulers = featureAM->getAttributeArrayAs<FloatArrayType>(k_AvgEulersName);
+    DREAM3D_REQUIRE_VALID_POINTER(avgQuats.get());
+    DREAM3D_REQUIRE_VALID_POINTER(avgEulers.get());
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""});
+    FloatArrayType::Pointer quats = cellAM->getAttributeArrayAs<FloatArrayType>(k_QuatsName);
+    Int32ArrayType::Pointer phases = cellAM->getAttributeArrayAs<Int32ArrayType>(k_PhasesName);
+    Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    const LaueOps::Pointer& ops = orientationOps[EbsdLib::CrystalStructure::Cubic_High];
+    std::vector<QuatF> sums(k_NumFeatures, QuatF::identity());
+    std::vector<float> counts(k_NumFeatures, 0.0f);
+    for(size_t i = 0; i < k_NumCells; i++)
+    {
+      int32_t feature = featureIds->getValue(i);
+      if(feature <= 0 || phases->getValue(i) <= 0)
+      {
+        continue;
+      }
+      counts[feature] += 1.0f;
+      QuatF curavgquat = sums[feature];
+      curavgquat.scalarDivide(counts[feature]);
+      float* voxQuatPtr = quats->getTuplePointer(i);
+      QuatF nearestQuat = ops->getNearestQuat(curavgquat, QuatF(voxQuatPtr[0], voxQuatPtr[1], voxQuatPtr[2], voxQuatPtr[3]));
+      sums[feature] = curavgquat + nearestQuat;
+    }
+
+    for(size_t feature = 1; feature < k_NumFeatures; feature++)
+    {
+      QuatF expected = sums[feature];
+      expected.scalarDivide(counts[feature]);
+      expected = expected.unitQuaternion();
+      float* avgQuat = avgQuats->getTuplePointer(feature);
+      DREAM3D_REQUIRE_EQUAL(avgQuat[0], expected.x());
+      DREAM3D_REQUIRE_EQUAL(avgQuat[1], expected.y());
+      DREAM3D_REQUIRE_EQUAL(avgQuat[2], expected.z());
+      DREAM3D_REQUIRE_EQUAL(avgQuat[3], expected.w());
+
+      OrientationF eulers = OrientationTransformation::qu2eu<QuatF, OrientationF>(expected);
+      for(size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE(std::abs(avgEulers->getComponent(feature, c) - eulers[c]) < 1.0E-5F);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestReferenceAverages())
+    DREAM3D_REGISTER_TEST(TestRunningAverage())
+  }
+
+private:
+};
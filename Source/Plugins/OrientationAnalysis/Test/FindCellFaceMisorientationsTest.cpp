@@ -0,0 +1,348 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/BadDataNeighborOrientationCheck.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindCellFaceMisorientations.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/NeighborOrientationCorrelation.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/CellFaceMisorientations.hpp"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindCellFaceMisorientationsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_QuatsName = {"Quats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_ConfidenceIndexName = {"Confidence Index"};
+  const QString k_GoodVoxelsName = {"GoodVoxels"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_FaceMisorientationsName = {"FaceMisorientations"};
+  const QString k_RecomputedFacesName = {"RecomputedFaceMisorientations"};
+
+  static constexpr size_t k_XSize = 6;
+  static constexpr size_t k_YSize = 5;
+  static constexpr size_t k_ZSize = 3;
+
+public:
+  FindCellFaceMisorientationsTest() = default;
+  ~FindCellFaceMisorientationsTest() = default;
+
+  FindCellFaceMisorientationsTest(const FindCellFaceMisorientationsTest&) = delete;            // Copy Constructor
+  FindCellFaceMisorientationsTest(FindCellFaceMisorientationsTest&&) = delete;                 // Move Constructor
+  FindCellFaceMisorientationsTest& operator=(const FindCellFaceMisorientationsTest&) = delete; // Copy Assignment
+  FindCellFaceMisorientationsTest& operator=(FindCellFaceMisorientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  size_t cellIndex(size_t x, size_t y, size_t z) const
+  {
+    return (z * k_YSize + y) * k_XSize + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Cells with x < 3 belong to a grain rotated about Z by a few hundredths of a radian, the other cells to a
+  // grain rotated about Z by about 0.5 radians. Cells (1,2,1) and (2,2,1) have a low confidence but keep the
+  // orientation of their grain, while cells (4,2,1) and (1,1,0) have a low confidence and a wild orientation.
+  // Cell (0,0,0) is phase 0.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {k_XSize, k_YSize, k_ZSize};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(dims, {4ULL}, k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(dims, {1ULL}, k_PhasesName, true);
+    FloatArrayType::Pointer confidenceIndex = FloatArrayType::CreateArray(dims, {1ULL}, k_ConfidenceIndexName, true);
+    BoolArrayType::Pointer goodVoxels = BoolArrayType::CreateArray(dims, {1ULL}, k_GoodVoxelsName, true);
+
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        for(size_t x = 0; x < k_XSize; x++)
+        {
+          size_t i = cellIndex(x, y, z);
+          float angle = x < 3 ? 0.01F * static_cast<float>(i % 7) : 0.5F + 0.01F * static_cast<float>(i % 5);
+          quats->setComponent(i, 0, 0.0F);
+          quats->setComponent(i, 1, 0.0F);
+          quats->setComponent(i, 2, std::sin(0.5F * angle));
+          quats->setComponent(i, 3, std::cos(0.5F * angle));
+          phases->setValue(i, 1);
+          confidenceIndex->setValue(i, 0.9F);
+          goodVoxels->setValue(i, true);
+        }
+      }
+    }
+    phases->setValue(cellIndex(0, 0, 0), 0);
+
+    for(size_t i : {cellIndex(1, 2, 1), cellIndex(2, 2, 1), cellIndex(4, 2, 1), cellIndex(1, 1, 0)})
+    {
+      confidenceIndex->setValue(i, 0.05F);
+      goodVoxels->setValue(i, false);
+    }
+    // A rotation of 0.7 radians about X is far from both grains
+    for(size_t i : {cellIndex(4, 2, 1), cellIndex(1, 1, 0)})
+    {
+      quats->setComponent(i, 0, std::sin(0.35F));
+      quats->setComponent(i, 1, 0.0F);
+      quats->setComponent(i, 2, 0.0F);
+      quats->setComponent(i, 3, std::cos(0.35F));
+    }
+
+    cellAM->insertOrAssign(quats);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(confidenceIndex);
+    cellAM->insertOrAssign(goodVoxels);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  FindCellFaceMisorientations::Pointer createFindFilter(const DataContainerArray::Pointer& dca, const QString& facesName)
+  {
+    FindCellFaceMisorientations::Pointer filter = FindCellFaceMisorientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+    filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setFaceMisorientationsArrayPath({k_DataContainerName, k_CellDataName, facesName});
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  int runFindFilter(const DataContainerArray::Pointer& dca, const QString& facesName)
+  {
+    FindCellFaceMisorientations::Pointer filter = createFindFilter(dca, facesName);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int compareArrays(const DataContainerArray::Pointer& dca1, const DataContainerArray::Pointer& dca2, const QString& arrayName)
+  {
+    typename DataArray<T>::Pointer array1 = dca1->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<DataArray<T>>(arrayName);
+    typename DataArray<T>::Pointer array2 = dca2->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<DataArray<T>>(arrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(array1.get());
+    DREAM3D_REQUIRE_VALID_POINTER(array2.get());
+    DREAM3D_REQUIRE_EQUAL(array1->getSize(), array2->getSize());
+    for(size_t i = 0; i < array1->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(array1->getValue(i), array2->getValue(i));
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every face must hold exactly the angle that calculateMisorientation returns for its two cells
+  // -----------------------------------------------------------------------------
+  int TestFaceMisorientations()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    FindCellFaceMisorientations::Pointer filter = createFindFilter(dca, k_FaceMisorientationsName);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    dca = createDataStructure();
+    int err = runFindFilter(dca, k_FaceMisorientationsName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""});
+    FloatArrayType::Pointer faces = cellAM->getAttributeArrayAs<FloatArrayType>(k_FaceMisorientationsName);
+    DREAM3D_REQUIRE_VALID_POINTER(faces.get());
+    DREAM3D_REQUIRE_EQUAL(faces->getNumberOfComponents(), 3);
+    FloatArrayType::Pointer quats = cellAM->getAttributeArrayAs<FloatArrayType>(k_QuatsName);
+    Int32ArrayType::Pointer phases = cellAM->getAttributeArrayAs<Int32ArrayType>(k_PhasesName);
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    const size_t dims[3] = {k_XSize, k_YSize, k_ZSize};
+    const size_t strides[3] = {1, k_XSize, k_XSize * k_YSize};
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        for(size_t x = 0; x < k_XSize; x++)
+        {
+          const size_t cell = cellIndex(x, y, z);
+          const size_t pos[3] = {x, y, z};
+          for(size_t axis = 0; axis < 3; axis++)
+          {
+            float expected = CellFaceMisorientations::k_NoMisorientation;
+            const size_t neighbor = cell + strides[axis];
+            if(pos[axis] < dims[axis] - 1 && phases->getValue(cell) == 1 && phases->getValue(neighbor) == 1)
+            {
+              QuatF q1(quats->getComponent(cell, 0), quats->getComponent(cell, 1), quats->getComponent(cell, 2), quats->getComponent(cell, 3));
+              QuatF q2(quats->getComponent(neighbor, 0), quats->getComponent(neighbor, 1), quats->getComponent(neighbor, 2), quats->getComponent(neighbor, 3));
+              OrientationF axisAngle = orientationOps[EbsdLib::CrystalStructure::Cubic_High]->calculateMisorientation(q1, q2);
+              expected = axisAngle[3];
+            }
+            DREAM3D_REQUIRE_EQUAL(faces->getComponent(cell, axis), expected);
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The face misorientations must not change which cells BadDataNeighborOrientationCheck marks as good
+  // -----------------------------------------------------------------------------
+  int TestBadDataNeighborOrientationCheck()
+  {
+    std::vector<DataContainerArray::Pointer> results;
+    for(bool useFaceMisorientations : {false, true})
+    {
+      DataContainerArray::Pointer dca = createDataStructure();
+      if(useFaceMisorientations)
+      {
+        int err = runFindFilter(dca, k_FaceMisorientationsName);
+        DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+      }
+
+      BadDataNeighborOrientationCheck::Pointer filter = BadDataNeighborOrientationCheck::New();
+      filter->setDataContainerArray(dca);
+      filter->setMisorientationTolerance(5.0F);
+      filter->setNumberOfNeighbors(3);
+      filter->setGoodVoxelsArrayPath({k_DataContainerName, k_CellDataName, k_GoodVoxelsName});
+      filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+      filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+      filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+      filter->setUseFaceMisorientations(useFaceMisorientations);
+      filter->setFaceMisorientationsArrayPath({k_DataContainerName, k_CellDataName, k_FaceMisorientationsName});
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+      results.push_back(dca);
+    }
+
+    int err = compareArrays<bool>(results[0], results[1], k_GoodVoxelsName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+
+    // The cells that agree with their grain are flipped back to good, the wild ones stay bad
+    BoolArrayType::Pointer goodVoxels = results[1]->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<BoolArrayType>(k_GoodVoxelsName);
+    DREAM3D_REQUIRE_EQUAL(goodVoxels->getValue(cellIndex(1, 2, 1)), true);
+    DREAM3D_REQUIRE_EQUAL(goodVoxels->getValue(cellIndex(2, 2, 1)), true);
+    DREAM3D_REQUIRE_EQUAL(goodVoxels->getValue(cellIndex(4, 2, 1)), false);
+    DREAM3D_REQUIRE_EQUAL(goodVoxels->getValue(cellIndex(1, 1, 0)), false);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The face misorientations must not change the result of NeighborOrientationCorrelation, and the filter must
+  // leave the face misorientations matching the orientations it wrote
+  // -----------------------------------------------------------------------------
+  int TestNeighborOrientationCorrelation()
+  {
+    std::vector<DataContainerArray::Pointer> results;
+    for(bool useFaceMisorientations : {false, true})
+    {
+      DataContainerArray::Pointer dca = createDataStructure();
+      if(useFaceMisorientations)
+      {
+        int err = runFindFilter(dca, k_FaceMisorientationsName);
+        DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+      }
+
+      NeighborOrientationCorrelation::Pointer filter = NeighborOrientationCorrelation::New();
+      filter->setDataContainerArray(dca);
+      filter->setMisorientationTolerance(5.0F);
+      filter->setMinConfidence(0.1F);
+      filter->setLevel(2);
+      filter->setConfidenceIndexArrayPath({k_DataContainerName, k_CellDataName, k_ConfidenceIndexName});
+      filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+      filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+      filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+      filter->setUseFaceMisorientations(useFaceMisorientations);
+      filter->setFaceMisorientationsArrayPath({k_DataContainerName, k_CellDataName, k_FaceMisorientationsName});
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+      results.push_back(dca);
+    }
+
+    int err = compareArrays<float>(results[0], results[1], k_QuatsName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    err = compareArrays<int32_t>(results[0], results[1], k_PhasesName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    err = compareArrays<float>(results[0], results[1], k_ConfidenceIndexName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    err = compareArrays<bool>(results[0], results[1], k_GoodVoxelsName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+
+    // The wild cells must have been replaced by one of their neighbors
+    FloatArrayType::Pointer quats = results[1]->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<FloatArrayType>(k_QuatsName);
+    DREAM3D_REQUIRE(quats->getComponent(cellIndex(4, 2, 1), 0) != std::sin(0.35F));
+    DREAM3D_REQUIRE(quats->getComponent(cellIndex(1, 1, 0), 0) != std::sin(0.35F));
+
+    // The updated face misorientations must match a fresh computation from the corrected orientations
+    err = runFindFilter(results[1], k_RecomputedFacesName);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    return compareFaces(results[1]);
+  }
+
+  // -----------------------------------------------------------------------------
+  int compareFaces(const DataContainerArray::Pointer& dca)
+  {
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""});
+    FloatArrayType::Pointer faces = cellAM->getAttributeArrayAs<FloatArrayType>(k_FaceMisorientationsName);
+    FloatArrayType::Pointer recomputed = cellAM->getAttributeArrayAs<FloatArrayType>(k_RecomputedFacesName);
+    DREAM3D_REQUIRE_VALID_POINTER(faces.get());
+    DREAM3D_REQUIRE_VALID_POINTER(recomputed.get());
+    for(size_t i = 0; i < faces->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(faces->getValue(i), recomputed->getValue(i));
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFaceMisorientations())
+    DREAM3D_REGISTER_TEST(TestBadDataNeighborOrientationCheck())
+    DREAM3D_REGISTER_TEST(TestNeighborOrientationCorrelation())
+  }
+
+private:
+};
@@ -0,0 +1,197 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindKernelAvgMisorientations.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindKernelAvgMisorientationsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_QuatsName = {"Quats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_KernelAverageMisorientationsName = {"KernelAverageMisorientations"};
+
+  // 240 rows, so the pair reusing path splits the volume into 3 to 8 slabs for the kernels tested here and
+  // most slab boundaries fall in the middle of a plane
+  static constexpr size_t k_XSize = 4;
+  static constexpr size_t k_YSize = 6;
+  static constexpr size_t k_ZSize = 40;
+
+public:
+  FindKernelAvgMisorientationsTest() = default;
+  ~FindKernelAvgMisorientationsTest() = default;
+
+  FindKernelAvgMisorientationsTest(const FindKernelAvgMisorientationsTest&) = delete;            // Copy Constructor
+  FindKernelAvgMisorientationsTest(FindKernelAvgMisorientationsTest&&) = delete;                 // Move Constructor
+  FindKernelAvgMisorientationsTest& operator=(const FindKernelAvgMisorientationsTest&) = delete; // Copy Assignment
+  FindKernelAvgMisorientationsTest& operator=(FindKernelAvgMisorientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  size_t cellIndex(size_t x, size_t y, size_t z) const
+  {
+    return (z * k_YSize + y) * k_XSize + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Eight features of 2 x 6 x 10 cells, each scattered by a few degrees about its own orientation. Features in
+  // the lower half of the volume are cubic (phase 1) and those in the upper half hexagonal (phase 2), but every
+  // seventh cell of a feature takes the other phase and every eleventh cell is phase 0. Every thirteenth cell
+  // has feature id 0.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {k_XSize, k_YSize, k_ZSize};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(dims, {4ULL}, k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(dims, {1ULL}, k_PhasesName, true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims, {1ULL}, k_FeatureIdsName, true);
+
+    std::mt19937_64 generator(4321);
+    std::uniform_real_distribution<double> scatter(-0.05, 0.05);
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        for(size_t x = 0; x < k_XSize; x++)
+        {
+          size_t i = cellIndex(x, y, z);
+          int32_t feature = static_cast<int32_t>(1 + (z / 10) * 2 + x / 2);
+          int32_t phase = z < k_ZSize / 2 ? 1 : 2;
+          if(i % 7 == 3)
+          {
+            phase = 3 - phase;
+          }
+          if(i % 11 == 5)
+          {
+            phase = 0;
+          }
+          if(i % 13 == 8)
+          {
+            feature = 0;
+          }
+
+          // Rotate about the axis (1, 2, 3) by an angle set by the feature, then scatter each component
+          double angle = 0.4 * static_cast<double>(feature);
+          double sinHalf = std::sin(0.5 * angle) / std::sqrt(14.0);
+          double q[4] = {sinHalf + scatter(generator), 2.0 * sinHalf + scatter(generator), 3.0 * sinHalf + scatter(generator), std::cos(0.5 * angle) + scatter(generator)};
+          double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(i, c, static_cast<float>(q[c] / norm));
+          }
+          phases->setValue(i, phase);
+          featureIds->setValue(i, feature);
+        }
+      }
+    }
+
+    cellAM->insertOrAssign(quats);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(featureIds);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({3}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, EbsdLib::CrystalStructure::Hexagonal_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer runFilter(const IntVec3Type& kernelSize, bool reusePairMisorientations)
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    FindKernelAvgMisorientations::Pointer filter = FindKernelAvgMisorientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setKernelSize(kernelSize);
+    filter->setReusePairMisorientations(reusePairMisorientations);
+    filter->setFeatureIdsArrayPath({k_DataContainerName, k_CellDataName, k_FeatureIdsName});
+    filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+    filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setKernelAverageMisorientationsArrayName(k_KernelAverageMisorientationsName);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    FloatArrayType::Pointer kam = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<FloatArrayType>(k_KernelAverageMisorientationsName);
+    DREAM3D_REQUIRE_VALID_POINTER(kam.get());
+    return kam;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The slab path must reproduce the per voxel kernel. The two only differ in the order the angles are summed
+  // and in computing a same phase pair from one side, so the results agree to float precision.
+  // -----------------------------------------------------------------------------
+  int TestSlabsMatchLegacy()
+  {
+    const std::vector<IntVec3Type> kernelSizes = {IntVec3Type(1, 1, 1), IntVec3Type(2, 2, 2), IntVec3Type(3, 3, 3), IntVec3Type(3, 1, 2)};
+    for(const IntVec3Type& kernelSize : kernelSizes)
+    {
+      FloatArrayType::Pointer legacy = runFilter(kernelSize, false);
+      FloatArrayType::Pointer slabs = runFilter(kernelSize, true);
+      DREAM3D_REQUIRE_EQUAL(legacy->getNumberOfTuples(), slabs->getNumberOfTuples());
+
+      size_t nonZero = 0;
+      for(size_t i = 0; i < legacy->getNumberOfTuples(); i++)
+      {
+        float expected = legacy->getValue(i);
+        DREAM3D_REQUIRE(std::abs(expected - slabs->getValue(i)) <= 1.0E-4F * std::max(1.0F, expected));
+        if(expected > 0.0F)
+        {
+          nonZero++;
+        }
+      }
+      DREAM3D_REQUIRED(nonZero, >, 0);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSlabsMatchLegacy())
+  }
+
+private:
+};
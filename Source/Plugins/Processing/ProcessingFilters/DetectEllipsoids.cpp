@@ -50,6 +50,7 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -139,6 +140,7 @@ void DetectEllipsoids::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Threshold for Hough Transform", HoughTransformThreshold, FilterParameter::Category::Parameter, DetectEllipsoids));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Aspect Ratio", MinAspectRatio, FilterParameter::Category::Parameter, DetectEllipsoids));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Length of Image Scale Bar", ImageScaleBarLength, FilterParameter::Category::Parameter, DetectEllipsoids));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use FFT Convolution", UseFFTConvolution, FilterParameter::Category::Parameter, DetectEllipsoids));
 
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -1620,3 +1622,15 @@ int DetectEllipsoids::getImageScaleBarLength() const
 {
   return m_ImageScaleBarLength;
 }
+
+// -----------------------------------------------------------------------------
+void DetectEllipsoids::setUseFFTConvolution(bool value)
+{
+  m_UseFFTConvolution = value;
+}
+
+// -----------------------------------------------------------------------------
+bool DetectEllipsoids::getUseFFTConvolution() const
+{
+  return m_UseFFTConvolution;
+}
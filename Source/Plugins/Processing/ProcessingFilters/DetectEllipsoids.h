@@ -77,6 +77,7 @@ class Processing_EXPORT DetectEllipsoids : public AbstractFilter
   PYB11_PROPERTY(float HoughTransformThreshold READ getHoughTransformThreshold WRITE setHoughTransformThreshold)
   PYB11_PROPERTY(float MinAspectRatio READ getMinAspectRatio WRITE setMinAspectRatio)
   PYB11_PROPERTY(int ImageScaleBarLength READ getImageScaleBarLength WRITE setImageScaleBarLength)
+  PYB11_PROPERTY(bool UseFFTConvolution READ getUseFFTConvolution WRITE setUseFFTConvolution)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -261,6 +262,17 @@ public:
   int getImageScaleBarLength() const;
   Q_PROPERTY(int ImageScaleBarLength READ getImageScaleBarLength WRITE setImageScaleBarLength)
 
+  /**
+   * @brief Setter property for UseFFTConvolution
+   */
+  void setUseFFTConvolution(bool value);
+  /**
+   * @brief Getter property for UseFFTConvolution
+   * @return Value of UseFFTConvolution
+   */
+  bool getUseFFTConvolution() const;
+  Q_PROPERTY(bool UseFFTConvolution READ getUseFFTConvolution WRITE setUseFFTConvolution)
+
   void incrementEllipseCount();
 
   /**
@@ -369,6 +381,7 @@ private:
   float m_HoughTransformThreshold = {0.5f};
   float m_MinAspectRatio = {0.4f};
   int m_ImageScaleBarLength = {100};
+  bool m_UseFFTConvolution = {false};
 
   static double m_img_scale_length;
   int32_t m_MaxFeatureId = 0;
@@ -36,6 +36,7 @@
 #include "DetectEllipsoidsImpl.h"
 
 #include "ProcessingFilters/HelperClasses/ComputeGradient.h"
+#include "ProcessingFilters/HelperClasses/FFTConvolution.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 // -----------------------------------------------------------------------------
@@ -117,6 +118,18 @@ void DetectEllipsoidsImpl::operator()() const
     accum_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
   }
 
+  // Scratch buffers and kernel spectra reused for every object and iteration this thread processes
+  FFTConvolution fftConvolution(m_ConvCoords_X, m_ConvCoords_Y, m_ConvKernel_tDims[0], m_ConvKernel_tDims[1]);
+  bool useFFTConvolution = m_Filter->getUseFFTConvolution();
+  DoubleArrayType::Pointer featureObjArray = DoubleArrayType::CreateArray(0, std::string("featureObjArray"), true);
+  DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(0, std::string("obj_conv_mag"), true);
+  DoubleArrayType::Pointer obj_conv_thresh = DoubleArrayType::CreateArray(0, std::string("obj_conv_thresh"), true);
+  DoubleArrayType::Pointer obj_mask = DoubleArrayType::CreateArray(0, std::string("obj_mask"), true);
+  Int32ArrayType::Pointer featureObjOnesArray = Int32ArrayType::CreateArray(0, std::string("featureObjOnesArray"), true);
+  DE_ComplexDoubleVector gradX_conv;
+  DE_ComplexDoubleVector gradY_conv;
+  std::vector<double> obj_conv_mag_smooth;
+
   // Run the ellipse detection algorithm on each object
   int32_t featureId = m_Filter->getNextFeatureId();
   while(featureId > 0)
@@ -139,9 +152,13 @@ void DetectEllipsoidsImpl::operator()() const
     // image_tDims.push_back(paddedObj_zDim);  // 3DIM: This can be changed later to handle 3-dimensions
 
     // Copy the feature id object into its own flattened 2D array called featureObjArray
-    std::vector<size_t> cDims(1, 1);
-    DoubleArrayType::Pointer featureObjArray = DoubleArrayType::CreateArray(paddedObj_tDims, cDims, "featureObjArray", true);
+    size_t paddedObj_numTuples = paddedObj_xDim * paddedObj_yDim;
+    featureObjArray->resizeTuples(paddedObj_numTuples);
     featureObjArray->initializeWithZeros();
+    obj_conv_mag->resizeTuples(paddedObj_numTuples);
+    obj_conv_thresh->resizeTuples(paddedObj_numTuples);
+    obj_mask->resizeTuples(paddedObj_numTuples);
+    featureObjOnesArray->resizeTuples(paddedObj_numTuples);
 
     size_t z = 0; // 3DIM: This can be changed later to handle 3-dimensions
                   //    for (size_t z = topL_Z; z <= bottomR_Z; z++)  // 3DIM: This can be changed later to handle 3-dimensions
@@ -191,21 +208,30 @@ void DetectEllipsoidsImpl::operator()() const
       DoubleArrayType::Pointer gradX = grad.getGradX();
       DoubleArrayType::Pointer gradY = grad.getGradY();
 
-      // Convolute Gradient of object with convolution kernel
-      DE_ComplexDoubleVector gradX_conv = convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims);
-      DE_ComplexDoubleVector gradY_conv = convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims);
-
-      // Calculate the magnitude matrix of the convolution.
-      DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(gradX_conv.size(), std::vector<size_t>(1, 1), "obj_conv_mag", true);
-      for(int i = 0; i < gradX_conv.size(); i++)
+      // Convolute Gradient of object with convolution kernel and calculate the magnitude matrix of the convolution.
+      if(useFFTConvolution)
       {
-        std::complex<double> complexValue = gradX_conv[i] + gradY_conv[i];
-        double value = std::abs(complexValue);
-        obj_conv_mag->setValue(i, value);
+        // The FFT path sums both convolutions in the frequency domain
+        fftConvolution.convolveSum(gradX->getPointer(0), gradY->getPointer(0), paddedObj_xDim, paddedObj_yDim, gradX_conv);
+        for(int i = 0; i < gradX_conv.size(); i++)
+        {
+          obj_conv_mag->setValue(i, std::abs(gradX_conv[i]));
+        }
+      }
+      else
+      {
+        convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims, gradX_conv);
+        convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims, gradY_conv);
+        for(int i = 0; i < gradX_conv.size(); i++)
+        {
+          std::complex<double> complexValue = gradX_conv[i] + gradY_conv[i];
+          double value = std::abs(complexValue);
+          obj_conv_mag->setValue(i, value);
+        }
       }
 
       // Smooth the magnitude matrix using a smoothing kernel.
-      std::vector<double> obj_conv_mag_smooth = convoluteImage(obj_conv_mag, m_SmoothKernel, m_SmoothOffsetArray, paddedObj_tDims);
+      convoluteImage(obj_conv_mag, m_SmoothKernel, m_SmoothOffsetArray, paddedObj_tDims, obj_conv_mag_smooth);
       double obj_conv_max = 0;
       for(int i = 0; i < obj_conv_mag_smooth.size(); i++)
       {
@@ -218,7 +244,6 @@ void DetectEllipsoidsImpl::operator()() const
       }
 
       // Create threshold matrix
-      DoubleArrayType::Pointer obj_conv_thresh = DoubleArrayType::CreateArray(obj_conv_mag->getNumberOfTuples(), std::vector<size_t>(1, 1), "obj_conv_thresh", true);
       obj_conv_thresh->initializeWithZeros();
       for(int i = 0; i < obj_conv_thresh->getNumberOfTuples(); i++)
       {
@@ -279,7 +304,6 @@ void DetectEllipsoidsImpl::operator()() const
         }
 
         // Create and populate mask array of the sub-object
-        DoubleArrayType::Pointer obj_mask = DoubleArrayType::CreateArray(paddedObj_tDims, std::vector<size_t>(1, 1), "obj_mask", true);
         obj_mask->initializeWithZeros();
 
         for(size_t y = mask_min_y - 1; y < mask_max_y; y++)
@@ -381,7 +405,6 @@ void DetectEllipsoidsImpl::operator()() const
           m_Rotangle->setValue(objId, rotangle_val);
 
           // Remove the sub-object from the feature id object's 2D array
-          Int32ArrayType::Pointer featureObjOnesArray = Int32ArrayType::CreateArray(paddedObj_tDims, std::vector<size_t>(1, 1), "featureObjOnesArray", true);
           featureObjOnesArray->initializeWithValue(1);
 
           Int32ArrayType::Pointer I_tmp = m_Filter->fillEllipse(featureObjOnesArray, paddedObj_tDims, cenx_val, ceny_val, majaxis_val + 1, minaxis_val + 1, rotangle_val, 0);
@@ -142,7 +142,21 @@ public:
   std::vector<T> convoluteImage(DoubleArrayType::Pointer image, std::vector<T> kernel, Int32ArrayType::Pointer offsetArray, std::vector<size_t> image_tDims) const
   {
     std::vector<T> convArray;
+    convoluteImage(image, kernel, offsetArray, image_tDims, convArray);
+    return convArray;
+  }
 
+  /**
+   * @brief convoluteImage Same as above, but writes into a caller owned array so that it can be reused between calls
+   * @param image
+   * @param kernel
+   * @param offsetArray
+   * @param image_tDims
+   * @param convArray Resized to the number of tuples in image
+   */
+  template <typename T>
+  void convoluteImage(DoubleArrayType::Pointer image, const std::vector<T>& kernel, Int32ArrayType::Pointer offsetArray, const std::vector<size_t>& image_tDims, std::vector<T>& convArray) const
+  {
     int* offsetArrayPtr = offsetArray->getPointer(0);
     double* imageArray = image->getPointer(0);
     int offsetArrayNumOfComps = offsetArray->getNumberOfComponents();
@@ -153,6 +167,7 @@ public:
     size_t zDim = 1; // 3DIM: This can be changed later to handle 3-dimensions
     int gradNumTuples = image->getNumberOfTuples();
     int reverseKernelCount = kernel.size();
+    convArray.resize(gradNumTuples);
     for(int i = 0; i < gradNumTuples; i++)
     {
       size_t imageCurrentX = 0, imageCurrentY = 0, imageCurrentZ = 0;
@@ -190,11 +205,9 @@ public:
         }
       }
 
-      convArray.push_back(accumulator);
+      convArray[i] = accumulator;
       accumulator = 0;
     }
-
-    return convArray;
   }
 
   /**
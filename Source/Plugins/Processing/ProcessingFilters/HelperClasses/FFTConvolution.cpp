@@ -0,0 +1,222 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FFTConvolution.h"
+
+#include <cmath>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::FFTConvolution(const ComplexVector& reversedKernelX, const ComplexVector& reversedKernelY, size_t kernelXDim, size_t kernelYDim)
+: m_ReversedKernelX(reversedKernelX)
+, m_ReversedKernelY(reversedKernelY)
+, m_KernelXDim(kernelXDim)
+, m_KernelYDim(kernelYDim)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::~FFTConvolution() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FFTConvolution::NextPowerOfTwo(size_t value)
+{
+  size_t result = 1;
+  while(result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::convolveSum(const double* imageX, const double* imageY, size_t xDim, size_t yDim, ComplexVector& output)
+{
+  // Padding to the full linear convolution size keeps the circular convolution from wrapping around
+  size_t paddedXDim = NextPowerOfTwo(xDim + m_KernelXDim - 1);
+  size_t paddedYDim = NextPowerOfTwo(yDim + m_KernelYDim - 1);
+  size_t paddedSize = paddedXDim * paddedYDim;
+
+  const KernelSpectra& spectra = getKernelSpectra(paddedXDim, paddedYDim);
+
+  m_BufferX.assign(paddedSize, std::complex<double>(0.0, 0.0));
+  m_BufferY.assign(paddedSize, std::complex<double>(0.0, 0.0));
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      m_BufferX[y * paddedXDim + x] = imageX[y * xDim + x];
+      m_BufferY[y * paddedXDim + x] = imageY[y * xDim + x];
+    }
+  }
+
+  transform(m_BufferX, paddedXDim, paddedYDim, false);
+  transform(m_BufferY, paddedXDim, paddedYDim, false);
+  for(size_t i = 0; i < paddedSize; i++)
+  {
+    m_BufferX[i] = m_BufferX[i] * spectra.x[i] + m_BufferY[i] * spectra.y[i];
+  }
+  transform(m_BufferX, paddedXDim, paddedYDim, true);
+
+  // convoluteImage() centers the kernel on kernelDim / 2, which is this far into the full convolution
+  size_t shiftX = m_KernelXDim - 1 - m_KernelXDim / 2;
+  size_t shiftY = m_KernelYDim - 1 - m_KernelYDim / 2;
+  output.resize(xDim * yDim);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      output[y * xDim + x] = m_BufferX[(y + shiftY) * paddedXDim + (x + shiftX)];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const FFTConvolution::KernelSpectra& FFTConvolution::getKernelSpectra(size_t paddedXDim, size_t paddedYDim)
+{
+  std::pair<size_t, size_t> key(paddedXDim, paddedYDim);
+  auto iter = m_SpectraCache.find(key);
+  if(iter != m_SpectraCache.end())
+  {
+    return iter->second;
+  }
+
+  KernelSpectra& spectra = m_SpectraCache[key];
+  loadKernel(m_ReversedKernelX, spectra.x, paddedXDim, paddedYDim);
+  transform(spectra.x, paddedXDim, paddedYDim, false);
+  loadKernel(m_ReversedKernelY, spectra.y, paddedXDim, paddedYDim);
+  transform(spectra.y, paddedXDim, paddedYDim, false);
+  return spectra;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::loadKernel(const ComplexVector& reversedKernel, ComplexVector& buffer, size_t paddedXDim, size_t paddedYDim) const
+{
+  buffer.assign(paddedXDim * paddedYDim, std::complex<double>(0.0, 0.0));
+  size_t kernelSize = m_KernelXDim * m_KernelYDim;
+  for(size_t y = 0; y < m_KernelYDim; y++)
+  {
+    for(size_t x = 0; x < m_KernelXDim; x++)
+    {
+      buffer[y * paddedXDim + x] = reversedKernel[kernelSize - 1 - (y * m_KernelXDim + x)];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::transform(ComplexVector& data, size_t xDim, size_t yDim, bool inverse)
+{
+  for(size_t y = 0; y < yDim; y++)
+  {
+    fft1D(data.data() + y * xDim, xDim, inverse);
+  }
+
+  m_Column.resize(yDim);
+  for(size_t x = 0; x < xDim; x++)
+  {
+    for(size_t y = 0; y < yDim; y++)
+    {
+      m_Column[y] = data[y * xDim + x];
+    }
+    fft1D(m_Column.data(), yDim, inverse);
+    for(size_t y = 0; y < yDim; y++)
+    {
+      data[y * xDim + x] = m_Column[y];
+    }
+  }
+
+  if(inverse)
+  {
+    double scale = 1.0 / static_cast<double>(xDim * yDim);
+    for(auto& value : data)
+    {
+      value *= scale;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::fft1D(std::complex<double>* data, size_t n, bool inverse)
+{
+  // Bit reversal permutation
+  for(size_t i = 1, j = 0; i < n; i++)
+  {
+    size_t bit = n >> 1;
+    for(; (j & bit) != 0; bit >>= 1)
+    {
+      j ^= bit;
+    }
+    j ^= bit;
+    if(i < j)
+    {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  for(size_t len = 2; len <= n; len <<= 1)
+  {
+    double angle = 2.0 * SIMPLib::Constants::k_PiD / static_cast<double>(len) * (inverse ? 1.0 : -1.0);
+    std::complex<double> wLen(std::cos(angle), std::sin(angle));
+    for(size_t i = 0; i < n; i += len)
+    {
+      std::complex<double> w(1.0, 0.0);
+      for(size_t j = 0; j < len / 2; j++)
+      {
+        std::complex<double> u = data[i + j];
+        std::complex<double> v = data[i + j + len / 2] * w;
+        data[i + j] = u + v;
+        data[i + j + len / 2] = u - v;
+        w *= wLen;
+      }
+    }
+  }
+}
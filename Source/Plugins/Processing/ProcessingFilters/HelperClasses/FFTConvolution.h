@@ -0,0 +1,121 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The FFTConvolution class computes the same result as DetectEllipsoidsImpl::convoluteImage() for a pair
+ * of complex 2D kernels by multiplying spectra instead of summing over every kernel offset. The kernels are given
+ * in the reversed, x-fastest layout that convoluteImage() consumes and the output is the zero padded "same" sized
+ * convolution. Kernel spectra are cached per padded image size and the transform buffers are kept between calls,
+ * so one instance should be reused for all of the images a thread processes. Instances are not thread safe.
+ */
+class FFTConvolution
+{
+public:
+  using ComplexVector = std::vector<std::complex<double>>;
+
+  FFTConvolution(const ComplexVector& reversedKernelX, const ComplexVector& reversedKernelY, size_t kernelXDim, size_t kernelYDim);
+  virtual ~FFTConvolution();
+
+  /**
+   * @brief convolveSum Computes conv(imageX, kernelX) + conv(imageY, kernelY) for two real images of the same size
+   * @param imageX
+   * @param imageY
+   * @param xDim
+   * @param yDim
+   * @param output Resized to xDim * yDim values
+   */
+  void convolveSum(const double* imageX, const double* imageY, size_t xDim, size_t yDim, ComplexVector& output);
+
+  /**
+   * @brief transform In place radix-2 FFT of a 2D array whose dimensions are both powers of two
+   * @param data
+   * @param xDim
+   * @param yDim
+   * @param inverse Computes the inverse transform, including the 1/N scaling
+   */
+  void transform(ComplexVector& data, size_t xDim, size_t yDim, bool inverse);
+
+  /**
+   * @brief NextPowerOfTwo
+   * @param value
+   * @return The smallest power of two that is greater than or equal to value
+   */
+  static size_t NextPowerOfTwo(size_t value);
+
+private:
+  struct KernelSpectra
+  {
+    ComplexVector x;
+    ComplexVector y;
+  };
+
+  ComplexVector m_ReversedKernelX;
+  ComplexVector m_ReversedKernelY;
+  size_t m_KernelXDim = 0;
+  size_t m_KernelYDim = 0;
+
+  std::map<std::pair<size_t, size_t>, KernelSpectra> m_SpectraCache;
+  ComplexVector m_BufferX;
+  ComplexVector m_BufferY;
+  ComplexVector m_Column;
+
+  /**
+   * @brief getKernelSpectra Returns the cached kernel spectra for a padded size, computing them on first use
+   */
+  const KernelSpectra& getKernelSpectra(size_t paddedXDim, size_t paddedYDim);
+
+  /**
+   * @brief loadKernel Writes the un-reversed kernel into the top left corner of a zeroed padded buffer
+   */
+  void loadKernel(const ComplexVector& reversedKernel, ComplexVector& buffer, size_t paddedXDim, size_t paddedYDim) const;
+
+  /**
+   * @brief fft1D In place iterative radix-2 FFT of n contiguous values
+   */
+  static void fft1D(std::complex<double>* data, size_t n, bool inverse);
+
+public:
+  FFTConvolution(const FFTConvolution&) = delete;            // Copy Constructor Not Implemented
+  FFTConvolution(FFTConvolution&&) = delete;                 // Move Constructor Not Implemented
+  FFTConvolution& operator=(const FFTConvolution&) = delete; // Copy Assignment Not Implemented
+  FFTConvolution& operator=(FFTConvolution&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,340 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureIdRemapper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief The FindReferencedFeaturesImpl class implements a threaded algorithm that flags every
+ * Feature that is referenced by at least one Cell
+ */
+class FindReferencedFeaturesImpl
+{
+public:
+  FindReferencedFeaturesImpl(const int32_t* featureIds, std::atomic<uint8_t>* referenced, size_t totalFeatures)
+  : m_FeatureIds(featureIds)
+  , m_Referenced(referenced)
+  , m_TotalFeatures(totalFeatures)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      int32_t featureId = m_FeatureIds[i];
+      // Only store if not already set so the cache lines of large Features are not written over and over
+      if(featureId >= 0 && static_cast<size_t>(featureId) < m_TotalFeatures && m_Referenced[featureId].load(std::memory_order_relaxed) == 0)
+      {
+        m_Referenced[featureId].store(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  std::atomic<uint8_t>* m_Referenced = nullptr;
+  size_t m_TotalFeatures = 0;
+};
+
+/**
+ * @brief The RenumberFeatureIdsImpl class implements a threaded algorithm that applies the old->new
+ * Feature Id lookup table to every Cell
+ */
+class RenumberFeatureIdsImpl
+{
+public:
+  RenumberFeatureIdsImpl(int32_t* featureIds, const std::vector<int32_t>& newIds)
+  : m_FeatureIds(featureIds)
+  , m_NewIds(newIds)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const size_t totalFeatures = m_NewIds.size();
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      int32_t featureId = m_FeatureIds[i];
+      if(featureId >= 0 && static_cast<size_t>(featureId) < totalFeatures)
+      {
+        m_FeatureIds[i] = m_NewIds[featureId];
+      }
+    }
+  }
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  const std::vector<int32_t>& m_NewIds;
+};
+
+// -----------------------------------------------------------------------------
+// Kept tuples only ever move to a lower index so the array can be compacted front to back in place.
+template <typename T>
+bool CompactDataArray(const IDataArray::Pointer& iDataArray, const std::vector<int32_t>& newIds)
+{
+  typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T>>(iDataArray);
+  if(nullptr == array)
+  {
+    return false;
+  }
+  const size_t numComps = array->getNumberOfComponents();
+  T* data = array->getPointer(0);
+  for(size_t i = 1; i < newIds.size(); i++)
+  {
+    const size_t newId = static_cast<size_t>(newIds[i]);
+    if(newId != 0 && newId != i)
+    {
+      std::copy(data + i * numComps, data + (i + 1) * numComps, data + newId * numComps);
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureIdRemapper::FeatureIdRemapper(AbstractFilter* filter, AttributeMatrix::Pointer featureAttrMat, Int32ArrayType::Pointer featureIds)
+: m_Filter(filter)
+, m_FeatureAttrMat(featureAttrMat)
+, m_FeatureIds(featureIds)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureIdRemapper::~FeatureIdRemapper() = default;
+
+const QString FeatureIdRemapper::PendingRemovalsArrayName("PendingFeatureRemovals");
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureIdRemapper::DataCheckPendingRemovals(AbstractFilter* filter, const DataArrayPath& featureAttrMatPath, bool renumberFeatures)
+{
+  DataArrayPath pendingPath(featureAttrMatPath.getDataContainerName(), featureAttrMatPath.getAttributeMatrixName(), PendingRemovalsArrayName);
+  AttributeMatrix::Pointer featureAttrMat = filter->getDataContainerArray()->getAttributeMatrix(pendingPath);
+  if(nullptr == featureAttrMat)
+  {
+    return;
+  }
+  bool exists = featureAttrMat->doesAttributeArrayExist(PendingRemovalsArrayName);
+
+  if(renumberFeatures)
+  {
+    if(exists && filter->getInPreflight())
+    {
+      featureAttrMat->removeAttributeArray(PendingRemovalsArrayName);
+    }
+    return;
+  }
+
+  // A previous filter that also deferred its renumbering already created the array
+  std::vector<size_t> cDims(1, 1);
+  if(exists)
+  {
+    filter->getDataContainerArray()->getPrereqArrayFromPath<DataArray<bool>>(filter, pendingPath, cDims);
+  }
+  else
+  {
+    filter->getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>>(filter, pendingPath, false, cDims);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int32_t>& FeatureIdRemapper::getNewIds() const
+{
+  return m_NewIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FeatureIdRemapper::removeInactiveObjects(const QVector<bool>& activeObjects)
+{
+  const size_t totalFeatures = m_FeatureAttrMat->getNumberOfTuples();
+  if(static_cast<size_t>(activeObjects.size()) != totalFeatures || nullptr == m_FeatureIds)
+  {
+    return false;
+  }
+
+  // Features whose removal an earlier filter deferred are removed once no Cell references them
+  std::vector<uint8_t> removable(totalFeatures, 0);
+  BoolArrayType::Pointer pendingRemovals = m_FeatureAttrMat->getAttributeArrayAs<BoolArrayType>(PendingRemovalsArrayName);
+  if(nullptr != pendingRemovals)
+  {
+    std::vector<uint8_t> referenced = findReferencedFeatures(totalFeatures);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      removable[i] = (pendingRemovals->getValue(i) && referenced[i] == 0) ? 1 : 0;
+    }
+    m_FeatureAttrMat->removeAttributeArray(PendingRemovalsArrayName);
+  }
+
+  // Build the single old->new lookup table. Removed Features map to Feature 0.
+  m_NewIds.assign(totalFeatures, 0);
+  std::vector<size_t> removeList;
+  int32_t goodCount = 1;
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(activeObjects[static_cast<int>(i)] && removable[i] == 0)
+    {
+      m_NewIds[i] = goodCount;
+      goodCount++;
+    }
+    else
+    {
+      removeList.push_back(i);
+    }
+  }
+  if(removeList.empty())
+  {
+    return true;
+  }
+
+  m_Filter->notifyStatusMessage(QObject::tr("Renumbering Feature Ids: %1 Features removed").arg(removeList.size()));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, m_FeatureIds->getNumberOfTuples());
+  dataAlg.execute(RenumberFeatureIdsImpl(m_FeatureIds->getPointer(0), m_NewIds));
+
+  removeNeighborLists();
+  compactFeatureArrays(static_cast<size_t>(goodCount), removeList);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FeatureIdRemapper::deferInactiveObjects(const QVector<bool>& activeObjects)
+{
+  const size_t totalFeatures = m_FeatureAttrMat->getNumberOfTuples();
+  BoolArrayType::Pointer pendingRemovals = m_FeatureAttrMat->getAttributeArrayAs<BoolArrayType>(PendingRemovalsArrayName);
+  if(static_cast<size_t>(activeObjects.size()) != totalFeatures || nullptr == pendingRemovals)
+  {
+    return false;
+  }
+
+  bool anyRemoved = false;
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(!activeObjects[static_cast<int>(i)])
+    {
+      pendingRemovals->setValue(i, true);
+      anyRemoved = true;
+    }
+  }
+  if(anyRemoved)
+  {
+    removeNeighborLists();
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureIdRemapper::removeNeighborLists()
+{
+  QList<QString> arrayNames = m_FeatureAttrMat->getAttributeArrayNames();
+  for(const QString& arrayName : arrayNames)
+  {
+    if(m_FeatureAttrMat->getAttributeArray(arrayName)->getTypeAsString().compare("NeighborList<T>") == 0)
+    {
+      m_FeatureAttrMat->removeAttributeArray(arrayName);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<uint8_t> FeatureIdRemapper::findReferencedFeatures(size_t totalFeatures) const
+{
+  std::unique_ptr<std::atomic<uint8_t>[]> flags(new std::atomic<uint8_t>[totalFeatures]);
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    flags[i].store(0, std::memory_order_relaxed);
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, m_FeatureIds->getNumberOfTuples());
+  dataAlg.execute(FindReferencedFeaturesImpl(m_FeatureIds->getPointer(0), flags.get(), totalFeatures));
+
+  std::vector<uint8_t> referenced(totalFeatures, 0);
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    referenced[i] = flags[i].load(std::memory_order_relaxed);
+  }
+  return referenced;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureIdRemapper::compactFeatureArrays(size_t newNumFeatures, const std::vector<size_t>& removeList)
+{
+  QList<QString> arrayNames = m_FeatureAttrMat->getAttributeArrayNames();
+  for(const QString& arrayName : arrayNames)
+  {
+    IDataArray::Pointer iDataArray = m_FeatureAttrMat->getAttributeArray(arrayName);
+    bool compacted = CompactDataArray<int8_t>(iDataArray, m_NewIds) || CompactDataArray<uint8_t>(iDataArray, m_NewIds) || CompactDataArray<int16_t>(iDataArray, m_NewIds) ||
+                     CompactDataArray<uint16_t>(iDataArray, m_NewIds) || CompactDataArray<int32_t>(iDataArray, m_NewIds) || CompactDataArray<uint32_t>(iDataArray, m_NewIds) ||
+                     CompactDataArray<int64_t>(iDataArray, m_NewIds) || CompactDataArray<uint64_t>(iDataArray, m_NewIds) || CompactDataArray<float>(iDataArray, m_NewIds) ||
+                     CompactDataArray<double>(iDataArray, m_NewIds) || CompactDataArray<bool>(iDataArray, m_NewIds);
+    if(!compacted)
+    {
+      // Any other kind of array (strings, ...) falls back to the generic tuple erase
+      iDataArray->eraseTuples(removeList);
+    }
+  }
+
+  // Truncates every array to the number of kept Features
+  std::vector<size_t> tDims(1, newNumFeatures);
+  m_FeatureAttrMat->resizeAttributeArrays(tDims);
+}
@@ -0,0 +1,130 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The FeatureIdRemapper class removes inactive Features from a Feature Attribute Matrix
+ * and renumbers the Cell level Feature Ids to match. It is a drop in replacement for
+ * AttributeMatrix::removeInactiveObjects() that builds a single old->new id lookup table,
+ * renumbers the Feature Ids in parallel and compacts every Feature level array in place with
+ * one typed sweep per array. As with removeInactiveObjects(), NeighborLists are deleted once
+ * any Feature is removed because the ids they hold are no longer valid.
+ *
+ * A removal filter may also defer the renumbering. It then records its removed Features in the
+ * PendingRemovalsArrayName Feature array, and the next filter that does renumber removes those
+ * Features, provided no Cell references them any more, together with its own inactive Features.
+ */
+class FeatureIdRemapper
+{
+public:
+  FeatureIdRemapper(AbstractFilter* filter, AttributeMatrix::Pointer featureAttrMat, Int32ArrayType::Pointer featureIds);
+  virtual ~FeatureIdRemapper();
+
+  /**
+   * @brief Name of the Feature level bool array that holds the Features whose removal was deferred
+   */
+  static const QString PendingRemovalsArrayName;
+
+  /**
+   * @brief DataCheckPendingRemovals Creates the pending removals array when renumbering is deferred. When
+   * renumbering, the array is removed from the preflight structure since execute() consumes it.
+   * @param filter The calling filter
+   * @param featureAttrMatPath Path to the Feature Attribute Matrix
+   * @param renumberFeatures Whether the calling filter renumbers the Features
+   */
+  static void DataCheckPendingRemovals(AbstractFilter* filter, const DataArrayPath& featureAttrMatPath, bool renumberFeatures);
+
+  /**
+   * @brief removeInactiveObjects Removes every Feature whose activeObjects value is false, plus every
+   * Feature whose removal was deferred and that no Cell references, and renumbers the Feature Ids.
+   * Feature 0 is always kept. Cells that belonged to a removed Feature are assigned Feature 0.
+   * @param activeObjects One value per Feature in the Feature Attribute Matrix
+   * @return false if the activeObjects size does not match the Feature Attribute Matrix
+   */
+  bool removeInactiveObjects(const QVector<bool>& activeObjects);
+
+  /**
+   * @brief deferInactiveObjects Records every Feature whose activeObjects value is false in the pending
+   * removals array without renumbering. NeighborLists are deleted if any Feature is recorded.
+   * @param activeObjects One value per Feature in the Feature Attribute Matrix
+   * @return false if the activeObjects size does not match the Feature Attribute Matrix
+   */
+  bool deferInactiveObjects(const QVector<bool>& activeObjects);
+
+  /**
+   * @brief getNewIds Returns the old->new Feature Id lookup table built by the last call to removeInactiveObjects()
+   */
+  const std::vector<int32_t>& getNewIds() const;
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  AttributeMatrix::Pointer m_FeatureAttrMat;
+  Int32ArrayType::Pointer m_FeatureIds;
+  std::vector<int32_t> m_NewIds;
+
+  /**
+   * @brief findReferencedFeatures Flags each Feature that at least one Cell references
+   */
+  std::vector<uint8_t> findReferencedFeatures(size_t totalFeatures) const;
+
+  /**
+   * @brief removeNeighborLists Deletes every NeighborList from the Feature Attribute Matrix
+   */
+  void removeNeighborLists();
+
+  /**
+   * @brief compactFeatureArrays Moves the kept tuples of every Feature level array to their new index
+   */
+  void compactFeatureArrays(size_t newNumFeatures, const std::vector<size_t>& removeList);
+
+public:
+  FeatureIdRemapper(const FeatureIdRemapper&) = delete;            // Copy Constructor Not Implemented
+  FeatureIdRemapper(FeatureIdRemapper&&) = delete;                 // Move Constructor Not Implemented
+  FeatureIdRemapper& operator=(const FeatureIdRemapper&) = delete; // Copy Assignment Not Implemented
+  FeatureIdRemapper& operator=(FeatureIdRemapper&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,6 +35,10 @@
 
 #include "IdentifySample.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -47,6 +51,7 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
@@ -123,218 +128,463 @@ void IdentifySample::dataCheck()
   }
 }
 
-template <typename T>
-void _execute(IdentifySample* filter)
+namespace
 {
-  using ArrayType = DataArray<T>;
-  using ArrayPointerType = typename DataArray<T>::Pointer;
+/**
+ * @brief The SlabComponentLabeling class finds the 6-connected components of the voxels selected by a
+ * predicate. The volume is split into slabs of whole layers (planes, or rows when there is a single plane)
+ * that are labeled in parallel. Each slab is scanned with only two layers of labels and keeps one component
+ * id per provisional label plus the component ids of its first and last layer, which are all that is needed
+ * to merge the components across slab boundaries. The voxels are not labeled; visitSlab() scans a slab again
+ * and reproduces the same labels on the fly.
+ *
+ * Labels are numbered in scan order and always merge into the smaller label, so the root of a component is
+ * the component of its first voxel, which keeps the same tie breaking as a flood fill that visits the voxels
+ * in order.
+ */
+template <typename Predicate>
+class SlabComponentLabeling
+{
+public:
+  static constexpr uint32_t k_NotInComponent = std::numeric_limits<uint32_t>::max();
+  static constexpr int64_t k_MaxSlabs = 64;
+  // Every slab stores two layers of component ids, so slabs span at least this many layers to bound that storage
+  static constexpr int64_t k_MinLayersPerSlab = 8;
+
+  SlabComponentLabeling(const int64_t dims[3], const Predicate& inComponent)
+  : m_InComponent(inComponent)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_TotalPoints = dims[0] * dims[1] * dims[2];
+    // Volumes are split into whole planes so only the first plane of a slab has neighbors in another slab
+    m_LayerSize = m_Dims[2] > 1 ? m_Dims[0] * m_Dims[1] : m_Dims[0];
+    int64_t numLayers = m_TotalPoints > 0 ? m_TotalPoints / m_LayerSize : 0;
+    m_LayersPerSlab = std::max(k_MinLayersPerSlab, (numLayers + k_MaxSlabs - 1) / k_MaxSlabs);
+    m_NumSlabs = (numLayers + m_LayersPerSlab - 1) / m_LayersPerSlab;
+  }
 
-  DataContainerArray::Pointer dca = filter->getDataContainerArray();
-  DataContainer::Pointer m = dca->getDataContainer(filter->getGoodVoxelsArrayPath().getDataContainerName());
+  /**
+   * @brief Labels every slab, then merges the components across slab boundaries and sums the size of each component.
+   */
+  void execute()
+  {
+    m_Slabs.assign(static_cast<size_t>(m_NumSlabs), SlabComponents());
 
-  std::vector<size_t> cDims = {1};
-  ArrayPointerType m_GoodVoxelsPtr = dca->getPrereqArrayFromPath<ArrayType>(filter, filter->getGoodVoxelsArrayPath(), cDims);
-  T* m_GoodVoxels = m_GoodVoxelsPtr->getTuplePointer(0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, static_cast<size_t>(m_NumSlabs));
+    dataAlg.execute(LabelSlabsImpl(this));
 
-  int64_t totalPoints = static_cast<int64_t>(m_GoodVoxelsPtr->getNumberOfTuples());
+    mergeSlabs();
+  }
 
-  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  int64_t getSize(int64_t root) const
+  {
+    return m_Sizes[root];
+  }
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]),
-      static_cast<int64_t>(udims[1]),
-      static_cast<int64_t>(udims[2]),
+  bool getTouchesBoundary(int64_t root) const
+  {
+    return m_TouchesBoundary[root] != 0;
+  }
+
+  /**
+   * @brief Returns the root of the largest component, preferring the later component on ties, or -1 if no
+   * voxel is selected.
+   */
+  int64_t getLargestComponent() const
+  {
+    int64_t largest = -1;
+    for(size_t component = 0; component < m_Parents.size(); component++)
+    {
+      if(m_Parents[component] == static_cast<int64_t>(component) && (largest < 0 || m_Sizes[component] >= m_Sizes[largest]))
+      {
+        largest = static_cast<int64_t>(component);
+      }
+    }
+    return largest;
+  }
+
+  int64_t getNumberOfSlabs() const
+  {
+    return m_NumSlabs;
+  }
+
+  /**
+   * @brief Scans one slab again and calls visitor(index, root) for every selected voxel. The predicate is read
+   * once per voxel before the visitor is called, so the visitor may rewrite the voxel it is given.
+   */
+  template <typename Visitor>
+  void visitSlab(int64_t slab, Visitor visitor) const
+  {
+    const SlabComponents& slabComponents = m_Slabs[slab];
+    const int64_t base = m_SlabBase[slab];
+    uint32_t nextLabel = 0;
+    scanSlab(slab, [&](int64_t index, uint32_t neighborComponent) {
+      // A voxel without a labeled neighbor started a new provisional label during the first scan
+      uint32_t component = neighborComponent != k_NotInComponent ? neighborComponent : slabComponents.components[nextLabel++];
+      visitor(index, m_Parents[base + component]);
+      return component;
+    });
+  }
+
+  /**
+   * @brief Labels one slab using only the neighbors that lie inside the slab and resolves its provisional
+   * labels to components.
+   */
+  void labelSlab(int64_t slab)
+  {
+    SlabComponents& slabComponents = m_Slabs[slab];
+    std::vector<uint32_t> parents;
+    std::vector<int64_t> sizes;
+    std::vector<uint8_t> touchesBoundary;
+    const int64_t xp = m_Dims[0];
+    const int64_t yp = m_Dims[1];
+    const int64_t zp = m_Dims[2];
+
+    scanSlab(slab, [&](int64_t index, uint32_t label) {
+      if(label == k_NotInComponent)
+      {
+        label = static_cast<uint32_t>(parents.size());
+        parents.push_back(label);
+        sizes.push_back(0);
+        touchesBoundary.push_back(0);
+      }
+      sizes[label]++;
+      int64_t column = index % xp;
+      int64_t row = (index / xp) % yp;
+      int64_t plane = index / (xp * yp);
+      if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
+      {
+        touchesBoundary[label] = 1;
+      }
+      return label;
+    }, &parents, &slabComponents);
+
+    // Every link points to a smaller label, so a single forward pass resolves the labels to dense components
+    // that keep the order of their first voxel
+    std::vector<uint32_t>& components = slabComponents.components;
+    components.resize(parents.size());
+    for(size_t label = 0; label < parents.size(); label++)
+    {
+      if(parents[label] == label)
+      {
+        components[label] = static_cast<uint32_t>(slabComponents.sizes.size());
+        slabComponents.sizes.push_back(sizes[label]);
+        slabComponents.touchesBoundary.push_back(touchesBoundary[label]);
+      }
+      else
+      {
+        uint32_t component = components[parents[label]];
+        components[label] = component;
+        slabComponents.sizes[component] += sizes[label];
+        slabComponents.touchesBoundary[component] |= touchesBoundary[label];
+      }
+    }
+    for(uint32_t& label : slabComponents.firstLayer)
+    {
+      label = label == k_NotInComponent ? k_NotInComponent : components[label];
+    }
+    for(uint32_t& label : slabComponents.lastLayer)
+    {
+      label = label == k_NotInComponent ? k_NotInComponent : components[label];
+    }
+  }
+
+private:
+  /**
+   * @brief The components of one slab. Only the provisional label -> component table is kept once the slab
+   * boundaries are merged.
+   */
+  struct SlabComponents
+  {
+    std::vector<uint32_t> components;
+    std::vector<int64_t> sizes;
+    std::vector<uint8_t> touchesBoundary;
+    std::vector<uint32_t> firstLayer;
+    std::vector<uint32_t> lastLayer;
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64_t xp = dims[0];
-  int64_t yp = dims[1];
-  int64_t zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64_t> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64_t biggestBlock = 0;
-  size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  float threshold = 0.0f;
-  for(int64_t i = 0; i < totalPoints; i++)
+  class LabelSlabsImpl
   {
-    float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-    if(percentIncrement > threshold)
+  public:
+    LabelSlabsImpl(SlabComponentLabeling* labeling)
+    : m_Labeling(labeling)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
     {
-      QString ss = QObject::tr("%1% Scanned").arg(static_cast<int32_t>(percentIncrement));
-      filter->notifyStatusMessage(ss);
-      threshold = threshold + 5.0f;
-      if(threshold < percentIncrement)
+      for(size_t slab = range.min(); slab < range.max(); slab++)
       {
-        threshold = percentIncrement;
+        m_Labeling->labelSlab(static_cast<int64_t>(slab));
       }
     }
 
-    if(!checked[i] && m_GoodVoxels[i])
+  private:
+    SlabComponentLabeling* m_Labeling;
+  };
+
+  template <typename K>
+  static K FindRoot(std::vector<K>& parents, K label)
+  {
+    while(parents[label] != label)
+    {
+      parents[label] = parents[parents[label]];
+      label = parents[label];
+    }
+    return label;
+  }
+
+  /**
+   * @brief Scans the selected voxels of a slab in order with a rolling buffer of two layers of labels. For each
+   * voxel the label of its earlier neighbors inside the slab is passed to assign(index, label), or
+   * k_NotInComponent if none is selected, and assign returns the label to store for the voxel. When parents is
+   * given, neighbors with different labels are unioned into the smaller one and the first and last layer labels
+   * are copied into slabComponents.
+   */
+  template <typename Assign>
+  void scanSlab(int64_t slab, Assign assign, std::vector<uint32_t>* parents = nullptr, SlabComponents* slabComponents = nullptr) const
+  {
+    const int64_t xp = m_Dims[0];
+    const int64_t firstLayer = slab * m_LayersPerSlab;
+    const int64_t endLayer = std::min(m_TotalPoints / m_LayerSize, firstLayer + m_LayersPerSlab);
+    // The earlier neighbors in the same layer are the previous column and, for plane layers, the previous row
+    const bool rowInLayer = m_Dims[2] > 1;
+
+    std::vector<uint32_t> previous(static_cast<size_t>(m_LayerSize), k_NotInComponent);
+    std::vector<uint32_t> current(static_cast<size_t>(m_LayerSize), k_NotInComponent);
+    for(int64_t layer = firstLayer; layer < endLayer; layer++)
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
+      const bool hasPreviousLayer = layer > firstLayer;
+      const int64_t layerStart = layer * m_LayerSize;
+      for(int64_t offset = 0; offset < m_LayerSize; offset++)
       {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32_t j = 0; j < 6; j++)
+        const int64_t index = layerStart + offset;
+        if(!m_InComponent(index))
         {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
+          current[offset] = k_NotInComponent;
+          continue;
+        }
+        const uint32_t neighborLabels[3] = {offset % xp > 0 ? current[offset - 1] : k_NotInComponent, rowInLayer && offset >= xp ? current[offset - xp] : k_NotInComponent,
+                                            hasPreviousLayer ? previous[offset] : k_NotInComponent};
+        uint32_t label = k_NotInComponent;
+        for(uint32_t neighborLabel : neighborLabels)
+        {
+          if(neighborLabel == k_NotInComponent)
           {
-            good = 0;
+            continue;
           }
-          if(j == 2 && column == 0)
+          if(nullptr == parents)
           {
-            good = 0;
+            // Every earlier neighbor already holds the final component of the voxel
+            label = neighborLabel;
+            break;
           }
-          if(j == 3 && column == (xp - 1))
+          uint32_t neighborRoot = FindRoot(*parents, neighborLabel);
+          if(label == k_NotInComponent)
           {
-            good = 0;
+            label = neighborRoot;
           }
-          if(good == 1 && !checked[neighbor] && m_GoodVoxels[neighbor])
+          else if(neighborRoot != label)
           {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
+            uint32_t low = std::min(label, neighborRoot);
+            (*parents)[std::max(label, neighborRoot)] = low;
+            label = low;
           }
         }
-        count++;
+        current[offset] = assign(index, label);
       }
-      if(static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
+      if(nullptr != slabComponents && layer == firstLayer)
       {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64_t j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
+        slabComponents->firstLayer = current;
       }
-      currentvlist.clear();
+      std::swap(previous, current);
     }
-  }
-  for(int64_t i = 0; i < totalPoints; i++)
-  {
-    if(!sample[i] && m_GoodVoxels[i])
+    if(nullptr != slabComponents && endLayer > firstLayer)
     {
-      m_GoodVoxels[i] = false;
+      slabComponents->lastLayer = std::move(previous);
     }
   }
-  sample.clear();
-  checked.assign(totalPoints, false);
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
-  // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
-  threshold = 0.0F;
-  if(filter->getFillHoles())
+  /**
+   * @brief Numbers the components of all slabs one after the other, unions the components that touch across
+   * slab boundaries and resolves every component to its root. Every link points to a smaller component, so a
+   * single forward pass resolves them.
+   */
+  void mergeSlabs()
   {
-    bool touchesBoundary = false;
-    for(int64_t i = 0; i < totalPoints; i++)
+    m_SlabBase.assign(static_cast<size_t>(m_NumSlabs) + 1, 0);
+    for(int64_t slab = 0; slab < m_NumSlabs; slab++)
     {
-      float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-      if(percentIncrement > threshold)
+      m_SlabBase[slab + 1] = m_SlabBase[slab] + static_cast<int64_t>(m_Slabs[slab].sizes.size());
+    }
+    m_Parents.resize(static_cast<size_t>(m_SlabBase[m_NumSlabs]));
+    m_Sizes.resize(m_Parents.size());
+    m_TouchesBoundary.resize(m_Parents.size());
+    for(int64_t slab = 0; slab < m_NumSlabs; slab++)
+    {
+      SlabComponents& slabComponents = m_Slabs[slab];
+      int64_t base = m_SlabBase[slab];
+      for(size_t component = 0; component < slabComponents.sizes.size(); component++)
       {
-        QString ss = QObject::tr("%1% Filling Holes").arg(static_cast<int32_t>(percentIncrement));
-        filter->notifyStatusMessage(ss);
-        threshold = threshold + 5.0f;
-        if(threshold < percentIncrement)
+        m_Parents[base + component] = base + static_cast<int64_t>(component);
+        m_Sizes[base + component] = slabComponents.sizes[component];
+        m_TouchesBoundary[base + component] = slabComponents.touchesBoundary[component];
+      }
+      slabComponents.sizes = std::vector<int64_t>();
+      slabComponents.touchesBoundary = std::vector<uint8_t>();
+    }
+
+    // The first layer of a slab only touches the last layer of the previous slab, at the same offset
+    for(int64_t slab = 1; slab < m_NumSlabs; slab++)
+    {
+      const std::vector<uint32_t>& lastLayer = m_Slabs[slab - 1].lastLayer;
+      const std::vector<uint32_t>& firstLayer = m_Slabs[slab].firstLayer;
+      for(size_t offset = 0; offset < firstLayer.size(); offset++)
+      {
+        if(firstLayer[offset] == k_NotInComponent || lastLayer[offset] == k_NotInComponent)
+        {
+          continue;
+        }
+        int64_t root1 = FindRoot(m_Parents, m_SlabBase[slab] + firstLayer[offset]);
+        int64_t root2 = FindRoot(m_Parents, m_SlabBase[slab - 1] + lastLayer[offset]);
+        if(root1 != root2)
         {
-          threshold = percentIncrement;
+          m_Parents[std::max(root1, root2)] = std::min(root1, root2);
         }
       }
+    }
+    for(SlabComponents& slabComponents : m_Slabs)
+    {
+      slabComponents.firstLayer = std::vector<uint32_t>();
+      slabComponents.lastLayer = std::vector<uint32_t>();
+    }
 
-      if(!checked[i] && !m_GoodVoxels[i])
+    for(size_t component = 0; component < m_Parents.size(); component++)
+    {
+      int64_t parent = m_Parents[m_Parents[component]];
+      m_Parents[component] = parent;
+      if(parent != static_cast<int64_t>(component))
       {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
+        m_Sizes[parent] += m_Sizes[component];
+        m_TouchesBoundary[parent] |= m_TouchesBoundary[component];
+      }
+    }
+  }
+
+  Predicate m_InComponent;
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_TotalPoints = 0;
+  int64_t m_LayerSize = 1;
+  int64_t m_LayersPerSlab = 1;
+  int64_t m_NumSlabs = 0;
+  std::vector<SlabComponents> m_Slabs;
+  std::vector<int64_t> m_SlabBase;
+  std::vector<int64_t> m_Parents;
+  std::vector<int64_t> m_Sizes;
+  std::vector<uint8_t> m_TouchesBoundary;
+};
+
+/**
+ * @brief The UpdateMaskImpl class rewrites the mask of the voxels of each slab from the component that holds them.
+ * Voxels outside the largest good component become bad, or bad components that do not reach the boundary become good.
+ */
+template <typename T, typename LabelingType>
+class UpdateMaskImpl
+{
+public:
+  UpdateMaskImpl(T* goodVoxels, const LabelingType& labeling, int64_t largestComponent, bool fillHoles)
+  : m_GoodVoxels(goodVoxels)
+  , m_Labeling(labeling)
+  , m_LargestComponent(largestComponent)
+  , m_FillHoles(fillHoles)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      m_Labeling.visitSlab(static_cast<int64_t>(slab), [this](int64_t index, int64_t root) {
+        if(m_FillHoles)
         {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
+          if(!m_Labeling.getTouchesBoundary(root))
           {
-            touchesBoundary = true;
+            m_GoodVoxels[index] = true;
           }
-          for(int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !checked[neighbor] && !m_GoodVoxels[neighbor])
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
         }
-        if(!touchesBoundary)
+        else if(root != m_LargestComponent)
         {
-          for(size_t j = 0; j < currentvlist.size(); j++)
-          {
-            m_GoodVoxels[currentvlist[j]] = true;
-          }
+          m_GoodVoxels[index] = false;
         }
-        currentvlist.clear();
-      }
+      });
     }
   }
-  checked.clear();
+
+private:
+  T* m_GoodVoxels;
+  const LabelingType& m_Labeling;
+  int64_t m_LargestComponent;
+  bool m_FillHoles;
+};
+} // namespace
+
+template <typename T>
+void _execute(IdentifySample* filter)
+{
+  using ArrayType = DataArray<T>;
+  using ArrayPointerType = typename DataArray<T>::Pointer;
+
+  DataContainerArray::Pointer dca = filter->getDataContainerArray();
+  DataContainer::Pointer m = dca->getDataContainer(filter->getGoodVoxelsArrayPath().getDataContainerName());
+
+  std::vector<size_t> cDims = {1};
+  ArrayPointerType m_GoodVoxelsPtr = dca->getPrereqArrayFromPath<ArrayType>(filter, filter->getGoodVoxelsArrayPath(), cDims);
+  T* m_GoodVoxels = m_GoodVoxelsPtr->getTuplePointer(0);
+
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
+
+  // In this pass over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'
+  filter->notifyStatusMessage(QObject::tr("Finding the Largest Feature"));
+  {
+    auto isGood = [m_GoodVoxels](int64_t index) { return static_cast<bool>(m_GoodVoxels[index]); };
+    SlabComponentLabeling<decltype(isGood)> labeling(dims, isGood);
+    labeling.execute();
+    int64_t largestComponent = labeling.getLargestComponent();
+    if(largestComponent >= 0)
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0ULL, static_cast<size_t>(labeling.getNumberOfSlabs()));
+      dataAlg.execute(UpdateMaskImpl<T, decltype(labeling)>(m_GoodVoxels, labeling, largestComponent, false));
+    }
+  }
+
+  if(filter->getCancel())
+  {
+    return;
+  }
+
+  // In this pass we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
+  if(filter->getFillHoles())
+  {
+    filter->notifyStatusMessage(QObject::tr("Filling Holes"));
+    auto isBad = [m_GoodVoxels](int64_t index) { return !static_cast<bool>(m_GoodVoxels[index]); };
+    SlabComponentLabeling<decltype(isBad)> labeling(dims, isBad);
+    labeling.execute();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, static_cast<size_t>(labeling.getNumberOfSlabs()));
+    dataAlg.execute(UpdateMaskImpl<T, decltype(labeling)>(m_GoodVoxels, labeling, -1, true));
+  }
 }
 
 // -----------------------------------------------------------------------------
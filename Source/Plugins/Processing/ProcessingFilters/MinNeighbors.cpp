@@ -40,6 +40,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -49,6 +50,7 @@
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
+#include "ProcessingFilters/HelperClasses/FeatureIdRemapper.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -72,6 +74,7 @@ void MinNeighbors::setupFilterParameters()
   linkedProps.push_back("FeaturePhasesArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Apply to Single Phase Only", ApplyToSinglePhase, FilterParameter::Category::Parameter, MinNeighbors, linkedProps));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Phase Index", PhaseNumber, FilterParameter::Category::Parameter, MinNeighbors));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Renumber Features", RenumberFeatures, FilterParameter::Category::Parameter, MinNeighbors));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -176,6 +179,8 @@ void MinNeighbors::dataCheck()
   }
 
   setWarningCondition(-5556, ss);
+
+  FeatureIdRemapper::DataCheckPendingRemovals(this, getNumNeighborsArrayPath(), getRenumberFeatures());
 }
 
 // -----------------------------------------------------------------------------
@@ -225,7 +230,15 @@ void MinNeighbors::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_NumNeighborsArrayPath.getDataContainerName());
   AttributeMatrix::Pointer cellFeatureAttrMat = m->getAttributeMatrix(m_NumNeighborsArrayPath.getAttributeMatrixName());
-  cellFeatureAttrMat->removeInactiveObjects(activeObjects, m_FeatureIdsPtr.lock().get());
+  FeatureIdRemapper remapper(this, cellFeatureAttrMat, m_FeatureIdsPtr.lock());
+  if(m_RenumberFeatures)
+  {
+    remapper.removeInactiveObjects(activeObjects);
+  }
+  else
+  {
+    remapper.deferInactiveObjects(activeObjects);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -573,6 +586,18 @@ bool MinNeighbors::getApplyToSinglePhase() const
   return m_ApplyToSinglePhase;
 }
 
+// -----------------------------------------------------------------------------
+void MinNeighbors::setRenumberFeatures(bool value)
+{
+  m_RenumberFeatures = value;
+}
+
+// -----------------------------------------------------------------------------
+bool MinNeighbors::getRenumberFeatures() const
+{
+  return m_RenumberFeatures;
+}
+
 // -----------------------------------------------------------------------------
 void MinNeighbors::setPhaseNumber(int value)
 {
@@ -60,6 +60,7 @@ class Processing_EXPORT MinNeighbors : public AbstractFilter
   PYB11_FILTER_NEW_MACRO(MinNeighbors)
   PYB11_PROPERTY(int MinNumNeighbors READ getMinNumNeighbors WRITE setMinNumNeighbors)
   PYB11_PROPERTY(bool ApplyToSinglePhase READ getApplyToSinglePhase WRITE setApplyToSinglePhase)
+  PYB11_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
   PYB11_PROPERTY(int PhaseNumber READ getPhaseNumber WRITE setPhaseNumber)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath FeaturePhasesArrayPath READ getFeaturePhasesArrayPath WRITE setFeaturePhasesArrayPath)
@@ -119,6 +120,17 @@ public:
   bool getApplyToSinglePhase() const;
   Q_PROPERTY(bool ApplyToSinglePhase READ getApplyToSinglePhase WRITE setApplyToSinglePhase)
 
+  /**
+   * @brief Setter property for RenumberFeatures
+   */
+  void setRenumberFeatures(bool value);
+  /**
+   * @brief Getter property for RenumberFeatures
+   * @return Value of RenumberFeatures
+   */
+  bool getRenumberFeatures() const;
+  Q_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
+
   /**
    * @brief Setter property for PhaseNumber
    */
@@ -265,6 +277,7 @@ private:
 
   int m_MinNumNeighbors = {1};
   bool m_ApplyToSinglePhase = {false};
+  bool m_RenumberFeatures = {true};
   int m_PhaseNumber = {0};
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   DataArrayPath m_FeaturePhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases};
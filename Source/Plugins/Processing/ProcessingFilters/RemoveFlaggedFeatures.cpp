@@ -48,6 +48,7 @@
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
+#include "ProcessingFilters/HelperClasses/FeatureIdRemapper.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -66,6 +67,7 @@ void RemoveFlaggedFeatures::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Fill-in Removed Features", FillRemovedFeatures, FilterParameter::Category::Parameter, RemoveFlaggedFeatures));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Renumber Features", RenumberFeatures, FilterParameter::Category::Parameter, RemoveFlaggedFeatures));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -115,6 +117,8 @@ void RemoveFlaggedFeatures::dataCheck()
   {
     m_FlaggedFeatures = m_FlaggedFeaturesPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  FeatureIdRemapper::DataCheckPendingRemovals(this, getFlaggedFeaturesArrayPath(), getRenumberFeatures());
 }
 
 // -----------------------------------------------------------------------------
@@ -136,7 +140,15 @@ void RemoveFlaggedFeatures::execute()
   }
 
   AttributeMatrix::Pointer cellFeatureAttrMat = getDataContainerArray()->getAttributeMatrix(getFlaggedFeaturesArrayPath());
-  cellFeatureAttrMat->removeInactiveObjects(activeObjects, m_FeatureIdsPtr.lock().get());
+  FeatureIdRemapper remapper(this, cellFeatureAttrMat, m_FeatureIdsPtr.lock());
+  if(m_RenumberFeatures)
+  {
+    remapper.removeInactiveObjects(activeObjects);
+  }
+  else
+  {
+    remapper.deferInactiveObjects(activeObjects);
+  }
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage("Remove Flagged Features Filter Complete");
@@ -467,6 +479,18 @@ bool RemoveFlaggedFeatures::getFillRemovedFeatures() const
   return m_FillRemovedFeatures;
 }
 
+// -----------------------------------------------------------------------------
+void RemoveFlaggedFeatures::setRenumberFeatures(bool value)
+{
+  m_RenumberFeatures = value;
+}
+
+// -----------------------------------------------------------------------------
+bool RemoveFlaggedFeatures::getRenumberFeatures() const
+{
+  return m_RenumberFeatures;
+}
+
 // -----------------------------------------------------------------------------
 void RemoveFlaggedFeatures::setFeatureIdsArrayPath(const DataArrayPath& value)
 {
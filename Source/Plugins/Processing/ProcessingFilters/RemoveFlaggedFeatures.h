@@ -56,6 +56,7 @@ class Processing_EXPORT RemoveFlaggedFeatures : public AbstractFilter
   PYB11_SHARED_POINTERS(RemoveFlaggedFeatures)
   PYB11_FILTER_NEW_MACRO(RemoveFlaggedFeatures)
   PYB11_PROPERTY(bool FillRemovedFeatures READ getFillRemovedFeatures WRITE setFillRemovedFeatures)
+  PYB11_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath FlaggedFeaturesArrayPath READ getFlaggedFeaturesArrayPath WRITE setFlaggedFeaturesArrayPath)
   PYB11_END_BINDINGS()
@@ -102,6 +103,17 @@ public:
   bool getFillRemovedFeatures() const;
   Q_PROPERTY(bool FillRemovedFeatures READ getFillRemovedFeatures WRITE setFillRemovedFeatures)
 
+  /**
+   * @brief Setter property for RenumberFeatures
+   */
+  void setRenumberFeatures(bool value);
+  /**
+   * @brief Getter property for RenumberFeatures
+   * @return Value of RenumberFeatures
+   */
+  bool getRenumberFeatures() const;
+  Q_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
+
   /**
    * @brief Setter property for FeatureIdsArrayPath
    */
@@ -222,6 +234,7 @@ private:
   bool* m_FlaggedFeatures = nullptr;
 
   bool m_FillRemovedFeatures = {true};
+  bool m_RenumberFeatures = {true};
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   DataArrayPath m_FlaggedFeaturesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Active};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
@@ -33,6 +33,10 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 
@@ -42,11 +46,14 @@
 #include "SIMPLib/Common/Observer.h"
 #include "SIMPLib/CoreFilters/DataContainerWriter.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "UnitTestSupport.hpp"
@@ -55,6 +62,12 @@
 
 class DetectEllipsoidsTest
 {
+  const QString k_DataContainerName = {"ImageDataContainer"};
+  const QString k_EllipseFeatureDataName = {"EllipsoidFeatureData"};
+  const QString k_CenterCoordsName = {"EllipsoidsCenterCoords"};
+  const QString k_MajorAxisLengthName = {"EllipsoidsMajorAxisLength"};
+  const QString k_MinorAxisLengthName = {"EllipsoidsMinorAxisLength"};
+  const QString k_RotationalAnglesName = {"EllipsoidsRotationalAngles"};
 
 public:
   DetectEllipsoidsTest() = default;
@@ -217,6 +230,104 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  // Runs the test pipeline up to and including the Detect Ellipsoids filter and returns the resulting data
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runDetectEllipsoids(bool useFFTConvolution)
+  {
+    JsonFilterParametersReader::Pointer reader = JsonFilterParametersReader::New();
+    FilterPipeline::Pointer pipeline = reader->readPipelineFromFile(UnitTest::DetectEllipsoidsTest::TestPipelinePath);
+    DREAM3D_REQUIRE_VALID_POINTER(pipeline.get());
+
+    FilterPipeline::FilterContainerType container = pipeline->getFilterContainer();
+    DREAM3D_REQUIRE_EQUAL(container.size(), 8);
+
+    QVariant var;
+    var.setValue(UnitTest::DetectEllipsoidsTest::InputSegmentationPath);
+    bool propWasSet = container[0]->setProperty("FileName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    AbstractFilter::Pointer detectEllipsoidsFilter = container[container.size() - 3];
+    var.setValue(useFFTConvolution);
+    propWasSet = detectEllipsoidsFilter->setProperty("UseFFTConvolution", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    // Drop the two writers, only the detected ellipses are compared
+    pipeline->popBack();
+    pipeline->popBack();
+
+    pipeline->preflightPipeline();
+    DREAM3D_REQUIRE_EQUAL(pipeline->getErrorCode(), 0);
+
+    DataContainerArray::Pointer dca = pipeline->execute();
+    DREAM3D_REQUIRE_EQUAL(pipeline->getErrorCode(), 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the center x, center y, major axis, minor axis and rotational angle of every detected ellipse
+  // -----------------------------------------------------------------------------
+  std::vector<std::array<double, 5>> getEllipses(const DataContainerArray::Pointer& dca)
+  {
+    AttributeMatrix::Pointer ellipseAM = dca->getAttributeMatrix({k_DataContainerName, k_EllipseFeatureDataName, ""});
+    DREAM3D_REQUIRE_VALID_POINTER(ellipseAM.get());
+    DoubleArrayType::Pointer centers = ellipseAM->getAttributeArrayAs<DoubleArrayType>(k_CenterCoordsName);
+    DoubleArrayType::Pointer majorAxes = ellipseAM->getAttributeArrayAs<DoubleArrayType>(k_MajorAxisLengthName);
+    DoubleArrayType::Pointer minorAxes = ellipseAM->getAttributeArrayAs<DoubleArrayType>(k_MinorAxisLengthName);
+    DoubleArrayType::Pointer angles = ellipseAM->getAttributeArrayAs<DoubleArrayType>(k_RotationalAnglesName);
+    DREAM3D_REQUIRE_VALID_POINTER(centers.get());
+    DREAM3D_REQUIRE_VALID_POINTER(majorAxes.get());
+    DREAM3D_REQUIRE_VALID_POINTER(minorAxes.get());
+    DREAM3D_REQUIRE_VALID_POINTER(angles.get());
+
+    std::vector<std::array<double, 5>> ellipses;
+    for(size_t i = 1; i < ellipseAM->getNumberOfTuples(); i++)
+    {
+      std::array<double, 5> ellipse = {centers->getComponent(i, 0), centers->getComponent(i, 1), majorAxes->getValue(i), minorAxes->getValue(i), angles->getValue(i)};
+      if(std::none_of(ellipse.begin(), ellipse.end(), [](double value) { return std::isnan(value); }))
+      {
+        ellipses.push_back(ellipse);
+      }
+    }
+    return ellipses;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The FFT convolution only differs from the direct sums by round off, so both paths must find the same
+  // ellipses. Additional ellipses found in one object get their ids in thread order, so the ellipses are
+  // matched by their parameters instead of their ids.
+  // -----------------------------------------------------------------------------
+  int TestFFTConvolution()
+  {
+    std::vector<std::array<double, 5>> directEllipses = getEllipses(runDetectEllipsoids(false));
+    std::vector<std::array<double, 5>> fftEllipses = getEllipses(runDetectEllipsoids(true));
+    DREAM3D_REQUIRED(directEllipses.size(), >, 0);
+    DREAM3D_REQUIRE_EQUAL(directEllipses.size(), fftEllipses.size());
+
+    const double pixelTolerance = 1.0;
+    const double angleTolerance = 0.05;
+    std::vector<bool> matched(fftEllipses.size(), false);
+    for(const auto& direct : directEllipses)
+    {
+      bool found = false;
+      for(size_t i = 0; i < fftEllipses.size() && !found; i++)
+      {
+        const auto& fft = fftEllipses[i];
+        double angleDiff = std::fabs(direct[4] - fft[4]);
+        angleDiff = std::min(angleDiff, SIMPLib::Constants::k_PiD - angleDiff);
+        if(!matched[i] && std::fabs(direct[0] - fft[0]) <= pixelTolerance && std::fabs(direct[1] - fft[1]) <= pixelTolerance && std::fabs(direct[2] - fft[2]) <= pixelTolerance &&
+           std::fabs(direct[3] - fft[3]) <= pixelTolerance && angleDiff <= angleTolerance)
+        {
+          matched[i] = true;
+          found = true;
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(found, true);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -230,6 +341,8 @@ public:
 
     DREAM3D_REGISTER_TEST(TestDetectEllipsoids());
 
+    DREAM3D_REGISTER_TEST(TestFFTConvolution());
+
     if(testOutFile.isOpen())
     {
       testOutFile.close();
@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/IdentifySample.h"
+#include "ProcessingTestFileLocations.h"
+
+class IdentifySampleTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_MaskName = {"Mask"};
+
+public:
+  IdentifySampleTest() = default;
+  ~IdentifySampleTest() = default;
+
+  IdentifySampleTest(const IdentifySampleTest&) = delete;            // Copy Constructor
+  IdentifySampleTest(IdentifySampleTest&&) = delete;                 // Move Constructor
+  IdentifySampleTest& operator=(const IdentifySampleTest&) = delete; // Copy Assignment
+  IdentifySampleTest& operator=(IdentifySampleTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  DataContainerArray::Pointer createDataStructure(const std::vector<size_t>& dims, const std::vector<T>& mask)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    typename DataArray<T>::Pointer maskArray = DataArray<T>::CreateArray(dims, {1ULL}, k_MaskName, true);
+    for(size_t i = 0; i < mask.size(); i++)
+    {
+      maskArray->setValue(i, mask[i]);
+    }
+    cellAM->insertOrAssign(maskArray);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  int runFilter(const std::vector<size_t>& dims, const std::vector<T>& mask, bool fillHoles, std::vector<T>& result)
+  {
+    IdentifySample::Pointer filter = IdentifySample::New();
+    filter->setDataContainerArray(createDataStructure<T>(dims, mask));
+    filter->setGoodVoxelsArrayPath({k_DataContainerName, k_CellDataName, k_MaskName});
+    filter->setFillHoles(fillHoles);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    DataContainerArray::Pointer dca = createDataStructure<T>(dims, mask);
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    typename DataArray<T>::Pointer maskArray = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<DataArray<T>>(k_MaskName);
+    DREAM3D_REQUIRE_VALID_POINTER(maskArray.get());
+    result.assign(maskArray->begin(), maskArray->end());
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // 6x6x6 mask with three separate good regions: a 4x4x4 block at [1,4] with a 2x2x2 hole at [2,3], a single
+  // voxel in a corner and a pair of voxels in the opposite corner.
+  // -----------------------------------------------------------------------------
+  int TestVolume()
+  {
+    const size_t size = 6;
+    std::vector<size_t> dims = {size, size, size};
+    auto inRange = [](size_t x, size_t y, size_t z, size_t low, size_t high) { return x >= low && x <= high && y >= low && y <= high && z >= low && z <= high; };
+    auto isBlock = [&](size_t x, size_t y, size_t z) { return inRange(x, y, z, 1, 4) && !inRange(x, y, z, 2, 3); };
+    auto isHole = [&](size_t x, size_t y, size_t z) { return inRange(x, y, z, 2, 3); };
+
+    std::vector<bool> mask(size * size * size, false);
+    for(size_t z = 0; z < size; z++)
+    {
+      for(size_t y = 0; y < size; y++)
+      {
+        for(size_t x = 0; x < size; x++)
+        {
+          mask[(z * size + y) * size + x] = isBlock(x, y, z);
+        }
+      }
+    }
+    mask[0] = true;
+    mask[(5 * size + 5) * size + 5] = true;
+    mask[(4 * size + 5) * size + 5] = true;
+
+    // Only the largest region is kept and its hole is left alone
+    std::vector<bool> result;
+    DREAM3D_REQUIRE_EQUAL(runFilter<bool>(dims, mask, false, result), EXIT_SUCCESS);
+    for(size_t z = 0; z < size; z++)
+    {
+      for(size_t y = 0; y < size; y++)
+      {
+        for(size_t x = 0; x < size; x++)
+        {
+          DREAM3D_REQUIRE_EQUAL(static_cast<bool>(result[(z * size + y) * size + x]), isBlock(x, y, z));
+        }
+      }
+    }
+
+    // The enclosed hole is filled, while the bad voxels connected to the border, including the removed regions, stay bad
+    DREAM3D_REQUIRE_EQUAL(runFilter<bool>(dims, mask, true, result), EXIT_SUCCESS);
+    for(size_t z = 0; z < size; z++)
+    {
+      for(size_t y = 0; y < size; y++)
+      {
+        for(size_t x = 0; x < size; x++)
+        {
+          DREAM3D_REQUIRE_EQUAL(static_cast<bool>(result[(z * size + y) * size + x]), isBlock(x, y, z) || isHole(x, y, z));
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A single slice with enough rows to be split into several slabs. Two regions of the same size run down the
+  // left and right columns; the later one in scan order must be kept, as the serial flood fill did. A third,
+  // smaller region spans the middle rows.
+  // -----------------------------------------------------------------------------
+  int TestSingleSlice()
+  {
+    const size_t xSize = 7;
+    const size_t ySize = 40;
+    std::vector<size_t> dims = {xSize, ySize, 1};
+
+    std::vector<uint8_t> mask(xSize * ySize, 0);
+    for(size_t y = 0; y < ySize; y++)
+    {
+      mask[y * xSize] = 1;
+      mask[y * xSize + xSize - 1] = 1;
+    }
+    for(size_t y = 10; y < 20; y++)
+    {
+      mask[y * xSize + 3] = 1;
+    }
+
+    std::vector<uint8_t> result;
+    DREAM3D_REQUIRE_EQUAL(runFilter<uint8_t>(dims, mask, false, result), EXIT_SUCCESS);
+    for(size_t y = 0; y < ySize; y++)
+    {
+      for(size_t x = 0; x < xSize; x++)
+      {
+        DREAM3D_REQUIRE_EQUAL(static_cast<int>(result[y * xSize + x]), (x == xSize - 1 ? 1 : 0));
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestVolume())
+    DREAM3D_REGISTER_TEST(TestSingleSlice())
+  }
+
+private:
+};
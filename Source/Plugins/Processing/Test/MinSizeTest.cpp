@@ -0,0 +1,227 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/HelperClasses/FeatureIdRemapper.h"
+#include "Processing/ProcessingFilters/MinSize.h"
+#include "Processing/ProcessingFilters/RemoveFlaggedFeatures.h"
+#include "ProcessingTestFileLocations.h"
+
+class MinSizeTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_FeatureDataName = {"FeatureData"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_NumCellsName = {"NumCells"};
+  const QString k_FlaggedName = {"Flagged"};
+  const QString k_ValuesName = {"Values"};
+  const QString k_NeighborListName = {"NeighborList"};
+
+public:
+  MinSizeTest() = default;
+  ~MinSizeTest() = default;
+
+  MinSizeTest(const MinSizeTest&) = delete;            // Copy Constructor
+  MinSizeTest(MinSizeTest&&) = delete;                 // Move Constructor
+  MinSizeTest& operator=(const MinSizeTest&) = delete; // Copy Assignment
+  MinSizeTest& operator=(MinSizeTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // 4x4x1 image: Feature 1 owns columns 0-1 (8 Cells), Feature 2 owns columns 2-3 except the last Cell
+  // (7 Cells), which belongs to Feature 3 (1 Cell). Feature 4 owns no Cells.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {4, 4, 1};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims, {1ULL}, k_FeatureIdsName, true);
+    for(size_t y = 0; y < 4; y++)
+    {
+      for(size_t x = 0; x < 4; x++)
+      {
+        featureIds->setValue(y * 4 + x, x < 2 ? 1 : 2);
+      }
+    }
+    featureIds->setValue(15, 3);
+    cellAM->insertOrAssign(featureIds);
+
+    const size_t numFeatures = 5;
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({numFeatures}, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    Int32ArrayType::Pointer numCells = Int32ArrayType::CreateArray(numFeatures, std::string(k_NumCellsName.toStdString()), true);
+    const int32_t numCellsValues[numFeatures] = {0, 8, 7, 1, 0};
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      numCells->setValue(i, numCellsValues[i]);
+    }
+    featureAM->insertOrAssign(numCells);
+
+    BoolArrayType::Pointer flagged = BoolArrayType::CreateArray(numFeatures, std::string(k_FlaggedName.toStdString()), true);
+    flagged->initializeWithValue(false);
+    flagged->setValue(3, true);
+    featureAM->insertOrAssign(flagged);
+
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(numFeatures, std::string(k_ValuesName.toStdString()), true);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      values->setValue(i, 10.0F * static_cast<float>(i));
+    }
+    featureAM->insertOrAssign(values);
+
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, k_NeighborListName, true);
+    neighborList->setList(1, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({2})));
+    neighborList->setList(2, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({1, 3})));
+    neighborList->setList(3, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({2})));
+    featureAM->insertOrAssign(neighborList);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  MinSize::Pointer createFilter(const DataContainerArray::Pointer& dca, int minAllowedFeatureSize, bool renumberFeatures)
+  {
+    MinSize::Pointer filter = MinSize::New();
+    filter->setDataContainerArray(dca);
+    filter->setFeatureIdsArrayPath({k_DataContainerName, k_CellDataName, k_FeatureIdsName});
+    filter->setNumCellsArrayPath({k_DataContainerName, k_FeatureDataName, k_NumCellsName});
+    filter->setMinAllowedFeatureSize(minAllowedFeatureSize);
+    filter->setApplyToSinglePhase(false);
+    filter->setRenumberFeatures(renumberFeatures);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every Cell keeps its Feature except the Cell of Feature 3, which is filled by Feature 2
+  // -----------------------------------------------------------------------------
+  int checkFilledFeatureIds(const DataContainerArray::Pointer& dca)
+  {
+    Int32ArrayType::Pointer featureIds = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), (i % 4) < 2 ? 1 : 2);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRemoveAndRenumber()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    MinSize::Pointer filter = createFilter(dca, 2, true);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    // The NeighborList will be removed, which preflight reports as a warning
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), -5556);
+
+    dca = createDataStructure();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // Features 3 and 4 are smaller than the minimum size
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), 3);
+    FloatArrayType::Pointer values = featureAM->getAttributeArrayAs<FloatArrayType>(k_ValuesName);
+    DREAM3D_REQUIRE_VALID_POINTER(values.get());
+    DREAM3D_REQUIRE_EQUAL(values->getValue(0), 0.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(1), 10.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(2), 20.0F);
+
+    // The NeighborList holds ids of the old numbering and must be deleted
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(k_NeighborListName), false);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), false);
+
+    return checkFilledFeatureIds(dca);
+  }
+
+  // -----------------------------------------------------------------------------
+  // RemoveFlaggedFeatures defers its renumbering, and MinSize removes the pending Feature along with its own
+  // -----------------------------------------------------------------------------
+  int TestDeferredRenumber()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    RemoveFlaggedFeatures::Pointer removeFlagged = RemoveFlaggedFeatures::New();
+    removeFlagged->setFeatureIdsArrayPath({k_DataContainerName, k_CellDataName, k_FeatureIdsName});
+    removeFlagged->setFlaggedFeaturesArrayPath({k_DataContainerName, k_FeatureDataName, k_FlaggedName});
+    removeFlagged->setFillRemovedFeatures(true);
+    removeFlagged->setRenumberFeatures(false);
+
+    // A minimum size of 0 keeps every Feature, so only the pending Feature 3 is removed. Feature 4 owns no
+    // Cells but was never removed, so it must be kept.
+    MinSize::Pointer minSize = createFilter(dca, 0, true);
+
+    // Preflight: the pending array is created by the first filter and consumed by the second
+    removeFlagged->setDataContainerArray(dca);
+    removeFlagged->preflight();
+    DREAM3D_REQUIRE_EQUAL(removeFlagged->getErrorCode(), 0);
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), true);
+    minSize->preflight();
+    DREAM3D_REQUIRE_EQUAL(minSize->getErrorCode(), 0);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), false);
+
+    dca = createDataStructure();
+    removeFlagged->setDataContainerArray(dca);
+    removeFlagged->execute();
+    DREAM3D_REQUIRE_EQUAL(removeFlagged->getErrorCode(), 0);
+    featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), 5);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(k_NeighborListName), false);
+
+    minSize->setDataContainerArray(dca);
+    minSize->execute();
+    DREAM3D_REQUIRE_EQUAL(minSize->getErrorCode(), 0);
+
+    featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), 4);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), false);
+    FloatArrayType::Pointer values = featureAM->getAttributeArrayAs<FloatArrayType>(k_ValuesName);
+    DREAM3D_REQUIRE_VALID_POINTER(values.get());
+    DREAM3D_REQUIRE_EQUAL(values->getValue(1), 10.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(2), 20.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(3), 40.0F);
+
+    return checkFilledFeatureIds(dca);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRemoveAndRenumber())
+    DREAM3D_REGISTER_TEST(TestDeferredRenumber())
+  }
+
+private:
+};
@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/HelperClasses/FeatureIdRemapper.h"
+#include "Processing/ProcessingFilters/RemoveFlaggedFeatures.h"
+#include "ProcessingTestFileLocations.h"
+
+class RemoveFlaggedFeaturesTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_FeatureDataName = {"FeatureData"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_FlaggedName = {"Flagged"};
+  const QString k_ValuesName = {"Values"};
+  const QString k_NeighborListName = {"NeighborList"};
+
+public:
+  RemoveFlaggedFeaturesTest() = default;
+  ~RemoveFlaggedFeaturesTest() = default;
+
+  RemoveFlaggedFeaturesTest(const RemoveFlaggedFeaturesTest&) = delete;            // Copy Constructor
+  RemoveFlaggedFeaturesTest(RemoveFlaggedFeaturesTest&&) = delete;                 // Move Constructor
+  RemoveFlaggedFeaturesTest& operator=(const RemoveFlaggedFeaturesTest&) = delete; // Copy Assignment
+  RemoveFlaggedFeaturesTest& operator=(RemoveFlaggedFeaturesTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // 4x4x1 image: Feature 1 owns columns 0-1, Feature 2 owns columns 2-3 except the last Cell, which belongs
+  // to Feature 3. Feature 4 is active but owns no Cells. Feature 3 is flagged for removal.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {4, 4, 1};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims, {1ULL}, k_FeatureIdsName, true);
+    for(size_t y = 0; y < 4; y++)
+    {
+      for(size_t x = 0; x < 4; x++)
+      {
+        featureIds->setValue(y * 4 + x, x < 2 ? 1 : 2);
+      }
+    }
+    featureIds->setValue(15, 3);
+    cellAM->insertOrAssign(featureIds);
+
+    const size_t numFeatures = 5;
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New({numFeatures}, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    BoolArrayType::Pointer flagged = BoolArrayType::CreateArray(numFeatures, std::string(k_FlaggedName.toStdString()), true);
+    flagged->initializeWithValue(false);
+    flagged->setValue(3, true);
+    featureAM->insertOrAssign(flagged);
+
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(numFeatures, std::string(k_ValuesName.toStdString()), true);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      values->setValue(i, 10.0F * static_cast<float>(i));
+    }
+    featureAM->insertOrAssign(values);
+
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, k_NeighborListName, true);
+    neighborList->setList(1, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({2})));
+    neighborList->setList(2, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({1, 3})));
+    neighborList->setList(3, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>({2})));
+    featureAM->insertOrAssign(neighborList);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  RemoveFlaggedFeatures::Pointer createFilter(const DataContainerArray::Pointer& dca, bool renumberFeatures)
+  {
+    RemoveFlaggedFeatures::Pointer filter = RemoveFlaggedFeatures::New();
+    filter->setDataContainerArray(dca);
+    filter->setFeatureIdsArrayPath({k_DataContainerName, k_CellDataName, k_FeatureIdsName});
+    filter->setFlaggedFeaturesArrayPath({k_DataContainerName, k_FeatureDataName, k_FlaggedName});
+    filter->setFillRemovedFeatures(true);
+    filter->setRenumberFeatures(renumberFeatures);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRemoveAndRenumber()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    RemoveFlaggedFeatures::Pointer filter = createFilter(dca, true);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    dca = createDataStructure();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // Only the flagged Feature is removed. Feature 4 has no Cells but was not flagged, so it is kept as Feature 3.
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), 4);
+    FloatArrayType::Pointer values = featureAM->getAttributeArrayAs<FloatArrayType>(k_ValuesName);
+    DREAM3D_REQUIRE_VALID_POINTER(values.get());
+    DREAM3D_REQUIRE_EQUAL(values->getValue(1), 10.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(2), 20.0F);
+    DREAM3D_REQUIRE_EQUAL(values->getValue(3), 40.0F);
+
+    // The NeighborList holds ids of the old numbering and must be deleted
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(k_NeighborListName), false);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), false);
+
+    // The Cell of the removed Feature is filled by its only neighboring Feature
+    Int32ArrayType::Pointer featureIds = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), (i % 4) < 2 ? 1 : 2);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDeferredRenumber()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    RemoveFlaggedFeatures::Pointer filter = createFilter(dca, false);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(FeatureIdRemapper::PendingRemovalsArrayName), true);
+
+    dca = createDataStructure();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    // The Features stay in place, the removed Feature is recorded as pending and the NeighborList is deleted
+    featureAM = dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""});
+    DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), 5);
+    DREAM3D_REQUIRE_EQUAL(featureAM->doesAttributeArrayExist(k_NeighborListName), false);
+    BoolArrayType::Pointer pending = featureAM->getAttributeArrayAs<BoolArrayType>(FeatureIdRemapper::PendingRemovalsArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(pending.get());
+    for(size_t i = 0; i < pending->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(pending->getValue(i), i == 3);
+    }
+
+    Int32ArrayType::Pointer featureIds = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), (i % 4) < 2 ? 1 : 2);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRemoveAndRenumber())
+    DREAM3D_REGISTER_TEST(TestDeferredRenumber())
+  }
+
+private:
+};
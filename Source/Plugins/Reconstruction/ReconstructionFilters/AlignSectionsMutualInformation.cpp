@@ -34,7 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <set>
+#include <utility>
 
 #include <QtCore/QTextStream>
 
@@ -49,12 +52,359 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+namespace
+{
+/**
+ * @brief calculateMutualInformation Computes the mutual information between the features of a section
+ * and the features of the section above it for one trial shift. Instead of a dense
+ * featurecount1 x featurecount2 joint histogram the sampled feature pairs are packed into 64 bit keys
+ * and sorted, which visits the non-zero bins in the same order the dense table would be walked.
+ * The buffers are passed in so each thread can reuse its own between trial shifts.
+ */
+float calculateMutualInformation(const int32_t* miFeatureIds, const int64_t dims[3], int64_t slice, int32_t featurecount1, int32_t featurecount2, int64_t xshift, int64_t yshift,
+                                 std::vector<uint64_t>& pairs, std::vector<float>& mutualinfo1, std::vector<float>& mutualinfo2)
+{
+  pairs.clear();
+  mutualinfo1.assign(featurecount1, 0.0f);
+  mutualinfo2.assign(featurecount2, 0.0f);
+
+  float count = 0.0f;
+  for(int64_t l = 0; l < dims[1]; l = l + 4)
+  {
+    for(int64_t n = 0; n < dims[0]; n = n + 4)
+    {
+      if((l + yshift) >= 0 && (l + yshift) < dims[1] && (n + xshift) >= 0 && (n + xshift) < dims[0])
+      {
+        int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+        int64_t curposition = (slice * dims[0] * dims[1]) + ((l + yshift) * dims[0]) + (n + xshift);
+        int32_t refgnum = miFeatureIds[refposition];
+        int32_t curgnum = miFeatureIds[curposition];
+        if(curgnum >= 0 && refgnum >= 0)
+        {
+          pairs.push_back((static_cast<uint64_t>(curgnum) << 32) | static_cast<uint64_t>(refgnum));
+          mutualinfo1[curgnum]++;
+          mutualinfo2[refgnum]++;
+          count++;
+        }
+      }
+      else
+      {
+        pairs.push_back(0);
+        mutualinfo1[0]++;
+        mutualinfo2[0]++;
+      }
+    }
+  }
+
+  for(auto& value : mutualinfo1)
+  {
+    value = value / count;
+  }
+  for(auto& value : mutualinfo2)
+  {
+    value = value / count;
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+  float mutualInfo = 0.0f;
+  size_t start = 0;
+  while(start < pairs.size())
+  {
+    size_t end = start + 1;
+    while(end < pairs.size() && pairs[end] == pairs[start])
+    {
+      end++;
+    }
+    size_t b = static_cast<size_t>(pairs[start] >> 32);
+    size_t c = static_cast<size_t>(pairs[start] & 0xFFFFFFFFULL);
+    float mutualinfo12 = static_cast<float>(end - start) / count;
+    float value = 0.0f;
+    if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+    {
+      value = (mutualinfo12 / (mutualinfo1[b] * mutualinfo2[c]));
+    }
+    if(value != 0)
+    {
+      mutualInfo = mutualInfo + (mutualinfo12 * logf(value));
+    }
+    start = end;
+  }
+  return mutualInfo;
+}
+
+/**
+ * @brief The TrialShiftsImpl class implements a threaded algorithm that evaluates a set of trial
+ * shifts between two sections. Each thread keeps its own histograms.
+ */
+class TrialShiftsImpl
+{
+public:
+  TrialShiftsImpl(const int32_t* miFeatureIds, const int64_t* dims, int64_t slice, int32_t featurecount1, int32_t featurecount2, const std::vector<std::pair<int64_t, int64_t>>& trialShifts,
+                  std::vector<float>& disorientations)
+  : m_MIFeatureIds(miFeatureIds)
+  , m_Dims(dims)
+  , m_Slice(slice)
+  , m_FeatureCount1(featurecount1)
+  , m_FeatureCount2(featurecount2)
+  , m_TrialShifts(trialShifts)
+  , m_Disorientations(disorientations)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    std::vector<uint64_t> pairs;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+    for(size_t t = range.min(); t < range.max(); t++)
+    {
+      float mutualInfo = calculateMutualInformation(m_MIFeatureIds, m_Dims, m_Slice, m_FeatureCount1, m_FeatureCount2, m_TrialShifts[t].first, m_TrialShifts[t].second, pairs, mutualinfo1,
+                                                    mutualinfo2);
+      m_Disorientations[t] = 1.0f / mutualInfo;
+    }
+  }
+
+private:
+  const int32_t* m_MIFeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int64_t m_Slice = 0;
+  int32_t m_FeatureCount1 = 0;
+  int32_t m_FeatureCount2 = 0;
+  const std::vector<std::pair<int64_t, int64_t>>& m_TrialShifts;
+  std::vector<float>& m_Disorientations;
+};
+
+/**
+ * @brief The FindSectionShiftsImpl class implements a threaded algorithm that finds the shift between
+ * each section and the section above it. Sections are independent of each other once the per section
+ * features exist; the shifts are accumulated afterwards.
+ */
+class FindSectionShiftsImpl
+{
+public:
+  FindSectionShiftsImpl(AbstractFilter* filter, const int32_t* miFeatureIds, const int64_t* dims, const int32_t* featurecounts, std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_Dims(dims)
+  , m_FeatureCounts(featurecounts)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+
+  void findShift(int64_t iter) const
+  {
+    int64_t slice = (m_Dims[2] - 1) - iter;
+    int32_t featurecount1 = m_FeatureCounts[slice];
+    int32_t featurecount2 = m_FeatureCounts[slice + 1];
+
+    float mindisorientation = std::numeric_limits<float>::max();
+    int64_t oldxshift = -1;
+    int64_t oldyshift = -1;
+    int64_t newxshift = 0;
+    int64_t newyshift = 0;
+    std::set<std::pair<int64_t, int64_t>> evaluatedShifts;
+    std::vector<std::pair<int64_t, int64_t>> trialShifts;
+    std::vector<float> disorientations;
+    while(newxshift != oldxshift || newyshift != oldyshift)
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      trialShifts.clear();
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          std::pair<int64_t, int64_t> shift(k + oldxshift, j + oldyshift);
+          if(evaluatedShifts.count(shift) == 0 && llabs(k + oldxshift) < (m_Dims[0] / 2) && (j + oldyshift) < (m_Dims[1] / 2))
+          {
+            evaluatedShifts.insert(shift);
+            trialShifts.push_back(shift);
+          }
+        }
+      }
+
+      disorientations.assign(trialShifts.size(), 0.0f);
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0ULL, trialShifts.size());
+      dataAlg.execute(TrialShiftsImpl(m_MIFeatureIds, m_Dims, slice, featurecount1, featurecount2, trialShifts, disorientations));
+
+      // Keep the serial scan order so ties resolve to the same shift as before
+      for(size_t t = 0; t < trialShifts.size(); t++)
+      {
+        if(disorientations[t] < mindisorientation)
+        {
+          newxshift = trialShifts[t].first;
+          newyshift = trialShifts[t].second;
+          mindisorientation = disorientations[t];
+        }
+      }
+    }
+    m_NewXShifts[iter] = newxshift;
+    m_NewYShifts[iter] = newyshift;
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      findShift(static_cast<int64_t>(iter));
+    }
+  }
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  const int32_t* m_MIFeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const int32_t* m_FeatureCounts = nullptr;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+};
+
+/**
+ * @brief The FormFeaturesSectionsImpl class implements a threaded algorithm that segments each section
+ * into features by flood filling neighboring pixels within the misorientation tolerance
+ */
+class FormFeaturesSectionsImpl
+{
+public:
+  FormFeaturesSectionsImpl(AbstractFilter* filter, const int64_t* dims, const float* quats, const int32_t* cellPhases, const bool* goodVoxels, bool useGoodVoxels, const uint32_t* crystalStructures,
+                           const LaueOpsContainer& orientationOps, float misorientationTolerance, int32_t* miFeatureIds, int32_t* featurecounts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_UseGoodVoxels(useGoodVoxels)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featurecounts)
+  {
+  }
+
+  void formFeatures(int64_t slice) const
+  {
+    const int64_t* dims = m_Dims;
+    int64_t neighpoints[4] = {-dims[0], -1, 1, dims[0]};
+    std::vector<int64_t> voxelslist;
+
+    int64_t startPoint = slice * dims[0] * dims[1];
+    int64_t endPoint = (slice + 1) * dims[0] * dims[1];
+    int64_t currentStartPoint = startPoint;
+
+    int32_t featurecount = 1;
+    while(true)
+    {
+      int64_t seed = -1;
+      for(int64_t point = currentStartPoint; point < endPoint; point++)
+      {
+        if((!m_UseGoodVoxels || (m_GoodVoxels != nullptr && m_GoodVoxels[point])) && m_MIFeatureIds[point] == 0 && m_CellPhases[point] > 0)
+        {
+          seed = point;
+          currentStartPoint = point;
+          break;
+        }
+      }
+      if(seed == -1)
+      {
+        break;
+      }
+
+      m_MIFeatureIds[seed] = featurecount;
+      voxelslist.clear();
+      voxelslist.push_back(seed);
+      for(size_t j = 0; j < voxelslist.size(); ++j)
+      {
+        int64_t currentpoint = voxelslist[j];
+        int64_t col = currentpoint % dims[0];
+        int64_t row = (currentpoint / dims[0]) % dims[1];
+
+        const float* currentQuatPtr = m_Quats + currentpoint * 4;
+        QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+        uint32_t phase1 = m_CrystalStructures[m_CellPhases[currentpoint]];
+        for(int32_t i = 0; i < 4; i++)
+        {
+          int64_t neighbor = currentpoint + neighpoints[i];
+          if((i == 0) && row == 0)
+          {
+            continue;
+          }
+          if((i == 3) && row == (dims[1] - 1))
+          {
+            continue;
+          }
+          if((i == 1) && col == 0)
+          {
+            continue;
+          }
+          if((i == 2) && col == (dims[0] - 1))
+          {
+            continue;
+          }
+          if(m_MIFeatureIds[neighbor] <= 0 && m_CellPhases[neighbor] > 0)
+          {
+            float w = std::numeric_limits<float>::max();
+            const float* neighborQuatPtr = m_Quats + neighbor * 4;
+            QuatF q2(neighborQuatPtr[0], neighborQuatPtr[1], neighborQuatPtr[2], neighborQuatPtr[3]);
+            uint32_t phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
+            if(phase1 == phase2)
+            {
+              OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+              w = axisAngle[3];
+            }
+            if(w < m_MisorientationTolerance)
+            {
+              m_MIFeatureIds[neighbor] = featurecount;
+              voxelslist.push_back(neighbor);
+            }
+          }
+        }
+      }
+      featurecount++;
+    }
+    m_FeatureCounts[slice] = featurecount;
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slice = range.min(); slice < range.max(); slice++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      formFeatures(static_cast<int64_t>(slice));
+    }
+  }
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  bool m_UseGoodVoxels = false;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const LaueOpsContainer& m_OrientationOps;
+  float m_MisorientationTolerance = 0.0f;
+  int32_t* m_MIFeatureIds = nullptr;
+  int32_t* m_FeatureCounts = nullptr;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -230,180 +580,34 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
+  if(getCancel())
+  {
+    return;
+  }
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+
+  // Each section pair is independent, so find all of the relative shifts first and accumulate them afterwards
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1ULL, static_cast<size_t>(dims[2]));
+  dataAlg.execute(FindSectionShiftsImpl(this, miFeatureIds, dims, featurecounts, newxshifts, newyshifts));
+  if(getCancel())
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -419,7 +623,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
 // -----------------------------------------------------------------------------
 void AlignSectionsMutualInformation::form_features_sections()
 {
-  SIMPL_RANDOMNG_NEW()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -430,23 +633,6 @@ void AlignSectionsMutualInformation::form_features_sections()
       static_cast<int64_t>(udims[2]),
   };
 
-  int64_t point = 0;
-  int64_t seed = 0;
-  bool noseeds = false;
-  int32_t featurecount = 1;
-  int64_t neighbor = 0;
-
-  FloatArrayType::Pointer quats = m_QuatsPtr.lock();
-
-  float w = 0.0f;
-  int64_t randx = 0;
-  int64_t randy = 0;
-  bool good = false;
-  int64_t x = 0, y = 0, z = 0;
-  int64_t col = 0, row = 0;
-  size_t size = 0;
-  size_t initialVoxelsListSize = 1000;
-
   float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiF / 180.0f;
 
   m_FeatureCounts->resizeTuples(dims[2]);
@@ -454,118 +640,13 @@ void AlignSectionsMutualInformation::form_features_sections()
 
   int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::vector<int64_t> voxelslist(initialVoxelsListSize, -1);
-  int64_t neighpoints[4] = {0, 0, 0, 0};
-  neighpoints[0] = -dims[0];
-  neighpoints[1] = -1;
-  neighpoints[2] = 1;
-  neighpoints[3] = dims[0];
-
-  uint32_t phase1 = 0, phase2 = 0;
-  float* currentQuatPtr = nullptr;
+  notifyStatusMessage("Aligning Sections || Identifying Features on Sections");
 
-  for(int64_t slice = 0; slice < dims[2]; slice++)
-  {
-    float prog = ((float)slice / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Identifying Features on Sections || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-
-    int64_t startPoint = slice * dims[0] * dims[1];
-    int64_t endPoint = (slice + 1) * dims[0] * dims[1];
-    int64_t currentStartPoint = startPoint;
-
-    featurecount = 1;
-    noseeds = false;
-    while(!noseeds)
-    {
-      seed = -1;
-      for(int64_t point = currentStartPoint; point < endPoint; point++)
-      {
-        if((!m_UseGoodVoxels || (m_GoodVoxels != nullptr && m_GoodVoxels[point])) && miFeatureIds[point] == 0 && m_CellPhases[point] > 0)
-        {
-          seed = point;
-          currentStartPoint = point;
-        }
-        if(seed > -1)
-        {
-          break;
-        }
-      }
-      if(seed == -1)
-      {
-        noseeds = true;
-      }
-      if(seed >= 0)
-      {
-        size = 0;
-        miFeatureIds[seed] = featurecount;
-        voxelslist[size] = seed;
-        size++;
-        for(size_t j = 0; j < size; ++j)
-        {
-          int64_t currentpoint = voxelslist[j];
-          col = currentpoint % dims[0];
-          row = (currentpoint / dims[0]) % dims[1];
-
-          currentQuatPtr = quats->getTuplePointer(currentpoint);
-          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-          phase1 = m_CrystalStructures[m_CellPhases[currentpoint]];
-          for(int32_t i = 0; i < 4; i++)
-          {
-            neighbor = currentpoint + neighpoints[i];
-            if((i == 0) && row == 0)
-            {
-              continue;
-            }
-            if((i == 3) && row == (dims[1] - 1))
-            {
-              continue;
-            }
-            if((i == 1) && col == 0)
-            {
-              continue;
-            }
-            if((i == 2) && col == (dims[0] - 1))
-            {
-              continue;
-            }
-            if(miFeatureIds[neighbor] <= 0 && m_CellPhases[neighbor] > 0)
-            {
-              w = std::numeric_limits<float>::max();
-              currentQuatPtr = quats->getTuplePointer(neighbor);
-
-              QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              if(phase1 == phase2)
-              {
-                OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                w = axisAngle[3];
-              }
-              if(w < misorientationTolerance)
-              {
-                miFeatureIds[neighbor] = featurecount;
-                voxelslist[size] = neighbor;
-                size++;
-                if(std::vector<int64_t>::size_type(size) >= voxelslist.size())
-                {
-                  size = voxelslist.size();
-                  voxelslist.resize(size + initialVoxelsListSize);
-                  for(std::vector<int64_t>::size_type v = size; v < voxelslist.size(); ++v)
-                  {
-                    voxelslist[v] = -1;
-                  }
-                }
-              }
-            }
-          }
-        }
-        voxelslist.erase(std::remove(voxelslist.begin(), voxelslist.end(), -1), voxelslist.end());
-        featurecount++;
-        voxelslist.assign(initialVoxelsListSize, -1);
-      }
-    }
-    featurecounts[slice] = featurecount;
-  }
+  // Every section is segmented on its own so the sections can be processed concurrently
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, static_cast<size_t>(dims[2]));
+  dataAlg.execute(FormFeaturesSectionsImpl(this, dims, m_QuatsPtr.lock()->getPointer(0), m_CellPhases, m_GoodVoxels, m_UseGoodVoxels, m_CrystalStructures, m_OrientationOps,
+                                           misorientationTolerance, miFeatureIds, featurecounts));
 }
 
 // -----------------------------------------------------------------------------
@@ -58,6 +58,31 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+namespace
+{
+/**
+ * @brief Returns the precomputed misorientation across the face between two neighboring cells. The
+ * array stores the +X, +Y and +Z faces of each cell (see FindCellFaceMisorientations). The strides are
+ * tested from Z down to X so that geometries with a dimension of 1 resolve to the correct face.
+ */
+float findFaceMisorientation(const float* faceMisorientations, int64_t dimX, int64_t dimXY, int64_t referencepoint, int64_t neighborpoint)
+{
+  const int64_t diff = neighborpoint - referencepoint;
+  const int64_t owner = diff > 0 ? referencepoint : neighborpoint;
+  const int64_t stride = diff > 0 ? diff : -diff;
+  int64_t axis = 0;
+  if(stride == dimXY)
+  {
+    axis = 2;
+  }
+  else if(stride == dimX)
+  {
+    axis = 1;
+  }
+  return faceMisorientations[owner * 3 + axis];
+}
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -91,6 +116,8 @@ void EBSDSegmentFeatures::setupFilterParameters()
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, EBSDSegmentFeatures, linkedProps));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Randomize Feature Ids", RandomizeFeatureIds, FilterParameter::Category::Parameter, EBSDSegmentFeatures));
+  linkedProps = {"FaceMisorientationsArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Face Misorientations", UseFaceMisorientations, FilterParameter::Category::Parameter, EBSDSegmentFeatures, linkedProps));
 
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
@@ -105,6 +132,10 @@ void EBSDSegmentFeatures::setupFilterParameters()
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Bool, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Mask", GoodVoxelsArrayPath, FilterParameter::Category::RequiredArray, EBSDSegmentFeatures, req));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Misorientations", FaceMisorientationsArrayPath, FilterParameter::Category::RequiredArray, EBSDSegmentFeatures, req));
+  }
   parameters.push_back(SeparatorFilterParameter::Create("Cell Ensemble Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -133,6 +164,8 @@ void EBSDSegmentFeatures::readFilterParameters(AbstractFilterParametersReader* r
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
+  setUseFaceMisorientations(reader->readValue("UseFaceMisorientations", getUseFaceMisorientations()));
+  setFaceMisorientationsArrayPath(reader->readDataArrayPath("FaceMisorientationsArrayPath", getFaceMisorientationsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
@@ -243,6 +276,20 @@ void EBSDSegmentFeatures::dataCheck()
     dataArrayPaths.push_back(getQuatsArrayPath());
   }
 
+  if(m_UseFaceMisorientations)
+  {
+    cDims[0] = 3;
+    m_FaceMisorientationsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getFaceMisorientationsArrayPath(), cDims);
+    if(nullptr != m_FaceMisorientationsPtr.lock())
+    {
+      m_FaceMisorientations = m_FaceMisorientationsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getFaceMisorientationsArrayPath());
+    }
+  }
+
   getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
 }
 
@@ -357,8 +404,16 @@ bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neig
 
     if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
     {
-      OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-      w = axisAngle[3];
+      if(m_UseFaceMisorientations)
+      {
+        w = findFaceMisorientation(m_FaceMisorientations, m_FaceStrideY, m_FaceStrideZ, referencepoint, neighborpoint);
+      }
+      // Faces without a value (stale or never filled) fall back to the direct calculation
+      if(!m_UseFaceMisorientations || w < 0.0f)
+      {
+        OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+        w = axisAngle[3];
+      }
     }
     if(w < m_MisoTolerance)
     {
@@ -400,6 +455,10 @@ void EBSDSegmentFeatures::execute()
   // Convert user defined tolerance to radians.
   m_MisoTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
 
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  m_FaceStrideY = static_cast<int64_t>(udims[0]);
+  m_FaceStrideZ = static_cast<int64_t>(udims[0] * udims[1]);
+
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
   const int64_t rangeMin = 0;
   const int64_t rangeMax = totalPoints - 1;
@@ -618,6 +677,30 @@ DataArrayPath EBSDSegmentFeatures::getQuatsArrayPath() const
   return m_QuatsArrayPath;
 }
 
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::setUseFaceMisorientations(bool value)
+{
+  m_UseFaceMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::getUseFaceMisorientations() const
+{
+  return m_UseFaceMisorientations;
+}
+
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::setFaceMisorientationsArrayPath(const DataArrayPath& value)
+{
+  m_FaceMisorientationsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath EBSDSegmentFeatures::getFaceMisorientationsArrayPath() const
+{
+  return m_FaceMisorientationsArrayPath;
+}
+
 // -----------------------------------------------------------------------------
 void EBSDSegmentFeatures::setFeatureIdsArrayName(const QString& value)
 {
@@ -69,6 +69,8 @@ class Reconstruction_EXPORT EBSDSegmentFeatures : public SegmentFeatures
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
+  PYB11_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+  PYB11_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
   PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
   PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
   PYB11_PROPERTY(bool RandomizeFeatureIds READ getRandomizeFeatureIds WRITE setRandomizeFeatureIds)
@@ -192,6 +194,28 @@ public:
   DataArrayPath getQuatsArrayPath() const;
   Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
+  /**
+   * @brief Setter property for UseFaceMisorientations
+   */
+  void setUseFaceMisorientations(bool value);
+  /**
+   * @brief Getter property for UseFaceMisorientations
+   * @return Value of UseFaceMisorientations
+   */
+  bool getUseFaceMisorientations() const;
+  Q_PROPERTY(bool UseFaceMisorientations READ getUseFaceMisorientations WRITE setUseFaceMisorientations)
+
+  /**
+   * @brief Setter property for FaceMisorientationsArrayPath
+   */
+  void setFaceMisorientationsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FaceMisorientationsArrayPath
+   * @return Value of FaceMisorientationsArrayPath
+   */
+  DataArrayPath getFaceMisorientationsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FaceMisorientationsArrayPath READ getFaceMisorientationsArrayPath WRITE setFaceMisorientationsArrayPath)
+
   /**
    * @brief Setter property for FeatureIdsArrayName
    */
@@ -299,6 +323,10 @@ protected:
 private:
   std::weak_ptr<DataArray<float>> m_QuatsPtr;
   float* m_Quats = nullptr;
+  std::weak_ptr<DataArray<float>> m_FaceMisorientationsPtr;
+  float* m_FaceMisorientations = nullptr;
+  int64_t m_FaceStrideY = 0;
+  int64_t m_FaceStrideZ = 0;
   std::weak_ptr<DataArray<int32_t>> m_CellPhasesPtr;
   int32_t* m_CellPhases = nullptr;
   std::weak_ptr<DataArray<bool>> m_GoodVoxelsPtr;
@@ -318,6 +346,8 @@ private:
   DataArrayPath m_CellPhasesArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases);
   DataArrayPath m_CrystalStructuresArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures);
   DataArrayPath m_QuatsArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats);
+  bool m_UseFaceMisorientations = {false};
+  DataArrayPath m_FaceMisorientationsArrayPath = DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "FaceMisorientations");
   QString m_FeatureIdsArrayName = {SIMPL::CellData::FeatureIds};
   QString m_ActiveArrayName = {SIMPL::FeatureData::Active};
 
@@ -34,7 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "IdentifyMicroTextureRegions.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -42,6 +45,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -56,6 +60,7 @@
 
 // included so we can call under the hood to segment the patches found in this filter
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/Utils/CAxisPatchMisalignments.hpp"
 #include "Reconstruction/ReconstructionFilters/VectorSegmentFeatures.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
@@ -81,160 +86,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
-/**
- * @brief The FindPatchMisalignmentsImpl class implements a threaded algorithm that determines the misorientations
- * between for all cell faces in the structure
- */
-class FindPatchMisalignmentsImpl
-{
-public:
-  FindPatchMisalignmentsImpl(int64_t* newDims, int64_t* origDims, float* caxisLocs, int32_t* phases, uint32_t* crystructs, float* volFrac, float* avgCAxis, bool* inMTR, int64_t* critDim,
-                             float minVolFrac, float caxisTol)
-  : m_DicDims(newDims)
-  , m_VolDims(origDims)
-  , m_CAxisLocations(caxisLocs)
-  , m_CellPhases(phases)
-  , m_CrystalStructures(crystructs)
-  , m_InMTR(inMTR)
-  , m_VolFrac(volFrac)
-  , m_AvgCAxis(avgCAxis)
-  , m_CritDim(critDim)
-  , m_MinVolFrac(minVolFrac)
-  , m_CAxisTolerance(caxisTol)
-  {
-  }
-
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  virtual ~FindPatchMisalignmentsImpl() = default;
-
-  void convert(size_t start, size_t end) const
-  {
-    int64_t xDim = (2 * m_CritDim[0]) + 1;
-    int64_t yDim = (2 * m_CritDim[1]) + 1;
-    int64_t zDim = (2 * m_CritDim[2]) + 1;
-    std::vector<size_t> tDims(1, xDim * yDim * zDim);
-    std::vector<size_t> cDims(1, 3);
-    FloatArrayType::Pointer cAxisLocsPtr = FloatArrayType::CreateArray(tDims, cDims, "_INTERNAL_USE_ONLY_cAxisLocs", true);
-    cAxisLocsPtr->initializeWithValue(0);
-    float* cAxisLocs = cAxisLocsPtr->getPointer(0);
-    std::vector<int64_t> goodCounts;
-
-    int64_t xc = 0, yc = 0, zc = 0;
-    for(size_t iter = start; iter < end; iter++)
-    {
-      int64_t zStride = 0, yStride = 0;
-      int64_t count = 0;
-      xc = ((iter % m_DicDims[0]) * m_CritDim[0]) + (m_CritDim[0] / 2);
-      yc = (((iter / m_DicDims[0]) % m_DicDims[1]) * m_CritDim[1]) + (m_CritDim[1] / 2);
-      zc = ((iter / (m_DicDims[0] * m_DicDims[1])) * m_CritDim[2]) + (m_CritDim[2] / 2);
-      for(int64_t k = -m_CritDim[2]; k <= m_CritDim[2]; k++)
-      {
-        if((zc + k) >= 0 && (zc + k) < m_VolDims[2])
-        {
-          zStride = ((zc + k) * m_VolDims[0] * m_VolDims[1]);
-          for(int64_t j = -m_CritDim[1]; j <= m_CritDim[1]; j++)
-          {
-            if((yc + j) >= 0 && (yc + j) < m_VolDims[1])
-            {
-              yStride = ((yc + j) * m_VolDims[0]);
-              for(int64_t i = -m_CritDim[0]; i <= m_CritDim[0]; i++)
-              {
-                if((xc + i) >= 0 && (xc + i) < m_VolDims[0])
-                {
-                  if(m_CrystalStructures[m_CellPhases[(zStride + yStride + xc + i)]] == EbsdLib::CrystalStructure::Hexagonal_High)
-                  {
-                    cAxisLocs[3 * count + 0] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 0];
-                    cAxisLocs[3 * count + 1] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 1];
-                    cAxisLocs[3 * count + 2] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 2];
-                    count++;
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
-      float angle = 0.0f;
-      goodCounts.resize(count);
-      goodCounts.assign(count, 0);
-      for(int64_t i = 0; i < count; i++)
-      {
-        for(int64_t j = i; j < count; j++)
-        {
-          angle = GeometryMath::AngleBetweenVectors(cAxisLocsPtr->getPointer(3 * i), cAxisLocsPtr->getPointer(3 * j));
-          if(angle <= m_CAxisTolerance || (SIMPLib::Constants::k_PiD - angle) <= m_CAxisTolerance)
-          {
-            goodCounts[i]++;
-            goodCounts[j]++;
-          }
-        }
-      }
-      int64_t goodPointCount = 0;
-      for(int64_t i = 0; i < count; i++)
-      {
-        if(float(goodCounts[i]) / float(count) > m_MinVolFrac)
-        {
-          goodPointCount++;
-        }
-      }
-      float avgCAxis[3] = {0.0f, 0.0f, 0.0f};
-      float frac = float(goodPointCount) / float(count);
-      m_VolFrac[iter] = frac;
-      if(frac > m_MinVolFrac)
-      {
-        m_InMTR[iter] = true;
-        for(int64_t i = 0; i < count; i++)
-        {
-          if(float(goodCounts[i]) / float(count) >= m_MinVolFrac)
-          {
-            if(MatrixMath::DotProduct3x1(avgCAxis, cAxisLocsPtr->getPointer(3 * i)) < 0)
-            {
-              avgCAxis[0] -= cAxisLocs[3 * i];
-              avgCAxis[1] -= cAxisLocs[3 * i + 1];
-              avgCAxis[2] -= cAxisLocs[3 * i + 2];
-            }
-            else
-            {
-              avgCAxis[0] += cAxisLocs[3 * i];
-              avgCAxis[1] += cAxisLocs[3 * i + 1];
-              avgCAxis[2] += cAxisLocs[3 * i + 2];
-            }
-          }
-        }
-        MatrixMath::Normalize3x1(avgCAxis);
-        if(avgCAxis[2] < 0)
-        {
-          MatrixMath::Multiply3x1withConstant(avgCAxis, -1.0f);
-        }
-        m_AvgCAxis[3 * iter] = avgCAxis[0];
-        m_AvgCAxis[3 * iter + 1] = avgCAxis[1];
-        m_AvgCAxis[3 * iter + 2] = avgCAxis[2];
-      }
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
-  }
-#endif
-private:
-  int64_t* m_DicDims;
-  int64_t* m_VolDims;
-  float* m_CAxisLocations;
-  int32_t* m_CellPhases;
-  uint32_t* m_CrystalStructures;
-  bool* m_InMTR;
-  float* m_VolFrac;
-  float* m_AvgCAxis;
-  int64_t* m_CritDim;
-  float m_MinVolFrac;
-  float m_CAxisTolerance;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -258,6 +109,7 @@ void IdentifyMicroTextureRegions::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("C-Axis Alignment Tolerance (Degrees)", CAxisTolerance, FilterParameter::Category::Parameter, IdentifyMicroTextureRegions));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum MicroTextured Region Size (Diameter)", MinMTRSize, FilterParameter::Category::Parameter, IdentifyMicroTextureRegions));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Volume Fraction in MTR", MinVolFrac, FilterParameter::Category::Parameter, IdentifyMicroTextureRegions));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use C-Axis Binning", UseCAxisBinning, FilterParameter::Category::Parameter, IdentifyMicroTextureRegions));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -294,6 +146,7 @@ void IdentifyMicroTextureRegions::readFilterParameters(AbstractFilterParametersR
   setCAxisTolerance(reader->readValue("CAxisTolerance", getCAxisTolerance()));
   setMinMTRSize(reader->readValue("MinMTRSize", getMinMTRSize()));
   setMinVolFrac(reader->readValue("MinVolFrac", getMinVolFrac()));
+  setUseCAxisBinning(reader->readValue("UseCAxisBinning", getUseCAxisBinning()));
   reader->closeFilterGroup();
 }
 
@@ -514,11 +367,13 @@ void IdentifyMicroTextureRegions::execute()
   {
     return;
   }
+  ImageGeom::Pointer patchGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  tmpDC->setGeometry(patchGeom);
   tmpDC->getGeometryAs<ImageGeom>()->setDimensions(SizeVec3Type(static_cast<size_t>(newDim[0]), static_cast<size_t>(newDim[1]), static_cast<size_t>(newDim[2])));
   tmpDC->getGeometryAs<ImageGeom>()->setSpacing(critRes);
   tmpDC->getGeometryAs<ImageGeom>()->setOrigin(origin);
 
-  std::vector<size_t> tDims;
+  std::vector<size_t> tDims(3, 0);
   tDims[0] = newDim[0];
   tDims[1] = newDim[1];
   tDims[2] = newDim[2];
@@ -556,19 +411,27 @@ void IdentifyMicroTextureRegions::execute()
   // Convert user defined tolerance to radians.
   m_CAxisToleranceRad = m_CAxisTolerance * SIMPLib::Constants::k_PiD / 180.0f;
 
+  std::shared_ptr<CAxisHemisphereBins> caxisBins;
+  if(m_UseCAxisBinning)
+  {
+    caxisBins = std::make_shared<CAxisHemisphereBins>(m_CAxisToleranceRad);
+  }
+
 // first determine the misorientation vectors on all the voxel faces
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(true)
   {
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, totalPatches),
-        FindPatchMisalignmentsImpl(newDims.data(), origDims.data(), m_CAxisLocations, m_CellPhases, m_CrystalStructures, m_VolFrac, m_AvgCAxis, m_InMTR, critDim, m_MinVolFrac, m_CAxisToleranceRad),
+        FindPatchMisalignmentsImpl(newDims.data(), origDims.data(), m_CAxisLocations, m_CellPhases, m_CrystalStructures, m_VolFrac, m_AvgCAxis, m_InMTR, critDim, m_MinVolFrac, m_CAxisToleranceRad,
+                                   caxisBins.get()),
         tbb::auto_partitioner());
   }
   else
 #endif
   {
-    FindPatchMisalignmentsImpl serial(newDims.data(), origDims.data(), m_CAxisLocations, m_CellPhases, m_CrystalStructures, m_VolFrac, m_AvgCAxis, m_InMTR, critDim, m_MinVolFrac, m_CAxisToleranceRad);
+    FindPatchMisalignmentsImpl serial(newDims.data(), origDims.data(), m_CAxisLocations, m_CellPhases, m_CrystalStructures, m_VolFrac, m_AvgCAxis, m_InMTR, critDim, m_MinVolFrac, m_CAxisToleranceRad,
+                                      caxisBins.get());
     serial.convert(0, totalPatches);
   }
 
@@ -581,10 +444,17 @@ void IdentifyMicroTextureRegions::execute()
   filter->setUseGoodVoxels(true);
   tempPath.update("_INTERNAL_USE_ONLY_PatchDataContainer(Temp)", "_INTERNAL_USE_ONLY_PatchAM(Temp)", "_INTERNAL_USE_ONLY_InMTR");
   filter->setGoodVoxelsArrayPath(tempPath);
-  filter->setFeatureIdsArrayName("PatchFeatureIds");
-  filter->setCellFeatureAttributeMatrixName("PatchFeatureData");
-  filter->setActiveArrayName("Active");
+  filter->setFeatureIdsArrayName("_INTERNAL_USE_ONLY_PatchFeatureIds");
+  filter->setCellFeatureAttributeMatrixName("_INTERNAL_USE_ONLY_PatchFeatureData");
+  filter->setActiveArrayName("_INTERNAL_USE_ONLY_Active");
+  filter->setRandomizeFeatureIds(false);
   filter->execute();
+  if(filter->getErrorCode() < 0)
+  {
+    QString ss = QObject::tr("Segmenting the patches failed with error code %1").arg(filter->getErrorCode());
+    setErrorCondition(filter->getErrorCode(), ss);
+    return;
+  }
 
   // get the data created by the SegmentFeatures(Vector) filter
   cDims[0] = 1;
@@ -691,11 +561,11 @@ void IdentifyMicroTextureRegions::execute()
   }
 
   // remove the data container temporarily created to hold the patch data
-  getDataContainerArray()->removeDataContainer("PatchDataContainer(Temp)");
+  getDataContainerArray()->removeDataContainer("_INTERNAL_USE_ONLY_PatchDataContainer(Temp)");
 
   findMTRregions();
 
-  int64_t totalFeatures = static_cast<int64_t>(m_AvgCAxisPtr.lock()->getNumberOfTuples());
+  int64_t totalFeatures = static_cast<int64_t>(m->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->getNumberOfTuples());
 
   // By default we randomize grains
   if(getRandomizeMTRIds() && !getCancel())
@@ -854,6 +724,18 @@ float IdentifyMicroTextureRegions::getMinVolFrac() const
   return m_MinVolFrac;
 }
 
+// -----------------------------------------------------------------------------
+void IdentifyMicroTextureRegions::setUseCAxisBinning(bool value)
+{
+  m_UseCAxisBinning = value;
+}
+
+// -----------------------------------------------------------------------------
+bool IdentifyMicroTextureRegions::getUseCAxisBinning() const
+{
+  return m_UseCAxisBinning;
+}
+
 // -----------------------------------------------------------------------------
 void IdentifyMicroTextureRegions::setRandomizeMTRIds(bool value)
 {
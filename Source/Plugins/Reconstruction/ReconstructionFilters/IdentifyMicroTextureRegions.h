@@ -61,6 +61,7 @@ class Reconstruction_EXPORT IdentifyMicroTextureRegions : public AbstractFilter
   PYB11_PROPERTY(float CAxisTolerance READ getCAxisTolerance WRITE setCAxisTolerance)
   PYB11_PROPERTY(float MinMTRSize READ getMinMTRSize WRITE setMinMTRSize)
   PYB11_PROPERTY(float MinVolFrac READ getMinVolFrac WRITE setMinVolFrac)
+  PYB11_PROPERTY(bool UseCAxisBinning READ getUseCAxisBinning WRITE setUseCAxisBinning)
   PYB11_PROPERTY(DataArrayPath CAxisLocationsArrayPath READ getCAxisLocationsArrayPath WRITE setCAxisLocationsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
@@ -143,6 +144,17 @@ public:
   float getMinVolFrac() const;
   Q_PROPERTY(float MinVolFrac READ getMinVolFrac WRITE setMinVolFrac)
 
+  /**
+   * @brief Setter property for UseCAxisBinning
+   */
+  void setUseCAxisBinning(bool value);
+  /**
+   * @brief Getter property for UseCAxisBinning
+   * @return Value of UseCAxisBinning
+   */
+  bool getUseCAxisBinning() const;
+  Q_PROPERTY(bool UseCAxisBinning READ getUseCAxisBinning WRITE setUseCAxisBinning)
+
   /**
    * @brief Setter property for RandomizeMTRIds
    */
@@ -306,6 +318,7 @@ private:
   float m_CAxisTolerance = {1.0f};
   float m_MinMTRSize = {1.0f};
   float m_MinVolFrac = {1.0f};
+  bool m_UseCAxisBinning = {false};
   bool m_RandomizeMTRIds = {false};
   DataArrayPath m_CAxisLocationsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::CAxisLocation};
   DataArrayPath m_CellPhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases};
@@ -30,6 +30,10 @@
 
 #include "PartitionGeometry.h"
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -44,6 +48,7 @@
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/PreflightUpdatedValueFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Geometry/HexahedralGeom.h"
 #include "SIMPLib/Geometry/QuadGeom.h"
@@ -51,6 +56,7 @@
 #include "SIMPLib/Geometry/TetrahedralGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/STLUtilities.hpp"
 
 #include "Reconstruction/ReconstructionConstants.h"
@@ -248,6 +254,186 @@ InitResult InitSimplePartitioningGeometry(const RectGridGeom& geometry, ImageGeo
 
   return {};
 }
+
+/**
+ * @brief PartitionAxisIndex Returns the index along one axis of the partitioning scheme geometry that holds the coordinate,
+ * or -1 if the coordinate is outside of it. This is the per axis form of ImageGeom::getIndex so the results are identical.
+ */
+inline int64_t PartitionAxisIndex(float coord, float origin, float spacing, size_t dim)
+{
+  if(coord < origin || coord > (static_cast<float>(dim) * spacing + origin))
+  {
+    return -1;
+  }
+  size_t index = static_cast<size_t>(std::floor((coord - origin) / spacing));
+  if(index >= dim)
+  {
+    return -1;
+  }
+  return static_cast<int64_t>(index);
+}
+
+/**
+ * @brief The PartitionGridRowsImpl class assigns the partition ids of whole rows of a grid geometry from the partition
+ * indices of each x, y and z cell position, which are computed once per axis.
+ */
+class PartitionGridRowsImpl
+{
+public:
+  PartitionGridRowsImpl(const std::array<std::vector<int64_t>, 3>& axisIndices, const SizeVec3Type& partitionDims, int32_t startingPartitionId, int32_t outOfBoundsValue, int32_t* partitionIds)
+  : m_AxisIndices(axisIndices)
+  , m_PartitionDims(partitionDims)
+  , m_StartingPartitionId(startingPartitionId)
+  , m_OutOfBoundsValue(outOfBoundsValue)
+  , m_PartitionIds(partitionIds)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const std::vector<int64_t>& xIndices = m_AxisIndices[0];
+    const std::vector<int64_t>& yIndices = m_AxisIndices[1];
+    const std::vector<int64_t>& zIndices = m_AxisIndices[2];
+    const size_t xDim = xIndices.size();
+    const size_t yDim = yIndices.size();
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      int64_t y = yIndices[row % yDim];
+      int64_t z = zIndices[row / yDim];
+      int32_t* rowIds = m_PartitionIds + row * xDim;
+      if(y < 0 || z < 0)
+      {
+        std::fill(rowIds, rowIds + xDim, m_OutOfBoundsValue);
+        continue;
+      }
+      int64_t rowOffset = static_cast<int64_t>(m_PartitionDims[1] * m_PartitionDims[0]) * z + static_cast<int64_t>(m_PartitionDims[0]) * y + m_StartingPartitionId;
+      for(size_t x = 0; x < xDim; x++)
+      {
+        rowIds[x] = xIndices[x] < 0 ? m_OutOfBoundsValue : static_cast<int32_t>(rowOffset + xIndices[x]);
+      }
+    }
+  }
+
+private:
+  const std::array<std::vector<int64_t>, 3>& m_AxisIndices;
+  SizeVec3Type m_PartitionDims;
+  int32_t m_StartingPartitionId;
+  int32_t m_OutOfBoundsValue;
+  int32_t* m_PartitionIds;
+};
+
+/**
+ * @brief The PartitionVerticesImpl class assigns the partition id of each vertex and records the largest partition id
+ * of each block of vertices.
+ */
+class PartitionVerticesImpl
+{
+public:
+  static constexpr size_t k_BlockSize = 65536;
+
+  PartitionVerticesImpl(const float* vertices, const bool* mask, size_t numVertices, const ImageGeom& partitionGeometry, int32_t startingPartitionId, int32_t outOfBoundsValue,
+                        int32_t* partitionIds, std::vector<int32_t>& blockMaxIds)
+  : m_Vertices(vertices)
+  , m_Mask(mask)
+  , m_NumVertices(numVertices)
+  , m_Origin(partitionGeometry.getOrigin())
+  , m_Spacing(partitionGeometry.getSpacing())
+  , m_Dims(partitionGeometry.getDimensions())
+  , m_StartingPartitionId(startingPartitionId)
+  , m_OutOfBoundsValue(outOfBoundsValue)
+  , m_PartitionIds(partitionIds)
+  , m_BlockMaxIds(blockMaxIds)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      int32_t maxId = 0;
+      size_t end = std::min(m_NumVertices, (block + 1) * k_BlockSize);
+      for(size_t idx = block * k_BlockSize; idx < end; idx++)
+      {
+        int32_t partitionId = m_OutOfBoundsValue;
+        if(nullptr == m_Mask || m_Mask[idx])
+        {
+          const float* vertex = m_Vertices + idx * 3;
+          int64_t x = PartitionAxisIndex(vertex[0], m_Origin[0], m_Spacing[0], m_Dims[0]);
+          int64_t y = PartitionAxisIndex(vertex[1], m_Origin[1], m_Spacing[1], m_Dims[1]);
+          int64_t z = PartitionAxisIndex(vertex[2], m_Origin[2], m_Spacing[2], m_Dims[2]);
+          if(x >= 0 && y >= 0 && z >= 0)
+          {
+            partitionId = static_cast<int32_t>(static_cast<int64_t>(m_Dims[1] * m_Dims[0]) * z + static_cast<int64_t>(m_Dims[0]) * y + x + m_StartingPartitionId);
+            maxId = std::max(maxId, partitionId);
+          }
+        }
+        m_PartitionIds[idx] = partitionId;
+      }
+      m_BlockMaxIds[block] = maxId;
+    }
+  }
+
+private:
+  const float* m_Vertices;
+  const bool* m_Mask;
+  size_t m_NumVertices;
+  FloatVec3Type m_Origin;
+  FloatVec3Type m_Spacing;
+  SizeVec3Type m_Dims;
+  int32_t m_StartingPartitionId;
+  int32_t m_OutOfBoundsValue;
+  int32_t* m_PartitionIds;
+  std::vector<int32_t>& m_BlockMaxIds;
+};
+
+/**
+ * @brief The PartitionIndexListsImpl class either counts the elements of each partition in a block of elements or,
+ * once the counts have been turned into write offsets, scatters the element indices of the block into their partitions.
+ * Ids that are not a partition (e.g. out-of-bounds) go into the last bucket.
+ */
+class PartitionIndexListsImpl
+{
+public:
+  PartitionIndexListsImpl(const int32_t* partitionIds, size_t numElements, size_t blockSize, size_t numPartitions, std::vector<int64_t>& blockBuckets, int64_t* elementIndices)
+  : m_PartitionIds(partitionIds)
+  , m_NumElements(numElements)
+  , m_BlockSize(blockSize)
+  , m_NumPartitions(numPartitions)
+  , m_BlockBuckets(blockBuckets)
+  , m_ElementIndices(elementIndices)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      int64_t* buckets = m_BlockBuckets.data() + block * (m_NumPartitions + 1);
+      size_t end = std::min(m_NumElements, (block + 1) * m_BlockSize);
+      for(size_t i = block * m_BlockSize; i < end; i++)
+      {
+        int32_t id = m_PartitionIds[i];
+        size_t bucket = (id >= 0 && static_cast<size_t>(id) < m_NumPartitions) ? static_cast<size_t>(id) : m_NumPartitions;
+        if(nullptr == m_ElementIndices)
+        {
+          buckets[bucket]++;
+        }
+        else
+        {
+          m_ElementIndices[buckets[bucket]++] = static_cast<int64_t>(i);
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_PartitionIds;
+  size_t m_NumElements;
+  size_t m_BlockSize;
+  size_t m_NumPartitions;
+  std::vector<int64_t>& m_BlockBuckets;
+  int64_t* m_ElementIndices;
+};
 } // namespace Detail
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -382,6 +568,12 @@ void PartitionGeometry::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Feature Attribute Matrix", FeatureAttributeMatrixName, AttributeMatrixPath, FilterParameter::Category::Parameter, PartitionGeometry));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Partition Ids", PartitionIdsArrayName, AttributeMatrixPath, AttributeMatrixPath, FilterParameter::Category::CreatedArray, PartitionGeometry));
 
+  linkedProps = {"PartitionElementIndicesArrayName", "PartitionElementRangesArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Create Partition Index Lists", CreatePartitionIndexLists, FilterParameter::Category::Parameter, PartitionGeometry, linkedProps));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Partition Element Indices", PartitionElementIndicesArrayName, AttributeMatrixPath, AttributeMatrixPath, FilterParameter::Category::CreatedArray,
+                                                      PartitionGeometry));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Partition Element Ranges (Feature Attribute Matrix)", PartitionElementRangesArrayName, FilterParameter::Category::CreatedArray, PartitionGeometry));
+
   setFilterParameters(parameters);
 }
 
@@ -532,6 +724,19 @@ void PartitionGeometry::dataCheck()
   {
     m_PartitionIds = m_PartitionIdsPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  if(m_CreatePartitionIndexLists)
+  {
+    tempPath.setDataArrayName(getPartitionElementIndicesArrayName());
+    m_PartitionElementIndicesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<Int64ArrayType>(this, tempPath, 0, {1});
+    if(getErrorCode() != 0)
+    {
+      return;
+    }
+
+    tempPath = DataArrayPath(m_AttributeMatrixPath.getDataContainerName(), m_FeatureAttributeMatrixName, getPartitionElementRangesArrayName());
+    getDataContainerArray()->createNonPrereqArrayFromPath<Int64ArrayType>(this, tempPath, 0, {2});
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -880,6 +1085,11 @@ void PartitionGeometry::execute()
   }
   }
 
+  if(m_CreatePartitionIndexLists)
+  {
+    createPartitionIndexLists(*partitionIdsPtr);
+  }
+
   if(m_SavePartitioningScheme)
   {
     for(size_t i = 0; i < m_PartitionImageGeometryResult.first->getNumberOfElements(); i++)
@@ -895,31 +1105,38 @@ void PartitionGeometry::execute()
 void PartitionGeometry::partitionCellBasedGeometry(const IGeometryGrid& geometry, Int32ArrayType& partitionIds, int outOfBoundsValue)
 {
   SizeVec3Type dims = geometry.getDimensions();
+  const ImageGeom& partitionGeometry = *m_PartitionImageGeometryResult.first;
+  FloatVec3Type origin = partitionGeometry.getOrigin();
+  FloatVec3Type spacing = partitionGeometry.getSpacing();
+  SizeVec3Type partitionDims = partitionGeometry.getDimensions();
+
+  // The cell coordinates of a grid along one axis do not depend on the other two axes, so the partition index along
+  // each axis only needs to be computed once per x, y and z position instead of once per cell
+  std::array<std::vector<int64_t>, 3> axisIndices;
+  std::array<int64_t, 3> maxAxisIndex = {-1, -1, -1};
+  for(size_t axis = 0; axis < 3; axis++)
+  {
+    axisIndices[axis].resize(dims[axis]);
+    for(size_t i = 0; i < dims[axis]; i++)
+    {
+      std::array<size_t, 3> cell = {0, 0, 0};
+      cell[axis] = i;
+      std::array<float, 3> coord;
+      geometry.getCoords(cell[0], cell[1], cell[2], coord.data());
+      axisIndices[axis][i] = Detail::PartitionAxisIndex(coord[axis], origin[axis], spacing[axis], partitionDims[axis]);
+      maxAxisIndex[axis] = std::max(maxAxisIndex[axis], axisIndices[axis][i]);
+    }
+  }
 
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, dims[1] * dims[2]);
+  dataAlg.execute(Detail::PartitionGridRowsImpl(axisIndices, partitionDims, m_StartingPartitionID, outOfBoundsValue, partitionIds.getPointer(0)));
+
+  // Partition ids grow along every axis, so the largest id belongs to the largest index found along each axis
   size_t maxValue = 0;
-  for(size_t z = 0; z < dims[2]; z++)
+  if(maxAxisIndex[0] >= 0 && maxAxisIndex[1] >= 0 && maxAxisIndex[2] >= 0)
   {
-    for(size_t y = 0; y < dims[1]; y++)
-    {
-      for(size_t x = 0; x < dims[0]; x++)
-      {
-        size_t index = (z * dims[1] * dims[0]) + (y * dims[0]) + x;
-
-        std::array<float, 3> coord;
-        geometry.getCoords(x, y, z, coord.data());
-        auto partitionIndexResult = m_PartitionImageGeometryResult.first->getIndex(coord[0], coord[1], coord[2]);
-        if(partitionIndexResult.has_value())
-        {
-          int32_t partitionID = *partitionIndexResult + m_StartingPartitionID;
-          maxValue = partitionID > maxValue ? partitionID : maxValue;
-          partitionIds.setValue(index, partitionID);
-        }
-        else
-        {
-          partitionIds.setValue(index, outOfBoundsValue);
-        }
-      }
-    }
+    maxValue = partitionDims[1] * partitionDims[0] * maxAxisIndex[2] + partitionDims[0] * maxAxisIndex[1] + maxAxisIndex[0] + m_StartingPartitionID;
   }
 
   AttributeMatrix::Pointer featureAM = getDataContainerArray()->getAttributeMatrix({m_AttributeMatrixPath.getDataContainerName(), m_FeatureAttributeMatrixName, ""});
@@ -940,36 +1157,67 @@ void PartitionGeometry::partitionNodeBasedGeometry(const QString& geomName, cons
     mask = maskPtr->getPointer(0);
   }
   size_t numOfVertices = vertexList.getNumberOfTuples();
-  float* vertexArray = vertexList.getPointer(0);
+  size_t numBlocks = (numOfVertices + Detail::PartitionVerticesImpl::k_BlockSize - 1) / Detail::PartitionVerticesImpl::k_BlockSize;
+  std::vector<int32_t> blockMaxIds(numBlocks, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, numBlocks);
+  dataAlg.execute(
+      Detail::PartitionVerticesImpl(vertexList.getPointer(0), mask, numOfVertices, *m_PartitionImageGeometryResult.first, m_StartingPartitionID, outOfBoundsValue, partitionIds.getPointer(0), blockMaxIds));
+
   size_t maxValue = 0;
-  for(size_t idx = 0; idx < numOfVertices; idx++)
+  for(int32_t blockMaxId : blockMaxIds)
   {
-    if(m_UseVertexMask && !mask[idx])
+    maxValue = std::max(maxValue, static_cast<size_t>(blockMaxId));
+  }
+
+  AttributeMatrix::Pointer featureAM = getDataContainerArray()->getAttributeMatrix({m_AttributeMatrixPath.getDataContainerName(), m_FeatureAttributeMatrixName, ""});
+  featureAM->setTupleDimensions({maxValue + 1});
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PartitionGeometry::createPartitionIndexLists(const Int32ArrayType& partitionIds)
+{
+  AttributeMatrix::Pointer featureAM = getDataContainerArray()->getAttributeMatrix({m_AttributeMatrixPath.getDataContainerName(), m_FeatureAttributeMatrixName, ""});
+  Int64ArrayType::Pointer rangesPtr = featureAM->getAttributeArrayAs<Int64ArrayType>(m_PartitionElementRangesArrayName);
+  Int64ArrayType::Pointer elementIndicesPtr = m_PartitionElementIndicesPtr.lock();
+  size_t numPartitions = featureAM->getNumberOfTuples();
+  size_t numElements = partitionIds.getNumberOfTuples();
+
+  // Every block keeps a count per partition, so limit the number of blocks when there are many partitions
+  size_t numBlocks = std::max<size_t>(1ULL, std::thread::hardware_concurrency());
+  numBlocks = std::min(numBlocks, std::max<size_t>(1ULL, numElements / (numPartitions + 1)));
+  size_t blockSize = std::max<size_t>(1ULL, (numElements + numBlocks - 1) / numBlocks);
+  numBlocks = (numElements + blockSize - 1) / blockSize;
+  std::vector<int64_t> blockBuckets(numBlocks * (numPartitions + 1), 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, numBlocks);
+  dataAlg.execute(Detail::PartitionIndexListsImpl(partitionIds.getPointer(0), numElements, blockSize, numPartitions, blockBuckets, nullptr));
+
+  // Turn the counts into the write offset of each block within each partition, keeping the elements in increasing order
+  int64_t offset = 0;
+  for(size_t bucket = 0; bucket <= numPartitions; bucket++)
+  {
+    if(bucket < numPartitions)
     {
-      partitionIds.setValue(idx, outOfBoundsValue);
+      rangesPtr->setComponent(bucket, 0, offset);
     }
-    else
+    for(size_t block = 0; block < numBlocks; block++)
     {
-      float x = vertexArray[idx * 3];
-      float y = vertexArray[idx * 3 + 1];
-      float z = vertexArray[idx * 3 + 2];
-
-      auto partitionIndexResult = m_PartitionImageGeometryResult.first->getIndex(x, y, z);
-      if(partitionIndexResult.has_value())
-      {
-        int32_t partitionID = *partitionIndexResult + m_StartingPartitionID;
-        maxValue = partitionID > maxValue ? partitionID : maxValue;
-        partitionIds.setValue(idx, partitionID);
-      }
-      else
-      {
-        partitionIds.setValue(idx, outOfBoundsValue);
-      }
+      int64_t count = blockBuckets[block * (numPartitions + 1) + bucket];
+      blockBuckets[block * (numPartitions + 1) + bucket] = offset;
+      offset += count;
+    }
+    if(bucket < numPartitions)
+    {
+      rangesPtr->setComponent(bucket, 1, offset);
     }
   }
 
-  AttributeMatrix::Pointer featureAM = getDataContainerArray()->getAttributeMatrix({m_AttributeMatrixPath.getDataContainerName(), m_FeatureAttributeMatrixName, ""});
-  featureAM->setTupleDimensions({maxValue + 1});
+  dataAlg.execute(Detail::PartitionIndexListsImpl(partitionIds.getPointer(0), numElements, blockSize, numPartitions, blockBuckets, elementIndicesPtr->getPointer(0)));
 }
 
 // -----------------------------------------------------------------------------
@@ -1407,6 +1655,42 @@ QString PartitionGeometry::getPartitionIdsArrayName() const
   return m_PartitionIdsArrayName;
 }
 
+// -----------------------------------------------------------------------------
+void PartitionGeometry::setCreatePartitionIndexLists(const bool& value)
+{
+  m_CreatePartitionIndexLists = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PartitionGeometry::getCreatePartitionIndexLists() const
+{
+  return m_CreatePartitionIndexLists;
+}
+
+// -----------------------------------------------------------------------------
+void PartitionGeometry::setPartitionElementIndicesArrayName(const QString& value)
+{
+  m_PartitionElementIndicesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString PartitionGeometry::getPartitionElementIndicesArrayName() const
+{
+  return m_PartitionElementIndicesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void PartitionGeometry::setPartitionElementRangesArrayName(const QString& value)
+{
+  m_PartitionElementRangesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString PartitionGeometry::getPartitionElementRangesArrayName() const
+{
+  return m_PartitionElementRangesArrayName;
+}
+
 // -----------------------------------------------------------------------------
 QString PartitionGeometry::getInputImageGeometryInformation(const ImageGeom& geometry) const
 {
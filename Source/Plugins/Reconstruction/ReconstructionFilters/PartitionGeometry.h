@@ -67,6 +67,9 @@ class Reconstruction_EXPORT PartitionGeometry : public AbstractFilter
   PYB11_PROPERTY(QString PartitioningSchemeInformation READ getPartitioningSchemeInformation)
   PYB11_PROPERTY(QString FeatureAttributeMatrixName READ getFeatureAttributeMatrixName WRITE setFeatureAttributeMatrixName)
   PYB11_PROPERTY(QString PartitionIdsArrayName READ getPartitionIdsArrayName WRITE setPartitionIdsArrayName)
+  PYB11_PROPERTY(bool CreatePartitionIndexLists READ getCreatePartitionIndexLists WRITE setCreatePartitionIndexLists)
+  PYB11_PROPERTY(QString PartitionElementIndicesArrayName READ getPartitionElementIndicesArrayName WRITE setPartitionElementIndicesArrayName)
+  PYB11_PROPERTY(QString PartitionElementRangesArrayName READ getPartitionElementRangesArrayName WRITE setPartitionElementRangesArrayName)
   PYB11_PROPERTY(bool SavePartitioningScheme READ getSavePartitioningScheme WRITE setSavePartitioningScheme)
   PYB11_PROPERTY(DataArrayPath PSDataContainerPath READ getPSDataContainerPath WRITE setPSDataContainerPath)
   PYB11_PROPERTY(QString PSAttributeMatrixName READ getPSAttributeMatrixName WRITE setPSAttributeMatrixName)
@@ -260,6 +263,39 @@ public:
   QString getPartitionIdsArrayName() const;
   Q_PROPERTY(QString PartitionIdsArrayName READ getPartitionIdsArrayName WRITE setPartitionIdsArrayName)
 
+  /**
+   * @brief Setter property for CreatePartitionIndexLists
+   */
+  void setCreatePartitionIndexLists(const bool& value);
+  /**
+   * @brief Getter property for CreatePartitionIndexLists
+   * @return Value of CreatePartitionIndexLists
+   */
+  bool getCreatePartitionIndexLists() const;
+  Q_PROPERTY(bool CreatePartitionIndexLists READ getCreatePartitionIndexLists WRITE setCreatePartitionIndexLists)
+
+  /**
+   * @brief Setter property for PartitionElementIndicesArrayName
+   */
+  void setPartitionElementIndicesArrayName(const QString& value);
+  /**
+   * @brief Getter property for PartitionElementIndicesArrayName
+   * @return Value of PartitionElementIndicesArrayName
+   */
+  QString getPartitionElementIndicesArrayName() const;
+  Q_PROPERTY(QString PartitionElementIndicesArrayName READ getPartitionElementIndicesArrayName WRITE setPartitionElementIndicesArrayName)
+
+  /**
+   * @brief Setter property for PartitionElementRangesArrayName
+   */
+  void setPartitionElementRangesArrayName(const QString& value);
+  /**
+   * @brief Getter property for PartitionElementRangesArrayName
+   * @return Value of PartitionElementRangesArrayName
+   */
+  QString getPartitionElementRangesArrayName() const;
+  Q_PROPERTY(QString PartitionElementRangesArrayName READ getPartitionElementRangesArrayName WRITE setPartitionElementRangesArrayName)
+
   /**
    * @brief Setter property for SavePartitioningScheme
    */
@@ -396,6 +432,9 @@ private:
   FloatVec3Type m_UpperRightCoord = {1, 1, 1};
   bool m_SavePartitioningScheme = {false};
   QString m_PartitionIdsArrayName = {"PartitioningSchemeIds"};
+  bool m_CreatePartitionIndexLists = {false};
+  QString m_PartitionElementIndicesArrayName = {"PartitionElementIndices"};
+  QString m_PartitionElementRangesArrayName = {"PartitionElementRanges"};
   DataArrayPath m_PSDataContainerPath = {"PartitioningSchemeDataContainer", "", ""};
   QString m_PSAttributeMatrixName = {"CellData"};
   QString m_PSDataArrayName = m_PartitionIdsArrayName;
@@ -413,6 +452,7 @@ private:
   int32_t* m_PartitionIds = nullptr;
   std::weak_ptr<Int32ArrayType> m_PartitioningSchemeIdsPtr;
   int32_t* m_PartitioningSchemeIds = nullptr;
+  std::weak_ptr<Int64ArrayType> m_PartitionElementIndicesPtr;
   PartitioningImageGeomResult m_PartitionImageGeometryResult;
 
   /**
@@ -533,6 +573,13 @@ private:
    */
   void partitionNodeBasedGeometry(const QString& geomName, const SharedVertexList& vertexList, Int32ArrayType& partitionIds, int outOfBoundsValue);
 
+  /**
+   * @brief createPartitionIndexLists Groups the element indices by partition id (CSR layout). The element indices array holds the
+   * indices of each partition one after the other, in increasing element order, followed by the elements whose id is not a partition.
+   * The ranges array holds the [start, end) range of each partition within the element indices array.
+   */
+  void createPartitionIndexLists(const Int32ArrayType& partitionIds);
+
 public:
   PartitionGeometry(const PartitionGeometry&) = delete;            // Copy Constructor Not Implemented
   PartitionGeometry& operator=(const PartitionGeometry&) = delete; // Copy Assignment Not Implemented
@@ -0,0 +1,495 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#endif
+
+/**
+ * @brief The CAxisHemisphereBins class bins c-axis directions on a square grid laid over the Lambert equal area
+ * projection of the upper hemisphere; c-axes have no sign, so every axis is flipped into the upper hemisphere
+ * first. For each bin it stores the bins that are aligned with it to within the c-axis tolerance for every pair
+ * of axes they can hold ("full" bins), and the bins that are aligned for only some of those pairs ("rim" bins).
+ * The number of c-axes aligned with a given c-axis is then the sum of the full bin counts plus an exact check of
+ * the c-axes in the rim bins, which gives the same counts as comparing every pair of c-axes.
+ */
+class CAxisHemisphereBins
+{
+public:
+  CAxisHemisphereBins(float caxisTol)
+  : m_CAxisTolerance(caxisTol)
+  {
+    const double k_DiskRadius = std::sqrt(2.0);
+    // Keeps float rounding in the exact check from disagreeing with the bin bounds
+    const double k_AngleMargin = 1.0E-3;
+    // Narrower bins would thin the band of rim bins, whose c-axes are checked one by one, but the bin lists grow
+    // with the fourth power of the bins per tolerance
+    const double k_BinsPerTolerance = 4.0;
+    const int64_t k_MaxDim = 512;
+    const double tolerance = static_cast<double>(caxisTol);
+    m_Dim = static_cast<int64_t>(std::ceil(2.0 * k_DiskRadius / std::max(tolerance / k_BinsPerTolerance, 1.0E-6)));
+    m_Dim = std::min(std::max<int64_t>(m_Dim, 1), k_MaxDim);
+    m_BinWidth = 2.0f * static_cast<float>(k_DiskRadius) / static_cast<float>(m_Dim);
+    const double binWidth = static_cast<double>(m_BinWidth);
+
+    // The inverse projection stretches distances by at most sqrt(2), so every axis of a bin whose center lies in
+    // the disk is within one bin width of the center direction. Centers outside the disk are moved onto the rim,
+    // which at most doubles that radius.
+    size_t numBins = static_cast<size_t>(m_Dim * m_Dim);
+    std::vector<double> centers(3 * numBins);
+    std::vector<int32_t> radii(numBins);
+    std::vector<bool> reachable(numBins, false);
+    for(int64_t iy = 0; iy < m_Dim; iy++)
+    {
+      for(int64_t ix = 0; ix < m_Dim; ix++)
+      {
+        size_t bin = static_cast<size_t>(iy * m_Dim + ix);
+        double px = -k_DiskRadius + (static_cast<double>(ix) + 0.5) * binWidth;
+        double py = -k_DiskRadius + (static_cast<double>(iy) + 0.5) * binWidth;
+        double dx = std::max(std::fabs(px) - 0.5 * binWidth, 0.0);
+        double dy = std::max(std::fabs(py) - 0.5 * binWidth, 0.0);
+        reachable[bin] = dx * dx + dy * dy <= 2.0 + 1.0E-4;
+        double r = std::sqrt(px * px + py * py);
+        radii[bin] = 1;
+        if(r > k_DiskRadius)
+        {
+          px *= k_DiskRadius / r;
+          py *= k_DiskRadius / r;
+          radii[bin] = 2;
+        }
+        double r2 = std::min(px * px + py * py, 2.0);
+        double scale = std::sqrt(1.0 - r2 / 4.0);
+        centers[3 * bin + 0] = px * scale;
+        centers[3 * bin + 1] = py * scale;
+        centers[3 * bin + 2] = 1.0 - r2 / 2.0;
+      }
+    }
+
+    // The projection stretches angles by at most sqrt(2), so axes that are aligned lie within this window of each
+    // other in the projected plane. Near the rim an aligned axis can also sit on the opposite side of the disk,
+    // since its other end was flipped into the upper hemisphere; such a pair is within twice that distance of
+    // the mirrored position, and only for axes within the first distance of the rim.
+    int64_t windowBins = static_cast<int64_t>(std::ceil(k_DiskRadius * tolerance / binWidth)) + 1;
+    int64_t mirroredWindowBins = static_cast<int64_t>(std::ceil(2.0 * k_DiskRadius * tolerance / binWidth)) + 1;
+    double mirroredRadius = k_DiskRadius - k_DiskRadius * tolerance - binWidth;
+    // Two bins are full bins of each other when their centers are within the tolerance less both radii, and
+    // rim bins when within the tolerance plus both radii. The radii add up to 2 to 4 bin widths; the angle
+    // between two c-axes is at most 90 degrees, so the bounds become thresholds on the absolute cosine.
+    double fullCosine[5] = {2.0, 2.0, 2.0, 2.0, 2.0};
+    double rimCosine[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    for(int32_t widths = 2; widths <= 4; widths++)
+    {
+      double spread = static_cast<double>(widths) * binWidth + k_AngleMargin;
+      if(tolerance - spread >= 0.0)
+      {
+        fullCosine[widths] = std::cos(tolerance - spread);
+      }
+      if(tolerance + spread < SIMPLib::Constants::k_PiD / 2.0)
+      {
+        rimCosine[widths] = std::cos(tolerance + spread);
+      }
+    }
+    m_FullOffsets.assign(numBins + 1, 0);
+    m_RimOffsets.assign(numBins + 1, 0);
+    std::vector<int32_t> candidates;
+    for(size_t bin = 0; bin < numBins; bin++)
+    {
+      candidates.clear();
+      if(reachable[bin])
+      {
+        int64_t ix = static_cast<int64_t>(bin) % m_Dim;
+        int64_t iy = static_cast<int64_t>(bin) / m_Dim;
+        addCandidates(ix, iy, windowBins, -1, -1, -1, reachable, candidates);
+        double px = -k_DiskRadius + (static_cast<double>(ix) + 0.5) * binWidth;
+        double py = -k_DiskRadius + (static_cast<double>(iy) + 0.5) * binWidth;
+        if(std::sqrt(px * px + py * py) >= mirroredRadius)
+        {
+          addCandidates(m_Dim - 1 - ix, m_Dim - 1 - iy, mirroredWindowBins, ix, iy, windowBins, reachable, candidates);
+        }
+        for(const auto& candidate : candidates)
+        {
+          double cosAngle = std::fabs(centers[3 * bin + 0] * centers[3 * candidate + 0] + centers[3 * bin + 1] * centers[3 * candidate + 1] + centers[3 * bin + 2] * centers[3 * candidate + 2]);
+          int32_t widths = radii[bin] + radii[candidate];
+          if(cosAngle >= fullCosine[widths])
+          {
+            m_Full.push_back(candidate);
+          }
+          else if(cosAngle >= rimCosine[widths])
+          {
+            m_Rim.push_back(candidate);
+          }
+        }
+      }
+      m_FullOffsets[bin + 1] = m_Full.size();
+      m_RimOffsets[bin + 1] = m_Rim.size();
+    }
+  }
+
+  ~CAxisHemisphereBins() = default;
+
+  CAxisHemisphereBins(const CAxisHemisphereBins&) = delete;            // Copy Constructor Not Implemented
+  CAxisHemisphereBins(CAxisHemisphereBins&&) = delete;                 // Move Constructor Not Implemented
+  CAxisHemisphereBins& operator=(const CAxisHemisphereBins&) = delete; // Copy Assignment Not Implemented
+  CAxisHemisphereBins& operator=(CAxisHemisphereBins&&) = delete;      // Move Assignment Not Implemented
+
+  size_t getNumberOfBins() const
+  {
+    return static_cast<size_t>(m_Dim * m_Dim);
+  }
+
+  /**
+   * @brief getBin Returns the bin of a unit c-axis
+   */
+  size_t getBin(const float* caxis) const
+  {
+    const float k_DiskRadius = std::sqrt(2.0f);
+    float sign = caxis[2] < 0.0f ? -1.0f : 1.0f;
+    float scale = std::sqrt(2.0f / (1.0f + sign * caxis[2]));
+    if(!std::isfinite(scale))
+    {
+      scale = 0.0f;
+    }
+    float px = sign * caxis[0] * scale;
+    float py = sign * caxis[1] * scale;
+    int64_t ix = static_cast<int64_t>((px + k_DiskRadius) / m_BinWidth);
+    int64_t iy = static_cast<int64_t>((py + k_DiskRadius) / m_BinWidth);
+    ix = std::min(std::max<int64_t>(ix, 0), m_Dim - 1);
+    iy = std::min(std::max<int64_t>(iy, 0), m_Dim - 1);
+    return static_cast<size_t>(iy * m_Dim + ix);
+  }
+
+  /**
+   * @brief isAligned The test the pairwise loop uses: two c-axes are aligned when the angle between them, or
+   * its supplement, is within the tolerance
+   */
+  bool isAligned(const float* caxis1, const float* caxis2) const
+  {
+    float angle = GeometryMath::AngleBetweenVectors(caxis1, caxis2);
+    return angle <= m_CAxisTolerance || (SIMPLib::Constants::k_PiD - angle) <= m_CAxisTolerance;
+  }
+
+  /**
+   * @brief countFullyAligned Sums the bin counts of every full bin of the given bin, which can include the bin
+   * itself
+   */
+  int64_t countFullyAligned(size_t bin, const std::vector<int64_t>& binCounts) const
+  {
+    int64_t total = 0;
+    for(size_t n = m_FullOffsets[bin]; n < m_FullOffsets[bin + 1]; n++)
+    {
+      total += binCounts[m_Full[n]];
+    }
+    return total;
+  }
+
+  /**
+   * @brief countRimAligned Counts the c-axes of the rim bins of the given bin that are aligned with the c-axis.
+   * The c-axes of a bin are binnedAxes[binStarts[bin]] to binnedAxes[binStarts[bin] + binCounts[bin] - 1].
+   */
+  int64_t countRimAligned(size_t bin, const float* caxis, const float* caxes, const std::vector<int64_t>& binCounts, const std::vector<int64_t>& binStarts,
+                          const std::vector<int64_t>& binnedAxes) const
+  {
+    int64_t total = 0;
+    for(size_t n = m_RimOffsets[bin]; n < m_RimOffsets[bin + 1]; n++)
+    {
+      int32_t rimBin = m_Rim[n];
+      for(int64_t a = binStarts[rimBin]; a < binStarts[rimBin] + binCounts[rimBin]; a++)
+      {
+        if(isAligned(caxis, caxes + 3 * binnedAxes[a]))
+        {
+          total++;
+        }
+      }
+    }
+    return total;
+  }
+
+private:
+  float m_CAxisTolerance = 0.0f;
+  int64_t m_Dim = 1;
+  float m_BinWidth = 1.0f;
+  std::vector<size_t> m_FullOffsets;
+  std::vector<int32_t> m_Full;
+  std::vector<size_t> m_RimOffsets;
+  std::vector<int32_t> m_Rim;
+
+  /**
+   * @brief addCandidates Adds the reachable bins of the window around bin (ix, iy) that are not in the window
+   * around bin (excludeX, excludeY), so that the mirrored window does not repeat bins of the direct window
+   */
+  void addCandidates(int64_t ix, int64_t iy, int64_t windowBins, int64_t excludeX, int64_t excludeY, int64_t excludeBins, const std::vector<bool>& reachable, std::vector<int32_t>& candidates) const
+  {
+    for(int64_t y = std::max<int64_t>(iy - windowBins, 0); y <= std::min(iy + windowBins, m_Dim - 1); y++)
+    {
+      for(int64_t x = std::max<int64_t>(ix - windowBins, 0); x <= std::min(ix + windowBins, m_Dim - 1); x++)
+      {
+        int32_t candidate = static_cast<int32_t>(y * m_Dim + x);
+        bool excluded = std::abs(x - excludeX) <= excludeBins && std::abs(y - excludeY) <= excludeBins;
+        if(reachable[candidate] && !excluded)
+        {
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief The FindPatchMisalignmentsImpl class implements a threaded algorithm that determines the misorientations
+ * between for all cell faces in the structure
+ */
+class FindPatchMisalignmentsImpl
+{
+public:
+  FindPatchMisalignmentsImpl(int64_t* newDims, int64_t* origDims, float* caxisLocs, int32_t* phases, uint32_t* crystructs, float* volFrac, float* avgCAxis, bool* inMTR, int64_t* critDim,
+                             float minVolFrac, float caxisTol, const CAxisHemisphereBins* caxisBins)
+  : m_DicDims(newDims)
+  , m_VolDims(origDims)
+  , m_CAxisLocations(caxisLocs)
+  , m_CellPhases(phases)
+  , m_CrystalStructures(crystructs)
+  , m_InMTR(inMTR)
+  , m_VolFrac(volFrac)
+  , m_AvgCAxis(avgCAxis)
+  , m_CritDim(critDim)
+  , m_MinVolFrac(minVolFrac)
+  , m_CAxisTolerance(caxisTol)
+  , m_CAxisBins(caxisBins)
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  virtual ~FindPatchMisalignmentsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    int64_t xDim = (2 * m_CritDim[0]) + 1;
+    int64_t yDim = (2 * m_CritDim[1]) + 1;
+    int64_t zDim = (2 * m_CritDim[2]) + 1;
+    std::vector<size_t> tDims(1, xDim * yDim * zDim);
+    std::vector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer cAxisLocsPtr = FloatArrayType::CreateArray(tDims, cDims, "_INTERNAL_USE_ONLY_cAxisLocs", true);
+    cAxisLocsPtr->initializeWithValue(0);
+    float* cAxisLocs = cAxisLocsPtr->getPointer(0);
+    std::vector<int64_t> goodCounts;
+    std::vector<int64_t> binCounts;
+    std::vector<int64_t> alignedCounts;
+    std::vector<int64_t> binStarts;
+    std::vector<int64_t> binFill;
+    std::vector<int64_t> binnedAxes;
+    std::vector<size_t> axisBins;
+    std::vector<size_t> occupiedBins;
+    if(nullptr != m_CAxisBins)
+    {
+      binCounts.assign(m_CAxisBins->getNumberOfBins(), 0);
+      alignedCounts.assign(m_CAxisBins->getNumberOfBins(), -1);
+      binStarts.assign(m_CAxisBins->getNumberOfBins(), 0);
+      binFill.assign(m_CAxisBins->getNumberOfBins(), 0);
+    }
+
+    int64_t xc = 0, yc = 0, zc = 0;
+    for(size_t iter = start; iter < end; iter++)
+    {
+      int64_t zStride = 0, yStride = 0;
+      int64_t count = 0;
+      xc = ((iter % m_DicDims[0]) * m_CritDim[0]) + (m_CritDim[0] / 2);
+      yc = (((iter / m_DicDims[0]) % m_DicDims[1]) * m_CritDim[1]) + (m_CritDim[1] / 2);
+      zc = ((iter / (m_DicDims[0] * m_DicDims[1])) * m_CritDim[2]) + (m_CritDim[2] / 2);
+      for(int64_t k = -m_CritDim[2]; k <= m_CritDim[2]; k++)
+      {
+        if((zc + k) >= 0 && (zc + k) < m_VolDims[2])
+        {
+          zStride = ((zc + k) * m_VolDims[0] * m_VolDims[1]);
+          for(int64_t j = -m_CritDim[1]; j <= m_CritDim[1]; j++)
+          {
+            if((yc + j) >= 0 && (yc + j) < m_VolDims[1])
+            {
+              yStride = ((yc + j) * m_VolDims[0]);
+              for(int64_t i = -m_CritDim[0]; i <= m_CritDim[0]; i++)
+              {
+                if((xc + i) >= 0 && (xc + i) < m_VolDims[0])
+                {
+                  if(m_CrystalStructures[m_CellPhases[(zStride + yStride + xc + i)]] == EbsdLib::CrystalStructure::Hexagonal_High)
+                  {
+                    cAxisLocs[3 * count + 0] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 0];
+                    cAxisLocs[3 * count + 1] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 1];
+                    cAxisLocs[3 * count + 2] = m_CAxisLocations[3 * (zStride + yStride + xc + i) + 2];
+                    count++;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+      float angle = 0.0f;
+      goodCounts.resize(count);
+      goodCounts.assign(count, 0);
+      if(nullptr != m_CAxisBins)
+      {
+        // Bucket the c-axes of the patch by bin so the rim bins can be checked axis by axis
+        axisBins.resize(count);
+        occupiedBins.clear();
+        for(int64_t i = 0; i < count; i++)
+        {
+          axisBins[i] = m_CAxisBins->getBin(cAxisLocs + 3 * i);
+          if(binCounts[axisBins[i]]++ == 0)
+          {
+            occupiedBins.push_back(axisBins[i]);
+          }
+        }
+        int64_t start = 0;
+        for(const auto& bin : occupiedBins)
+        {
+          binStarts[bin] = start;
+          binFill[bin] = start;
+          start += binCounts[bin];
+        }
+        binnedAxes.resize(count);
+        for(int64_t i = 0; i < count; i++)
+        {
+          binnedAxes[binFill[axisBins[i]]++] = i;
+        }
+        // The pairwise loop below counts each c-axis against itself twice, hence the extra one
+        for(int64_t i = 0; i < count; i++)
+        {
+          int64_t& aligned = alignedCounts[axisBins[i]];
+          if(aligned < 0)
+          {
+            aligned = m_CAxisBins->countFullyAligned(axisBins[i], binCounts);
+          }
+          goodCounts[i] = aligned + m_CAxisBins->countRimAligned(axisBins[i], cAxisLocs + 3 * i, cAxisLocs, binCounts, binStarts, binnedAxes) + 1;
+        }
+        for(const auto& bin : occupiedBins)
+        {
+          binCounts[bin] = 0;
+          alignedCounts[bin] = -1;
+        }
+      }
+      else
+      {
+        for(int64_t i = 0; i < count; i++)
+        {
+          for(int64_t j = i; j < count; j++)
+          {
+            angle = GeometryMath::AngleBetweenVectors(cAxisLocsPtr->getPointer(3 * i), cAxisLocsPtr->getPointer(3 * j));
+            if(angle <= m_CAxisTolerance || (SIMPLib::Constants::k_PiD - angle) <= m_CAxisTolerance)
+            {
+              goodCounts[i]++;
+              goodCounts[j]++;
+            }
+          }
+        }
+      }
+      int64_t goodPointCount = 0;
+      for(int64_t i = 0; i < count; i++)
+      {
+        if(float(goodCounts[i]) / float(count) > m_MinVolFrac)
+        {
+          goodPointCount++;
+        }
+      }
+      float avgCAxis[3] = {0.0f, 0.0f, 0.0f};
+      float frac = float(goodPointCount) / float(count);
+      m_VolFrac[iter] = frac;
+      if(frac > m_MinVolFrac)
+      {
+        m_InMTR[iter] = true;
+        for(int64_t i = 0; i < count; i++)
+        {
+          if(float(goodCounts[i]) / float(count) >= m_MinVolFrac)
+          {
+            if(MatrixMath::DotProduct3x1(avgCAxis, cAxisLocsPtr->getPointer(3 * i)) < 0)
+            {
+              avgCAxis[0] -= cAxisLocs[3 * i];
+              avgCAxis[1] -= cAxisLocs[3 * i + 1];
+              avgCAxis[2] -= cAxisLocs[3 * i + 2];
+            }
+            else
+            {
+              avgCAxis[0] += cAxisLocs[3 * i];
+              avgCAxis[1] += cAxisLocs[3 * i + 1];
+              avgCAxis[2] += cAxisLocs[3 * i + 2];
+            }
+          }
+        }
+        MatrixMath::Normalize3x1(avgCAxis);
+        if(avgCAxis[2] < 0)
+        {
+          MatrixMath::Multiply3x1withConstant(avgCAxis, -1.0f);
+        }
+        m_AvgCAxis[3 * iter] = avgCAxis[0];
+        m_AvgCAxis[3 * iter + 1] = avgCAxis[1];
+        m_AvgCAxis[3 * iter + 2] = avgCAxis[2];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  int64_t* m_DicDims;
+  int64_t* m_VolDims;
+  float* m_CAxisLocations;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  bool* m_InMTR;
+  float* m_VolFrac;
+  float* m_AvgCAxis;
+  int64_t* m_CritDim;
+  float m_MinVolFrac;
+  float m_CAxisTolerance;
+  const CAxisHemisphereBins* m_CAxisBins = nullptr;
+};
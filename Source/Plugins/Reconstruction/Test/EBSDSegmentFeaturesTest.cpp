@@ -0,0 +1,247 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/Utils/CellFaceMisorientations.hpp"
+#include "Reconstruction/ReconstructionFilters/EBSDSegmentFeatures.h"
+#include "ReconstructionTestFileLocations.h"
+
+class EBSDSegmentFeaturesTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_FeatureDataName = {"Grain Data"};
+  const QString k_QuatsName = {"Quats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_GoodVoxelsName = {"GoodVoxels"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_FaceMisorientationsName = {"FaceMisorientations"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_ActiveName = {"Active"};
+
+  static constexpr size_t k_XSize = 6;
+  static constexpr size_t k_YSize = 5;
+  static constexpr size_t k_ZSize = 3;
+
+public:
+  EBSDSegmentFeaturesTest() = default;
+  ~EBSDSegmentFeaturesTest() = default;
+
+  EBSDSegmentFeaturesTest(const EBSDSegmentFeaturesTest&) = delete;            // Copy Constructor
+  EBSDSegmentFeaturesTest(EBSDSegmentFeaturesTest&&) = delete;                 // Move Constructor
+  EBSDSegmentFeaturesTest& operator=(const EBSDSegmentFeaturesTest&) = delete; // Copy Assignment
+  EBSDSegmentFeaturesTest& operator=(EBSDSegmentFeaturesTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  size_t cellIndex(size_t x, size_t y, size_t z) const
+  {
+    return (z * k_YSize + y) * k_XSize + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Three grains: cells with z == 2 and y >= 3 are rotated about X, the remaining cells with x < 3 are rotated
+  // about Z by a few hundredths of a radian and the others about Z by about 0.5 radians. Cell (0,0,0) is
+  // phase 0 and cell (1,2,1) is not a good voxel.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {k_XSize, k_YSize, k_ZSize};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(dims, {4ULL}, k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(dims, {1ULL}, k_PhasesName, true);
+    BoolArrayType::Pointer goodVoxels = BoolArrayType::CreateArray(dims, {1ULL}, k_GoodVoxelsName, true);
+
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        for(size_t x = 0; x < k_XSize; x++)
+        {
+          size_t i = cellIndex(x, y, z);
+          float angle = x < 3 ? 0.01F * static_cast<float>(i % 7) : 0.5F + 0.01F * static_cast<float>(i % 5);
+          if(z == 2 && y >= 3)
+          {
+            quats->setComponent(i, 0, std::sin(0.35F));
+            quats->setComponent(i, 1, 0.0F);
+            quats->setComponent(i, 2, 0.0F);
+            quats->setComponent(i, 3, std::cos(0.35F));
+          }
+          else
+          {
+            quats->setComponent(i, 0, 0.0F);
+            quats->setComponent(i, 1, 0.0F);
+            quats->setComponent(i, 2, std::sin(0.5F * angle));
+            quats->setComponent(i, 3, std::cos(0.5F * angle));
+          }
+          phases->setValue(i, 1);
+          goodVoxels->setValue(i, true);
+        }
+      }
+    }
+    phases->setValue(cellIndex(0, 0, 0), 0);
+    goodVoxels->setValue(cellIndex(1, 2, 1), false);
+
+    cellAM->insertOrAssign(quats);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(goodVoxels);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    // The same face misorientations FindCellFaceMisorientations would create
+    FloatArrayType::Pointer faces = FloatArrayType::CreateArray(dims, {3ULL}, k_FaceMisorientationsName, true);
+    const int64_t faceDims[3] = {static_cast<int64_t>(k_XSize), static_cast<int64_t>(k_YSize), static_cast<int64_t>(k_ZSize)};
+    CellFaceMisorientations::Compute(quats->getPointer(0), phases->getPointer(0), crystalStructures->getPointer(0), faceDims, faces->getPointer(0));
+    cellAM->insertOrAssign(faces);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  EBSDSegmentFeatures::Pointer createFilter(const DataContainerArray::Pointer& dca, bool useFaceMisorientations)
+  {
+    EBSDSegmentFeatures::Pointer filter = EBSDSegmentFeatures::New();
+    filter->setDataContainerArray(dca);
+    filter->setCellFeatureAttributeMatrixName(k_FeatureDataName);
+    filter->setMisorientationTolerance(5.0F);
+    filter->setUseGoodVoxels(true);
+    filter->setGoodVoxelsArrayPath({k_DataContainerName, k_CellDataName, k_GoodVoxelsName});
+    filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setQuatsArrayPath({k_DataContainerName, k_CellDataName, k_QuatsName});
+    filter->setUseFaceMisorientations(useFaceMisorientations);
+    filter->setFaceMisorientationsArrayPath({k_DataContainerName, k_CellDataName, k_FaceMisorientationsName});
+    filter->setFeatureIdsArrayName(k_FeatureIdsName);
+    filter->setActiveArrayName(k_ActiveName);
+    filter->setRandomizeFeatureIds(false);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The face misorientations must not change the segmentation
+  // -----------------------------------------------------------------------------
+  int TestFaceMisorientations()
+  {
+    std::vector<DataContainerArray::Pointer> results;
+    for(bool useFaceMisorientations : {false, true})
+    {
+      DataContainerArray::Pointer dca = createDataStructure();
+      EBSDSegmentFeatures::Pointer filter = createFilter(dca, useFaceMisorientations);
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+      dca = createDataStructure();
+      filter->setDataContainerArray(dca);
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+      results.push_back(dca);
+    }
+
+    for(const auto& dca : results)
+    {
+      DREAM3D_REQUIRE_EQUAL(dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""})->getNumberOfTuples(), 4);
+    }
+
+    Int32ArrayType::Pointer featureIds = results[0]->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    Int32ArrayType::Pointer faceFeatureIds = results[1]->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+    DREAM3D_REQUIRE_VALID_POINTER(faceFeatureIds.get());
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), faceFeatureIds->getValue(i));
+    }
+
+    // The phase 0 cell and the bad voxel are not part of any Feature
+    DREAM3D_REQUIRE_EQUAL(faceFeatureIds->getValue(cellIndex(0, 0, 0)), 0);
+    DREAM3D_REQUIRE_EQUAL(faceFeatureIds->getValue(cellIndex(1, 2, 1)), 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Faces holding k_NoMisorientation (a stale or unfilled array) must be computed directly. Every same-phase
+  // face between the two grains split at x == 3 is cleared, so using the -1 as an angle would merge them.
+  // -----------------------------------------------------------------------------
+  int TestUnfilledFaces()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    EBSDSegmentFeatures::Pointer filter = createFilter(dca, true);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    dca = createDataStructure();
+    FloatArrayType::Pointer faces = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<FloatArrayType>(k_FaceMisorientationsName);
+    DREAM3D_REQUIRE_VALID_POINTER(faces.get());
+    for(size_t z = 0; z < k_ZSize; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        faces->setComponent(cellIndex(2, y, z), 0, CellFaceMisorientations::k_NoMisorientation);
+      }
+    }
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    DREAM3D_REQUIRE_EQUAL(dca->getAttributeMatrix({k_DataContainerName, k_FeatureDataName, ""})->getNumberOfTuples(), 4);
+    Int32ArrayType::Pointer featureIds = dca->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+    for(size_t z = 0; z < 2; z++)
+    {
+      for(size_t y = 0; y < k_YSize; y++)
+      {
+        int32_t left = featureIds->getValue(cellIndex(2, y, z));
+        int32_t right = featureIds->getValue(cellIndex(3, y, z));
+        DREAM3D_REQUIRED(left, >, 0);
+        DREAM3D_REQUIRED(right, >, 0);
+        DREAM3D_REQUIRE(left != right);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFaceMisorientations())
+    DREAM3D_REGISTER_TEST(TestUnfilledFaces())
+  }
+
+private:
+};
@@ -0,0 +1,277 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Reconstruction/ReconstructionFilters/IdentifyMicroTextureRegions.h"
+#include "Reconstruction/ReconstructionFilters/Utils/CAxisPatchMisalignments.hpp"
+#include "ReconstructionTestFileLocations.h"
+
+class IdentifyMicroTextureRegionsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_EnsembleDataName = {"CellEnsembleData"};
+  const QString k_MTRDataName = {"MTRData"};
+  const QString k_CAxisLocationsName = {"CAxisLocations"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const QString k_MTRIdsName = {"MTRIds"};
+  const QString k_ActiveName = {"Active"};
+
+  static constexpr int64_t k_XSize = 16;
+  static constexpr int64_t k_YSize = 16;
+  static constexpr int64_t k_ZSize = 4;
+  static constexpr float k_CAxisToleranceDegrees = 5.0f;
+
+public:
+  IdentifyMicroTextureRegionsTest() = default;
+  ~IdentifyMicroTextureRegionsTest() = default;
+
+  IdentifyMicroTextureRegionsTest(const IdentifyMicroTextureRegionsTest&) = delete;            // Copy Constructor
+  IdentifyMicroTextureRegionsTest(IdentifyMicroTextureRegionsTest&&) = delete;                 // Move Constructor
+  IdentifyMicroTextureRegionsTest& operator=(const IdentifyMicroTextureRegionsTest&) = delete; // Copy Assignment
+  IdentifyMicroTextureRegionsTest& operator=(IdentifyMicroTextureRegionsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // Rotates the unit vector "axis" by "angle" radians towards a random perpendicular direction
+  // -----------------------------------------------------------------------------
+  void tiltAxis(const double* axis, double angle, std::mt19937& generator, float* result)
+  {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double perp[3] = {normal(generator), normal(generator), normal(generator)};
+    double dot = perp[0] * axis[0] + perp[1] * axis[1] + perp[2] * axis[2];
+    for(int c = 0; c < 3; c++)
+    {
+      perp[c] -= dot * axis[c];
+    }
+    double norm = std::sqrt(perp[0] * perp[0] + perp[1] * perp[1] + perp[2] * perp[2]);
+    for(int c = 0; c < 3; c++)
+    {
+      result[c] = static_cast<float>(std::cos(angle) * axis[c] + std::sin(angle) * perp[c] / norm);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The cells with x < 8 hold c-axes scattered around (0,0,1) and the others c-axes scattered around a direction
+  // in the equator plane, so that patches straddle the rim of the hemisphere. Many of the scatter angles are
+  // within a fraction of a degree of the tolerance (or of 180 degrees minus the tolerance), where the rim bins
+  // decide the counts. A few cells are random.
+  // -----------------------------------------------------------------------------
+  std::vector<float> createCAxes()
+  {
+    const double tolerance = k_CAxisToleranceDegrees * SIMPLib::Constants::k_PiD / 180.0;
+    const double k_Pole[3] = {0.0, 0.0, 1.0};
+    const double k_Equator[3] = {std::sqrt(0.5), -std::sqrt(0.5), 0.0};
+    std::mt19937 generator(5489u);
+    std::uniform_real_distribution<double> scatter(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    std::vector<float> caxes(static_cast<size_t>(3 * k_XSize * k_YSize * k_ZSize));
+    for(int64_t z = 0; z < k_ZSize; z++)
+    {
+      for(int64_t y = 0; y < k_YSize; y++)
+      {
+        for(int64_t x = 0; x < k_XSize; x++)
+        {
+          size_t i = static_cast<size_t>((z * k_YSize + y) * k_XSize + x);
+          const double* center = x < 8 ? k_Pole : k_Equator;
+          double choice = scatter(generator);
+          double angle = 0.0;
+          if(choice < 0.4)
+          {
+            angle = 0.5 * tolerance * scatter(generator);
+          }
+          else if(choice < 0.7)
+          {
+            angle = tolerance + 0.01 * (scatter(generator) - 0.5);
+          }
+          else if(choice < 0.9)
+          {
+            angle = SIMPLib::Constants::k_PiD - tolerance + 0.01 * (scatter(generator) - 0.5);
+          }
+          else
+          {
+            double random[3] = {normal(generator), normal(generator), normal(generator)};
+            double norm = std::sqrt(random[0] * random[0] + random[1] * random[1] + random[2] * random[2]);
+            for(int c = 0; c < 3; c++)
+            {
+              caxes[3 * i + c] = static_cast<float>(random[c] / norm);
+            }
+            continue;
+          }
+          tiltAxis(center, angle, generator, caxes.data() + 3 * i);
+        }
+      }
+    }
+    return caxes;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the patch kernel with and without the hemisphere bins; the volume fractions, the MTR flags and the
+  // average c-axes must be identical
+  // -----------------------------------------------------------------------------
+  int TestPatchVolumeFractions()
+  {
+    std::vector<float> caxes = createCAxes();
+    std::vector<int32_t> phases(caxes.size() / 3, 1);
+    uint32_t crystalStructures[2] = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Hexagonal_High};
+
+    const float tolerance = k_CAxisToleranceDegrees * SIMPLib::Constants::k_PiD / 180.0f;
+    CAxisHemisphereBins caxisBins(tolerance);
+
+    int64_t origDims[3] = {k_XSize, k_YSize, k_ZSize};
+    for(int64_t critSize : {1, 2, 3})
+    {
+      int64_t critDim[3] = {critSize, critSize, critSize};
+      int64_t newDims[3] = {k_XSize / critSize, k_YSize / critSize, k_ZSize / critSize};
+      size_t totalPatches = static_cast<size_t>(newDims[0] * newDims[1] * newDims[2]);
+      for(float minVolFrac : {0.1f, 0.3f, 0.5f})
+      {
+        std::vector<float> volFrac(totalPatches, 0.0f);
+        std::vector<float> avgCAxis(3 * totalPatches, 0.0f);
+        BoolArrayType::Pointer inMTR = BoolArrayType::CreateArray(totalPatches, std::string("InMTR"), true);
+        inMTR->initializeWithValue(false);
+        FindPatchMisalignmentsImpl pairwise(newDims, origDims, caxes.data(), phases.data(), crystalStructures, volFrac.data(), avgCAxis.data(), inMTR->getPointer(0), critDim, minVolFrac, tolerance,
+                                            nullptr);
+        pairwise.convert(0, totalPatches);
+
+        std::vector<float> binnedVolFrac(totalPatches, 0.0f);
+        std::vector<float> binnedAvgCAxis(3 * totalPatches, 0.0f);
+        BoolArrayType::Pointer binnedInMTR = BoolArrayType::CreateArray(totalPatches, std::string("BinnedInMTR"), true);
+        binnedInMTR->initializeWithValue(false);
+        FindPatchMisalignmentsImpl binned(newDims, origDims, caxes.data(), phases.data(), crystalStructures, binnedVolFrac.data(), binnedAvgCAxis.data(), binnedInMTR->getPointer(0), critDim,
+                                          minVolFrac, tolerance, &caxisBins);
+        binned.convert(0, totalPatches);
+
+        for(size_t patch = 0; patch < totalPatches; patch++)
+        {
+          DREAM3D_REQUIRE_EQUAL(volFrac[patch], binnedVolFrac[patch]);
+          DREAM3D_REQUIRE_EQUAL(inMTR->getValue(patch), binnedInMTR->getValue(patch));
+          for(size_t c = 0; c < 3; c++)
+          {
+            DREAM3D_REQUIRE_EQUAL(avgCAxis[3 * patch + c], binnedAvgCAxis[3 * patch + c]);
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {static_cast<size_t>(k_XSize), static_cast<size_t>(k_YSize), static_cast<size_t>(k_ZSize)};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer caxisLocations = FloatArrayType::CreateArray(dims, {3ULL}, k_CAxisLocationsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(dims, {1ULL}, k_PhasesName, true);
+    std::vector<float> caxes = createCAxes();
+    std::copy(caxes.begin(), caxes.end(), caxisLocations->getPointer(0));
+    phases->initializeWithValue(1);
+    cellAM->insertOrAssign(caxisLocations);
+    cellAM->insertOrAssign(phases);
+
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New({2}, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, std::string(k_CrystalStructuresName.toStdString()), true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Hexagonal_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runFilter(bool useCAxisBinning)
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    IdentifyMicroTextureRegions::Pointer filter = IdentifyMicroTextureRegions::New();
+    filter->setDataContainerArray(dca);
+    filter->setCAxisTolerance(k_CAxisToleranceDegrees);
+    filter->setMinMTRSize(8.0f);
+    filter->setMinVolFrac(0.3f);
+    filter->setUseCAxisBinning(useCAxisBinning);
+    filter->setCAxisLocationsArrayPath({k_DataContainerName, k_CellDataName, k_CAxisLocationsName});
+    filter->setCellPhasesArrayPath({k_DataContainerName, k_CellDataName, k_PhasesName});
+    filter->setCrystalStructuresArrayPath({k_DataContainerName, k_EnsembleDataName, k_CrystalStructuresName});
+    filter->setMTRIdsArrayName(k_MTRIdsName);
+    filter->setNewCellFeatureAttributeMatrixName(k_MTRDataName);
+    filter->setActiveArrayName(k_ActiveName);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    dca = createDataStructure();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Both modes must find the same microtexture regions
+  // -----------------------------------------------------------------------------
+  int TestCAxisBinning()
+  {
+    DataContainerArray::Pointer pairwise = runFilter(false);
+    DataContainerArray::Pointer binned = runFilter(true);
+
+    DREAM3D_REQUIRE_EQUAL(pairwise->getAttributeMatrix({k_DataContainerName, k_MTRDataName, ""})->getNumberOfTuples(),
+                          binned->getAttributeMatrix({k_DataContainerName, k_MTRDataName, ""})->getNumberOfTuples());
+
+    Int32ArrayType::Pointer mtrIds = pairwise->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_MTRIdsName);
+    Int32ArrayType::Pointer binnedMTRIds = binned->getAttributeMatrix({k_DataContainerName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_MTRIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(mtrIds.get());
+    DREAM3D_REQUIRE_VALID_POINTER(binnedMTRIds.get());
+    size_t numInMTR = 0;
+    for(size_t i = 0; i < mtrIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(mtrIds->getValue(i), binnedMTRIds->getValue(i));
+      numInMTR += mtrIds->getValue(i) > 0 ? 1 : 0;
+    }
+    DREAM3D_REQUIRED(numInMTR, >, 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPatchVolumeFractions())
+    DREAM3D_REGISTER_TEST(TestCAxisBinning())
+  }
+
+private:
+};
@@ -68,6 +68,7 @@ public:
       DREAM3D_REQUIRE(err >= 0)
     }
 
+    filter->setCreatePartitionIndexLists(true);
     filter->setDataContainerArray(dca);
     filter->execute();
     int err = filter->getErrorCode();
@@ -92,6 +93,65 @@ public:
       const int32_t exemplaryId = exemplaryPartitionIdsPtr[i];
       DREAM3D_REQUIRE_EQUAL(partitionId, exemplaryId)
     }
+
+    TestPartitionIndexLists(filter, dca, arrayPath, *partitionIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Each partition's range must cover exactly the elements with that partition id, in increasing order. The
+  // elements whose id is not a partition (out of bounds or masked) follow the last range.
+  // -----------------------------------------------------------------------------
+  void TestPartitionIndexLists(const PartitionGeometry::Pointer& filter, const DataContainerArray::Pointer& dca, const DataArrayPath& arrayPath, const Int32ArrayType& partitionIds)
+  {
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(arrayPath);
+    Int64ArrayType::Pointer elementIndices = am->getAttributeArrayAs<Int64ArrayType>(filter->getPartitionElementIndicesArrayName());
+    DREAM3D_REQUIRE(elementIndices != Int64ArrayType::NullPointer())
+
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix({arrayPath.getDataContainerName(), filter->getFeatureAttributeMatrixName(), ""});
+    DREAM3D_REQUIRE(featureAM != AttributeMatrix::NullPointer())
+    Int64ArrayType::Pointer ranges = featureAM->getAttributeArrayAs<Int64ArrayType>(filter->getPartitionElementRangesArrayName());
+    DREAM3D_REQUIRE(ranges != Int64ArrayType::NullPointer())
+
+    const size_t numElements = partitionIds.getNumberOfTuples();
+    const size_t numPartitions = featureAM->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(elementIndices->getNumberOfTuples(), numElements)
+    DREAM3D_REQUIRE_EQUAL(ranges->getNumberOfTuples(), numPartitions)
+
+    std::vector<size_t> partitionCounts(numPartitions, 0);
+    for(size_t i = 0; i < numElements; i++)
+    {
+      const int32_t partitionId = partitionIds.getValue(i);
+      if(partitionId >= 0 && static_cast<size_t>(partitionId) < numPartitions)
+      {
+        partitionCounts[partitionId]++;
+      }
+    }
+
+    int64_t expectedStart = 0;
+    for(size_t partition = 0; partition < numPartitions; partition++)
+    {
+      const int64_t start = ranges->getComponent(partition, 0);
+      const int64_t end = ranges->getComponent(partition, 1);
+      DREAM3D_REQUIRE_EQUAL(start, expectedStart)
+      DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(end - start), partitionCounts[partition])
+      for(int64_t i = start; i < end; i++)
+      {
+        const int64_t element = elementIndices->getValue(i);
+        DREAM3D_REQUIRE(element >= 0 && static_cast<size_t>(element) < numElements)
+        DREAM3D_REQUIRE_EQUAL(partitionIds.getValue(element), static_cast<int32_t>(partition))
+        DREAM3D_REQUIRE(i == start || element > elementIndices->getValue(i - 1))
+      }
+      expectedStart = end;
+    }
+
+    for(size_t i = static_cast<size_t>(expectedStart); i < numElements; i++)
+    {
+      const int64_t element = elementIndices->getValue(i);
+      DREAM3D_REQUIRE(element >= 0 && static_cast<size_t>(element) < numElements)
+      const int32_t partitionId = partitionIds.getValue(element);
+      DREAM3D_REQUIRE(partitionId < 0 || static_cast<size_t>(partitionId) >= numPartitions)
+      DREAM3D_REQUIRE(i == static_cast<size_t>(expectedStart) || element > elementIndices->getValue(i - 1))
+    }
   }
 
   // -----------------------------------------------------------------------------
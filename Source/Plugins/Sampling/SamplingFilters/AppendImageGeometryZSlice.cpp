@@ -42,6 +42,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiAttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Sampling/SamplingConstants.h"
@@ -68,6 +69,11 @@ void AppendImageGeometryZSlice::setupFilterParameters()
     AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Input Cell Data", InputAttributeMatrix, FilterParameter::Category::RequiredArray, AppendImageGeometryZSlice, req));
   }
+  {
+    MultiAttributeMatrixSelectionFilterParameter::RequirementType req =
+        MultiAttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_MAM_SELECTION_FP("Additional Input Cell Data", AdditionalInputAttributeMatrices, FilterParameter::Category::RequiredArray, AppendImageGeometryZSlice, req));
+  }
   {
     AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Destination Cell Data", DestinationAttributeMatrix, FilterParameter::Category::RequiredArray, AppendImageGeometryZSlice, req));
@@ -85,6 +91,7 @@ void AppendImageGeometryZSlice::readFilterParameters(AbstractFilterParametersRea
 {
   reader->openFilterGroup(this, index);
   setInputAttributeMatrix(reader->readDataArrayPath("InputAttributeMatrix", getInputAttributeMatrix()));
+  setAdditionalInputAttributeMatrices(reader->readDataArrayPathVector("AdditionalInputAttributeMatrices", getAdditionalInputAttributeMatrices()));
   setDestinationAttributeMatrix(reader->readDataArrayPath("DestinationAttributeMatrix", getDestinationAttributeMatrix()));
   setCheckResolution(reader->readValue("CheckResolution", getCheckResolution()));
   reader->closeFilterGroup();
@@ -100,82 +107,123 @@ void AppendImageGeometryZSlice::initialize()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AppendImageGeometryZSlice::dataCheck()
+std::vector<DataArrayPath> AppendImageGeometryZSlice::getInputAttributeMatrices() const
 {
-  clearErrorCode();
-  clearWarningCode();
-
-  // Validate the Source & Destination Attribute Matrix are available
-  AttributeMatrix::Pointer inputCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getInputAttributeMatrix(), -8201);
-  if(getErrorCode() < 0)
-  {
-    return;
-  }
+  std::vector<DataArrayPath> inputPaths = {getInputAttributeMatrix()};
+  inputPaths.insert(inputPaths.end(), m_AdditionalInputAttributeMatrices.begin(), m_AdditionalInputAttributeMatrices.end());
+  return inputPaths;
+}
 
-  AttributeMatrix::Pointer destCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getDestinationAttributeMatrix(), -8200);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t AppendImageGeometryZSlice::checkInputGeometry(const DataArrayPath& inputPath, const ImageGeom& destGeometry)
+{
+  AttributeMatrix::Pointer inputCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, inputPath, -8201);
   if(getErrorCode() < 0)
   {
-    return;
+    return 0;
   }
 
-  // Validate each AttributeMatrix is associated with an Image Geometry.
-  ImageGeom::Pointer inputGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputAttributeMatrix().getDataContainerName());
+  // Validate the AttributeMatrix is associated with an Image Geometry.
+  ImageGeom::Pointer inputGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, inputPath.getDataContainerName());
   if(nullptr == inputGeometry.get() || getErrorCode() < 0)
   {
-    return;
-  }
-
-  ImageGeom::Pointer destGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getDestinationAttributeMatrix().getDataContainerName());
-  if(nullptr == destGeometry.get() || getErrorCode() < 0)
-  {
-    return;
+    return 0;
   }
 
   // Get the Dimensions of the ImageGeometries
 
   SizeVec3Type inputGeomDims = inputGeometry->getDimensions();
 
-  SizeVec3Type destGeomDims = destGeometry->getDimensions();
+  SizeVec3Type destGeomDims = destGeometry.getDimensions();
 
   if(getCheckResolution())
   {
     FloatVec3Type inputRes = inputGeometry->getSpacing();
 
-    FloatVec3Type destRes = destGeometry->getSpacing();
+    FloatVec3Type destRes = destGeometry.getSpacing();
 
     if(inputRes[0] != destRes[0])
     {
-      QString ss = QObject::tr("Input X Spacing (%1) not equal to Destination X Spacing (%2)").arg(inputRes[0]).arg(destRes[0]);
+      QString ss = QObject::tr("Input X Spacing (%1) of '%2' not equal to Destination X Spacing (%3)").arg(inputRes[0]).arg(inputPath.serialize("/")).arg(destRes[0]);
       setErrorCondition(-8205, ss);
     }
     if(inputRes[1] != destRes[1])
     {
-      QString ss = QObject::tr("Input Y Spacing (%1) not equal to Destination Y Spacing (%2)").arg(inputRes[1]).arg(destRes[1]);
+      QString ss = QObject::tr("Input Y Spacing (%1) of '%2' not equal to Destination Y Spacing (%3)").arg(inputRes[1]).arg(inputPath.serialize("/")).arg(destRes[1]);
       setErrorCondition(-8206, ss);
     }
     if(inputRes[2] != destRes[2])
     {
-      QString ss = QObject::tr("Input Z Spacing (%1) not equal to Destination Z Spacing (%2)").arg(inputRes[2]).arg(destRes[2]);
+      QString ss = QObject::tr("Input Z Spacing (%1) of '%2' not equal to Destination Z Spacing (%3)").arg(inputRes[2]).arg(inputPath.serialize("/")).arg(destRes[2]);
       setErrorCondition(-8207, ss);
     }
   }
 
   if(destGeomDims[0] != inputGeomDims[0])
   {
-    QString ss = QObject::tr("Input X Dim (%1) not equal to Destination X Dim (%2)").arg(inputGeomDims[0]).arg(destGeomDims[0]);
+    QString ss = QObject::tr("Input X Dim (%1) of '%2' not equal to Destination X Dim (%3)").arg(inputGeomDims[0]).arg(inputPath.serialize("/")).arg(destGeomDims[0]);
     setErrorCondition(-8202, ss);
   }
 
   if(destGeomDims[1] != inputGeomDims[1])
   {
-    QString ss = QObject::tr("Input Y Dim (%1) not equal to Destination Y Dim (%2)").arg(inputGeomDims[1]).arg(destGeomDims[1]);
+    QString ss = QObject::tr("Input Y Dim (%1) of '%2' not equal to Destination Y Dim (%3)").arg(inputGeomDims[1]).arg(inputPath.serialize("/")).arg(destGeomDims[1]);
     setErrorCondition(-8203, ss);
   }
 
+  if(getErrorCode() < 0)
+  {
+    return 0;
+  }
+  return inputGeomDims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AppendImageGeometryZSlice::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+
+  // Validate the Destination Attribute Matrix is available
+  AttributeMatrix::Pointer destCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getDestinationAttributeMatrix(), -8200);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  ImageGeom::Pointer destGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getDestinationAttributeMatrix().getDataContainerName());
+  if(nullptr == destGeometry.get() || getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // Validate every input and count the Z slices that will be appended
+  size_t appendedSlices = 0;
+  for(const DataArrayPath& inputPath : getInputAttributeMatrices())
+  {
+    if(inputPath == getDestinationAttributeMatrix())
+    {
+      QString ss = QObject::tr("The Input Cell Data '%1' can not also be the Destination Cell Data").arg(inputPath.serialize("/"));
+      setErrorCondition(-8208, ss);
+      return;
+    }
+    appendedSlices += checkInputGeometry(inputPath, *destGeometry);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
   if(getInPreflight())
   {
+    SizeVec3Type destGeomDims = destGeometry->getDimensions();
+
     // We are only appending in the Z direction
-    destGeomDims[2] = destGeomDims[2] + inputGeomDims[2];
+    destGeomDims[2] = destGeomDims[2] + appendedSlices;
 
     // Update the existing z dimension of the image geometry and set that value back into the Image Geometry
     destGeometry->setDimensions(destGeomDims);
@@ -222,16 +270,19 @@ void AppendImageGeometryZSlice::execute()
     return;
   }
 
-  // Validate each AttributeMatrix is associated with an Image Geometry.
-  ImageGeom::Pointer inputGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputAttributeMatrix().getDataContainerName());
-
   ImageGeom::Pointer destGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getDestinationAttributeMatrix().getDataContainerName());
 
-  AttributeMatrix::Pointer inputCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getInputAttributeMatrix(), -8201);
-
   AttributeMatrix::Pointer destCellAttrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, getDestinationAttributeMatrix(), -8200);
 
-  SizeVec3Type inputGeomDims = inputGeometry->getDimensions();
+  std::vector<DataArrayPath> inputPaths = getInputAttributeMatrices();
+  std::vector<AttributeMatrix::Pointer> inputCellAttrMats;
+  size_t appendedSlices = 0;
+  for(const DataArrayPath& inputPath : inputPaths)
+  {
+    ImageGeom::Pointer inputGeometry = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, inputPath.getDataContainerName());
+    inputCellAttrMats.push_back(getDataContainerArray()->getPrereqAttributeMatrixFromPath(this, inputPath, -8201));
+    appendedSlices += inputGeometry->getDimensions()[2];
+  }
 
   SizeVec3Type destGeomDims = destGeometry->getDimensions();
 
@@ -245,31 +296,38 @@ void AppendImageGeometryZSlice::execute()
   }
 
   // We are only appending in the Z direction
-  destGeomDims[2] = destGeomDims[2] + inputGeomDims[2];
+  destGeomDims[2] = destGeomDims[2] + appendedSlices;
 
   // Now update the geometry with new dimension
   // Update the existing z dimension of the image geometry and set that value back into the Image Geometry
   destGeometry->setDimensions(destGeomDims);
 
+  // Resize the destination arrays a single time for all of the inputs so that appending many slices in one
+  // execution copies the existing volume only once
   std::vector<size_t> dgd = {destGeomDims[0], destGeomDims[1], destGeomDims[2]};
   destCellAttrMat->resizeAttributeArrays(dgd);
 
   QList<QString> voxelArrayNames = destCellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  for(const AttributeMatrix::Pointer& inputCellAttrMat : inputCellAttrMats)
   {
-    IDataArray::Pointer p = destCellAttrMat->getAttributeArray(*iter);
-    IDataArray::Pointer inputArray = inputCellAttrMat->getAttributeArray(*iter);
-    if(nullptr != inputArray.get())
-    {
-      p->copyFromArray(tupleOffset, inputArray);
-    }
-    else
+    for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
     {
-      QString ss = QObject::tr("Data Array '%1' does not exist in the Input Cell AttributeMatrix.").arg(*iter);
-      setWarningCondition(-8203, ss);
+      IDataArray::Pointer p = destCellAttrMat->getAttributeArray(*iter);
+      IDataArray::Pointer inputArray = inputCellAttrMat->getAttributeArray(*iter);
+      if(nullptr != inputArray.get())
+      {
+        p->copyFromArray(tupleOffset, inputArray);
+      }
+      else
+      {
+        QString ss = QObject::tr("Data Array '%1' does not exist in the Input Cell AttributeMatrix '%2'.").arg(*iter).arg(inputCellAttrMat->getName());
+        setWarningCondition(-8203, ss);
+      }
     }
+    tupleOffset += inputCellAttrMat->getNumberOfTuples();
   }
 }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -382,6 +440,18 @@ DataArrayPath AppendImageGeometryZSlice::getInputAttributeMatrix() const
   return m_InputAttributeMatrix;
 }
 
+// -----------------------------------------------------------------------------
+void AppendImageGeometryZSlice::setAdditionalInputAttributeMatrices(const std::vector<DataArrayPath>& value)
+{
+  m_AdditionalInputAttributeMatrices = value;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<DataArrayPath> AppendImageGeometryZSlice::getAdditionalInputAttributeMatrices() const
+{
+  return m_AdditionalInputAttributeMatrices;
+}
+
 // -----------------------------------------------------------------------------
 void AppendImageGeometryZSlice::setDestinationAttributeMatrix(const DataArrayPath& value)
 {
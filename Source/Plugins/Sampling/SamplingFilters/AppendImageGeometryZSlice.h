@@ -39,6 +39,7 @@
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Sampling/SamplingDLLExport.h"
 
@@ -55,6 +56,7 @@ class Sampling_EXPORT AppendImageGeometryZSlice : public AbstractFilter
   PYB11_SHARED_POINTERS(AppendImageGeometryZSlice)
   PYB11_FILTER_NEW_MACRO(AppendImageGeometryZSlice)
   PYB11_PROPERTY(DataArrayPath InputAttributeMatrix READ getInputAttributeMatrix WRITE setInputAttributeMatrix)
+  PYB11_PROPERTY(std::vector<DataArrayPath> AdditionalInputAttributeMatrices READ getAdditionalInputAttributeMatrices WRITE setAdditionalInputAttributeMatrices)
   PYB11_PROPERTY(DataArrayPath DestinationAttributeMatrix READ getDestinationAttributeMatrix WRITE setDestinationAttributeMatrix)
   PYB11_PROPERTY(bool CheckResolution READ getCheckResolution WRITE setCheckResolution)
   PYB11_END_BINDINGS()
@@ -101,6 +103,17 @@ public:
   DataArrayPath getInputAttributeMatrix() const;
   Q_PROPERTY(DataArrayPath InputAttributeMatrix READ getInputAttributeMatrix WRITE setInputAttributeMatrix)
 
+  /**
+   * @brief Setter property for AdditionalInputAttributeMatrices
+   */
+  void setAdditionalInputAttributeMatrices(const std::vector<DataArrayPath>& value);
+  /**
+   * @brief Getter property for AdditionalInputAttributeMatrices
+   * @return Value of AdditionalInputAttributeMatrices
+   */
+  std::vector<DataArrayPath> getAdditionalInputAttributeMatrices() const;
+  Q_PROPERTY(DataArrayPathVec AdditionalInputAttributeMatrices READ getAdditionalInputAttributeMatrices WRITE setAdditionalInputAttributeMatrices)
+
   /**
    * @brief Setter property for DestinationAttributeMatrix
    */
@@ -196,6 +209,21 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief getInputAttributeMatrices Returns the Input Cell Data followed by the Additional Input Cell Data, in
+   * the order that they are appended
+   */
+  std::vector<DataArrayPath> getInputAttributeMatrices() const;
+
+  /**
+   * @brief checkInputGeometry Validates that the Image Geometry of an input matches the destination in X & Y and,
+   * if requested, in spacing
+   * @param inputPath Path to the input Cell Attribute Matrix
+   * @param destGeometry The destination Image Geometry
+   * @return The number of Z slices of the input or 0 if the input is not valid
+   */
+  size_t checkInputGeometry(const DataArrayPath& inputPath, const ImageGeom& destGeometry);
+
 public:
   AppendImageGeometryZSlice(const AppendImageGeometryZSlice&) = delete;            // Copy Constructor Not Implemented
   AppendImageGeometryZSlice(AppendImageGeometryZSlice&&) = delete;                 // Move Constructor Not Implemented
@@ -204,6 +232,7 @@ public:
 
 private:
   DataArrayPath m_InputAttributeMatrix = {};
+  std::vector<DataArrayPath> m_AdditionalInputAttributeMatrices = {};
   DataArrayPath m_DestinationAttributeMatrix = {};
   bool m_CheckResolution = {false};
 };
@@ -34,10 +34,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "CropImageGeometry.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -52,6 +56,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingFilters/Utils/SamplingUtils.hpp"
@@ -62,6 +67,64 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief The CropDataArrayImpl class copies the kept voxels of a range of Z planes from the source array into
+ * the cropped array. The kept voxels of each row are contiguous in both arrays, so each row is a single block copy.
+ */
+template <typename T>
+class CropDataArrayImpl
+{
+public:
+  CropDataArrayImpl(const DataArray<T>& source, DataArray<T>& destination, const SizeVec3Type& sourceDims, const SizeVec3Type& minVoxel, const SizeVec3Type& croppedDims)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_SourceDims(sourceDims)
+  , m_MinVoxel(minVoxel)
+  , m_CroppedDims(croppedDims)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numComps = m_Source.getNumberOfComponents();
+    size_t rowLength = m_CroppedDims[0] * numComps;
+    for(size_t plane = range.min(); plane < range.max(); plane++)
+    {
+      for(size_t row = 0; row < m_CroppedDims[1]; row++)
+      {
+        size_t sourceIndex = ((plane + m_MinVoxel[2]) * m_SourceDims[0] * m_SourceDims[1]) + ((row + m_MinVoxel[1]) * m_SourceDims[0]) + m_MinVoxel[0];
+        size_t destIndex = (plane * m_CroppedDims[0] * m_CroppedDims[1]) + (row * m_CroppedDims[0]);
+        const T* sourcePtr = m_Source.getPointer(sourceIndex * numComps);
+        std::copy(sourcePtr, sourcePtr + rowLength, m_Destination.getPointer(destIndex * numComps));
+      }
+    }
+  }
+
+private:
+  const DataArray<T>& m_Source;
+  DataArray<T>& m_Destination;
+  SizeVec3Type m_SourceDims;
+  SizeVec3Type m_MinVoxel;
+  SizeVec3Type m_CroppedDims;
+};
+
+/**
+ * @brief CropDataArray Fills the cropped array from the source array, in parallel over the cropped Z planes
+ */
+template <typename T>
+void CropDataArray(IDataArray::Pointer source, IDataArray::Pointer destination, const SizeVec3Type& sourceDims, const SizeVec3Type& minVoxel, const SizeVec3Type& croppedDims)
+{
+  typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
+  typename DataArray<T>::Pointer destPtr = std::dynamic_pointer_cast<DataArray<T>>(destination);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, croppedDims[2]);
+  dataAlg.execute(CropDataArrayImpl<T>(*sourcePtr, *destPtr, sourceDims, minVoxel, croppedDims));
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -363,7 +426,8 @@ void CropImageGeometry::execute()
   // if(getErrorCode() < 0) { return; }
 
   DataContainer::Pointer srcCellDataContainer = getDataContainerArray()->getPrereqDataContainer(this, getCellAttributeMatrixPath().getDataContainerName());
-  AttributeMatrix::Pointer cellAttrMat = srcCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+  AttributeMatrix::Pointer srcCellAttrMat = srcCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+  AttributeMatrix::Pointer cellAttrMat = srcCellAttrMat;
   DataContainer::Pointer destCellDataContainer = srcCellDataContainer;
 
   if(getSaveAsNewDataContainer())
@@ -378,8 +442,8 @@ void CropImageGeometry::execute()
     image->setOrigin(o);
     image->setSpacing(r);
 
-    // Copy the cell data
-    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy(false);
+    // Copy the cell data structure only; the cropped values are copied straight from the source arrays below
+    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy(true);
     destCellDataContainer->addOrReplaceAttributeMatrix(cellAttrMatCopy);
     cellAttrMat = destCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   }
@@ -398,8 +462,6 @@ void CropImageGeometry::execute()
   }
 
   // No matter where the AM is (same DC or new DC), we have the correct DC and AM pointers...now it's time to crop
-  int64_t totalPoints = cellAttrMat->getNumberOfTuples();
-
   SizeVec3Type udims = srcCellDataContainer->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -411,6 +473,13 @@ void CropImageGeometry::execute()
   // Check to see if the dims have actually changed.
   if(dims[0] == (m_XMax - m_XMin) && dims[1] == (m_YMax - m_YMin) && dims[2] == (m_ZMax - m_ZMin))
   {
+    if(cellAttrMat != srcCellAttrMat)
+    {
+      for(const auto& da : srcCellAttrMat->getAttributeArrays())
+      {
+        cellAttrMat->addOrReplaceAttributeArray(da->deepCopy(false));
+      }
+    }
     return;
   }
 
@@ -452,49 +521,55 @@ void CropImageGeometry::execute()
   int64_t YP = ((m_YMax - m_YMin) + 1);
   int64_t ZP = ((m_ZMax - m_ZMin) + 1);
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
-  int64_t index = 0;
-  int64_t index_old = 0;
-  auto voxelArrays = cellAttrMat->getAttributeArrays();
-  for(int64_t i = 0; i < ZP; i++)
+  SizeVec3Type minVoxel = {static_cast<size_t>(m_XMin), static_cast<size_t>(m_YMin), static_cast<size_t>(m_ZMin)};
+  SizeVec3Type croppedDims = {static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP)};
+  size_t croppedPoints = croppedDims[0] * croppedDims[1] * croppedDims[2];
+
+  // Each array is cropped into a newly allocated array of a new Attribute Matrix that then replaces the
+  // original one, which lets the planes be copied in parallel even when cropping in place
+  std::vector<size_t> tDims = {croppedDims[0], croppedDims[1], croppedDims[2]};
+  AttributeMatrix::Pointer croppedCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
+  QList<QString> arrayNames = srcCellAttrMat->getAttributeArrayNames();
+  int32_t arrayIndex = 0;
+  for(const auto& arrayName : arrayNames)
   {
     if(getCancel())
     {
       break;
     }
-    QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
+    arrayIndex++;
+    QString ss = QObject::tr("Cropping Volume || Array %1 of %2").arg(arrayIndex).arg(arrayNames.size());
     notifyStatusMessage(ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
-    for(int64_t j = 0; j < YP; j++)
+
+    IDataArray::Pointer sourceArray = srcCellAttrMat->getAttributeArray(arrayName);
+    IDataArray::Pointer croppedArray = sourceArray->createNewArray(croppedPoints, sourceArray->getComponentDimensions(), sourceArray->getName(), true);
+    if(nullptr != std::dynamic_pointer_cast<StringDataArray>(sourceArray))
     {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
-      for(int64_t k = 0; k < XP; k++)
+      for(size_t plane = 0; plane < croppedDims[2]; plane++)
       {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for(auto& da : voxelArrays)
+        for(size_t row = 0; row < croppedDims[1]; row++)
         {
-          da->copyTuple(index_old, index);
+          for(size_t col = 0; col < croppedDims[0]; col++)
+          {
+            size_t index_old = ((plane + minVoxel[2]) * udims[0] * udims[1]) + ((row + minVoxel[1]) * udims[0]) + (col + minVoxel[0]);
+            size_t index = (plane * croppedDims[0] * croppedDims[1]) + (row * croppedDims[0]) + col;
+            croppedArray->copyFromArray(index, sourceArray, index_old, 1);
+          }
         }
       }
     }
+    else
+    {
+      EXECUTE_FUNCTION_TEMPLATE(this, CropDataArray, sourceArray, sourceArray, croppedArray, udims, minVoxel, croppedDims)
+    }
+    croppedCellAttrMat->insertOrAssign(croppedArray);
   }
   if(getCancel())
   {
     return;
   }
   destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
-  totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  std::vector<size_t> tDims(3, 0);
-  tDims[0] = XP;
-  tDims[1] = YP;
-  tDims[2] = ZP;
-  cellAttrMat->setTupleDimensions(tDims); // THIS WILL CAUSE A RESIZE of all the underlying data arrays.
+  destCellDataContainer->addOrReplaceAttributeMatrix(croppedCellAttrMat);
 
   if(m_RenumberFeatures)
   {
@@ -38,16 +38,45 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/Utils/GatherDataArrays.hpp"
 #include "Sampling/SamplingVersion.h"
 
+namespace
+{
+/**
+ * @brief FindNearestSampleIndices Maps every reference voxel along one axis onto the sampling voxel along the same
+ * axis that contains it, or -1 when the reference voxel lies outside of the sampling grid.
+ */
+std::vector<int64_t> FindNearestSampleIndices(int64_t refDim, float refRes, float refOrigin, int64_t sampleDim, float sampleRes, float sampleOrigin)
+{
+  std::vector<int64_t> indices(refDim, -1);
+  for(int64_t k = 0; k < refDim; k++)
+  {
+    float coord = (k * refRes + refOrigin);
+    if((coord - sampleOrigin) < 0)
+    {
+      continue;
+    }
+    int64_t index = int64_t((coord - sampleOrigin) / sampleRes);
+    if(index < sampleDim)
+    {
+      indices[k] = index;
+    }
+  }
+  return indices;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -224,88 +253,64 @@ void NearestPointFuseRegularGrids::execute()
 
   int64_t numRefTuples = refDims[0] * refDims[1] * refDims[2];
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t refIndex = 0;
-  int64_t sampleIndex = 0;
-  int64_t planeComp = 0, rowComp = 0;
+  // The nearest sampling voxel is separable per axis, so one index table per axis describes the whole grid
+  std::vector<int64_t> colIndices = FindNearestSampleIndices(refDims[0], refRes[0], refOrigin[0], sampleDims[0], sampleRes[0], sampleOrigin[0]);
+  std::vector<int64_t> rowIndices = FindNearestSampleIndices(refDims[1], refRes[1], refOrigin[1], sampleDims[1], sampleRes[1], sampleOrigin[1]);
+  std::vector<int64_t> planeIndices = FindNearestSampleIndices(refDims[2], refRes[2], refOrigin[2], sampleDims[2], sampleRes[2], sampleOrigin[2]);
+
+  // Offset of the sampling row for every reference row, -1 if the whole row is outside of the sampling grid
+  std::vector<int64_t> rowOffsets(refDims[1] * refDims[2], -1);
+  for(int64_t i = 0; i < refDims[2]; i++)
+  {
+    for(int64_t j = 0; j < refDims[1]; j++)
+    {
+      if(planeIndices[i] >= 0 && rowIndices[j] >= 0)
+      {
+        rowOffsets[i * refDims[1] + j] = (planeIndices[i] * sampleDims[0] * sampleDims[1]) + (rowIndices[j] * sampleDims[0]);
+      }
+    }
+  }
 
   // Create arrays on the reference grid to hold data present on the sampling grid
+  Sampling::TupleGatherKernels kernels;
+  std::vector<IDataArray::Pointer> sourceArrays; // keeps the sampling arrays alive until the kernels have run
   QList<QString> voxelArrayNames = sampleAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  for(const QString& arrayName : voxelArrayNames)
   {
-    IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
+    IDataArray::Pointer p = sampleAttrMat->getAttributeArray(arrayName);
     // Make a copy of the 'p' array that has the same name. When placed into
     // the data container this will over write the current array with
     // the same name. At least in theory
     IDataArray::Pointer data = p->createNewArray(numRefTuples, p->getComponentDimensions(), p->getName());
-    refAttrMat->insertOrAssign(data);
-  }
-
-  bool outside = false;
-  for(int64_t i = 0; i < refDims[2]; i++)
-  {
-    planeComp = i * refDims[0] * refDims[1];
-    for(int64_t j = 0; j < refDims[1]; j++)
+    if(nullptr != std::dynamic_pointer_cast<StringDataArray>(p))
     {
-      rowComp = j * refDims[0];
-      for(int64_t k = 0; k < refDims[0]; k++)
+      for(int64_t refIndex = 0; refIndex < numRefTuples; refIndex++)
       {
-        outside = false;
-        x = (k * refRes[0] + refOrigin[0]);
-        y = (j * refRes[1] + refOrigin[1]);
-        z = (i * refRes[2] + refOrigin[2]);
-        if((x - sampleOrigin[0]) < 0)
-        {
-          outside = true;
-        }
-        else
-        {
-          col = int64_t((x - sampleOrigin[0]) / sampleRes[0]);
-        }
-        if((y - sampleOrigin[1]) < 0)
-        {
-          outside = true;
-        }
-        else
-        {
-          row = int64_t((y - sampleOrigin[1]) / sampleRes[1]);
-        }
-        if((z - sampleOrigin[2]) < 0)
-        {
-          outside = true;
-        }
-        else
-        {
-          plane = int64_t((z - sampleOrigin[2]) / sampleRes[2]);
-        }
-        if(col >= sampleDims[0] || row >= sampleDims[1] || plane >= sampleDims[2])
-        {
-          outside = true;
-        }
-        if(!outside)
+        int64_t rowOffset = rowOffsets[refIndex / refDims[0]];
+        int64_t col = colIndices[refIndex % refDims[0]];
+        if(rowOffset >= 0 && col >= 0)
         {
-          sampleIndex = (plane * sampleDims[0] * sampleDims[1]) + (row * sampleDims[0]) + col;
-          refIndex = planeComp + rowComp + k;
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
-            // Make a copy of the 'p' array that has the same name. When placed into
-            // the data container this will over write the current array with
-            // the same name. At least in theory
-            IDataArray::Pointer data = refAttrMat->getAttributeArray(*iter);
-            void* source = nullptr;
-            void* destination = nullptr;
-            int nComp = data->getNumberOfComponents();
-
-            source = p->getVoidPointer((nComp * sampleIndex));
-            destination = data->getVoidPointer((nComp * refIndex));
-            ::memcpy(destination, source, p->getTypeSize() * nComp);
-          }
+          data->copyFromArray(refIndex, p, rowOffset + col, 1);
         }
       }
     }
+    else
+    {
+      EXECUTE_FUNCTION_TEMPLATE(this, Sampling::AppendGatherKernel, p, p, data, kernels)
+      if(getErrorCode() < 0)
+      {
+        return;
+      }
+    }
+    sourceArrays.push_back(p);
+    refAttrMat->insertOrAssign(data);
   }
+
+  // Fill every array in one parallel pass over the reference rows. Reference voxels outside of the sampling grid
+  // are set to zero.
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(numRefTuples));
+  dataAlg.execute(Sampling::GatherRowsImpl(kernels, colIndices, rowOffsets));
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,8 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -47,8 +49,10 @@
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/Utils/GatherDataArrays.hpp"
 #include "Sampling/SamplingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -188,14 +192,14 @@ void RegularizeZSpacing::execute()
   {
     m_ZP = 1;
   }
-  size_t totalPoints = m_XP * m_YP * m_ZP;
+  size_t planeSize = m_XP * m_YP;
+  size_t totalPoints = planeSize * m_ZP;
 
-  size_t index = 0, oldindex = 0;
-  size_t plane = 0;
-  std::vector<size_t> newindicies(totalPoints, 0);
+  // Every new Z plane is a copy of exactly one old Z plane, so only the plane mapping is needed
+  std::vector<size_t> planeMap(m_ZP, 0);
   for(size_t i = 0; i < m_ZP; i++)
   {
-    plane = 0;
+    size_t plane = 0;
     for(size_t iter = 1; iter < dims[2]; iter++)
     {
       if((i * m_NewZRes) > zboundvalues[iter])
@@ -203,15 +207,7 @@ void RegularizeZSpacing::execute()
         plane = iter;
       }
     }
-    for(size_t j = 0; j < m_YP; j++)
-    {
-      for(size_t k = 0; k < m_XP; k++)
-      {
-        oldindex = (plane * dims[0] * dims[1]) + (j * dims[0]) + k;
-        index = (i * dims[0] * dims[1]) + (j * dims[0]) + k;
-        newindicies[index] = oldindex;
-      }
-    }
+    planeMap[i] = plane;
   }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
@@ -221,30 +217,41 @@ void RegularizeZSpacing::execute()
   tDims[2] = m_ZP;
   AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
 
+  // Create all the resized arrays first so that a single parallel pass over the new Z planes can fill every array
+  Sampling::TupleGatherKernels kernels;
+  std::vector<IDataArray::Pointer> sourceArrays; // keeps the old arrays alive until the kernels have run
   QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  for(const QString& arrayName : voxelArrayNames)
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
+    IDataArray::Pointer p = cellAttrMat->getAttributeArray(arrayName);
     // Make a copy of the 'p' array that has the same name. When placed into
     // the data container this will over write the current array with
     // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
+    IDataArray::Pointer data = p->createNewArray(totalPoints, p->getComponentDimensions(), p->getName(), true);
+    if(nullptr != std::dynamic_pointer_cast<StringDataArray>(p))
     {
-      newIndicies_I = newindicies[i];
-
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        data->copyFromArray(i, p, planeMap[i / planeSize] * planeSize + i % planeSize, 1);
+      }
     }
-    cellAttrMat->removeAttributeArray(*iter);
+    else
+    {
+      EXECUTE_FUNCTION_TEMPLATE(this, Sampling::AppendGatherKernel, p, p, data, kernels)
+      if(getErrorCode() < 0)
+      {
+        return;
+      }
+    }
+    sourceArrays.push_back(p);
+    cellAttrMat->removeAttributeArray(arrayName);
     newCellAttrMat->insertOrAssign(data);
   }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
+  dataAlg.execute(Sampling::CopyPlanesImpl(kernels, planeMap, planeSize));
+
   m->getGeometryAs<ImageGeom>()->setSpacing(spacing[0], spacing[1], m_NewZRes);
   m->getGeometryAs<ImageGeom>()->setDimensions(m_XP, m_YP, m_ZP);
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
@@ -33,9 +33,13 @@
 
 #include "ResampleRectGridToImageGeom.h"
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -48,8 +52,10 @@
 #include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/PreflightUpdatedValueFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/Utils/GatherDataArrays.hpp"
 #include "Sampling/SamplingVersion.h"
 
 namespace
@@ -74,6 +80,32 @@ void checkPositiveDimension(Filter* filter, T var, int32_t err)
     filter->setErrorCondition(err, ss);
   }
 }
+
+/**
+ * @brief FindCellIndices Maps the cell centers along one axis of the Image Geometry onto the cells of the same axis of
+ * the RectGrid. The bounds are sorted, so each center is a binary search for the first bound at or above it. Centers
+ * that fall outside of the bounds map to cell 0.
+ */
+std::vector<int64_t> FindCellIndices(const FloatArrayType& bounds, size_t numCells, float origin, float spacing, float halfSpacing)
+{
+  std::vector<int64_t> indices(numCells, 0);
+  const float* boundsBegin = bounds.getPointer(0);
+  const float* boundsEnd = boundsBegin + bounds.getNumberOfTuples();
+  if(bounds.getNumberOfTuples() < 2)
+  {
+    return indices;
+  }
+  for(size_t i = 0; i < numCells; i++)
+  {
+    float coord = origin + (i * spacing) + halfSpacing;
+    const float* upper = std::lower_bound(boundsBegin + 1, boundsEnd, coord);
+    if(upper != boundsEnd && coord > *(upper - 1))
+    {
+      indices[i] = (upper - boundsBegin) - 1;
+    }
+  }
+  return indices;
+}
 } // namespace
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -281,68 +313,19 @@ void ResampleRectGridToImageGeom::execute()
   FloatVec3Type imageGeomOrigin = {xGridValues->getValue(0), yGridValues->getValue(0), zGridValues->getValue(0)};
   imageGeom->setOrigin(imageGeomOrigin);
 
-  size_t rgIdxStart = 1;
-  std::vector<size_t> xIdx(imageGeomDims[0], 0);
-  for(size_t x = 0; x < imageGeomDims[0]; x++)
-  {
-    float coord = imageGeomOrigin[0] + (x * imageGeomSpacing[0]) + halfSpacing[0];
-    for(size_t rgIdx = rgIdxStart; rgIdx < xGridValues->size(); rgIdx++)
-    {
-      if(coord > xGridValues->getValue(rgIdx - 1) && coord <= xGridValues->getValue(rgIdx))
-      {
-        xIdx[x] = rgIdx - 1;
-        rgIdxStart = rgIdx;
-        break;
-      }
-    }
-  }
-
-  rgIdxStart = 1;
-  std::vector<size_t> yIdx(imageGeomDims[1], 0);
-  for(size_t y = 0; y < imageGeomDims[1]; y++)
-  {
-    float coord = imageGeomOrigin[1] + (y * imageGeomSpacing[1]) + halfSpacing[1];
-    for(size_t rgIdx = rgIdxStart; rgIdx < yGridValues->size(); rgIdx++)
-    {
-      if(coord > yGridValues->getValue(rgIdx - 1) && coord <= yGridValues->getValue(rgIdx))
-      {
-        yIdx[y] = rgIdx - 1;
-        rgIdxStart = rgIdx;
-        break;
-      }
-    }
-  }
-
-  rgIdxStart = 1;
-  std::vector<size_t> zIdx(imageGeomDims[2], 0);
-  for(size_t z = 0; z < imageGeomDims[2]; z++)
-  {
-    float coord = imageGeomOrigin[2] + (z * imageGeomSpacing[2]) + halfSpacing[2];
-    for(size_t rgIdx = rgIdxStart; rgIdx < zGridValues->size(); rgIdx++)
-    {
-      if(coord > zGridValues->getValue(rgIdx - 1) && coord <= zGridValues->getValue(rgIdx))
-      {
-        zIdx[z] = rgIdx - 1;
-        rgIdxStart = rgIdx;
-        break;
-      }
-    }
-  }
+  // The mapping is separable, so one index table per axis describes the whole volume
+  std::vector<int64_t> xIdx = FindCellIndices(*xGridValues, imageGeomDims[0], imageGeomOrigin[0], imageGeomSpacing[0], halfSpacing[0]);
+  std::vector<int64_t> yIdx = FindCellIndices(*yGridValues, imageGeomDims[1], imageGeomOrigin[1], imageGeomSpacing[1], halfSpacing[1]);
+  std::vector<int64_t> zIdx = FindCellIndices(*zGridValues, imageGeomDims[2], imageGeomOrigin[2], imageGeomSpacing[2], halfSpacing[2]);
 
-  // Store the mapped XYZ index into the RectGrid data ararys
-  std::vector<size_t> newIdxs(imageGeom->getNumberOfElements());
+  // Store the offset of the mapped RectGrid row for every row of the Image Geometry
+  std::vector<int64_t> rowOffsets(imageGeomDims[1] * imageGeomDims[2]);
   size_t currIdx = 0;
-  for(size_t z : zIdx)
+  for(int64_t z : zIdx)
   {
-    for(size_t y : yIdx)
+    for(int64_t y : yIdx)
     {
-      for(size_t x : xIdx)
-      {
-        // Compute the index into the RectGrid Data Array
-        size_t idx = (rectGridDims[0] * rectGridDims[1] * z) + (rectGridDims[0] * y) + x;
-        // Compute the index into the new Idx Array
-        newIdxs[currIdx++] = idx;
-      }
+      rowOffsets[currIdx++] = static_cast<int64_t>(rectGridDims[0] * rectGridDims[1]) * z + static_cast<int64_t>(rectGridDims[0]) * y;
     }
   }
   if(getCancel())
@@ -358,6 +341,7 @@ void ResampleRectGridToImageGeom::execute()
     AttributeMatrix::Pointer imageGeomCellAM = outputDC->getAttributeMatrix(getImageGeomCellAttributeMatrix());
     size_t totalPoints = imageGeom->getNumberOfElements();
 
+    Sampling::TupleGatherKernels kernels;
     QList<QString> voxelArrayNames = rectGridCellAM->getAttributeArrayNames();
     for(const QString& voxelArrayName : voxelArrayNames)
     {
@@ -366,21 +350,30 @@ void ResampleRectGridToImageGeom::execute()
       // the data container this will over write the current array with
       // the same name. At least in theory
       IDataArray::Pointer data = inputDataArray->createNewArray(totalPoints, inputDataArray->getComponentDimensions(), inputDataArray->getName());
-      void* source = nullptr;
-      void* destination = nullptr;
-      size_t newIndicies_I = 0;
-      int nComp = data->getNumberOfComponents();
-      for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
+      if(nullptr != std::dynamic_pointer_cast<StringDataArray>(inputDataArray))
       {
-        newIndicies_I = newIdxs[i];
-
-        source = inputDataArray->getVoidPointer(nComp * newIndicies_I);
-        destination = data->getVoidPointer(nComp * i);
-        ::memcpy(destination, source, inputDataArray->getTypeSize() * data->getNumberOfComponents());
+        for(size_t i = 0; i < totalPoints; i++)
+        {
+          size_t row = i / imageGeomDims[0];
+          data->copyFromArray(i, inputDataArray, static_cast<size_t>(rowOffsets[row] + xIdx[i - row * imageGeomDims[0]]), 1);
+        }
+      }
+      else
+      {
+        EXECUTE_FUNCTION_TEMPLATE(this, Sampling::AppendGatherKernel, inputDataArray, inputDataArray, data, kernels)
+        if(getErrorCode() < 0)
+        {
+          return;
+        }
       }
       //  rectGridCellAM->removeAttributeArray(*iter);
       imageGeomCellAM->insertOrAssign(data);
     }
+
+    // Fill every array in one parallel pass over the Image Geometry rows
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, totalPoints);
+    dataAlg.execute(Sampling::GatherRowsImpl(kernels, xIdx, rowOffsets));
   }
 }
 
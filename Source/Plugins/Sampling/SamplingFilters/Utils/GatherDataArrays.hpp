@@ -0,0 +1,269 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace Sampling
+{
+
+/**
+ * @brief The TupleGatherKernel class is the type erased interface over DataArrayGatherKernel so that the arrays of
+ * an Attribute Matrix, whatever their primitive types, can all be filled in the same pass over the output tuples.
+ */
+class TupleGatherKernel
+{
+public:
+  virtual ~TupleGatherKernel() = default;
+
+  /**
+   * @brief Copies count consecutive source tuples starting at sourceTuple into the destination starting at destTuple
+   */
+  virtual void copyTuples(size_t destTuple, size_t sourceTuple, size_t count) const = 0;
+
+  /**
+   * @brief Fills count destination tuples starting at destTuple from the source tuples sourceOffset + indices[i].
+   * A negative index leaves a tuple of zeros instead.
+   */
+  virtual void gatherTuples(size_t destTuple, size_t count, const int64_t* indices, size_t sourceOffset) const = 0;
+
+  /**
+   * @brief Sets count destination tuples starting at destTuple to zero
+   */
+  virtual void zeroTuples(size_t destTuple, size_t count) const = 0;
+};
+
+/**
+ * @brief The DataArrayGatherKernel class implements TupleGatherKernel for one primitive type
+ */
+template <typename T>
+class DataArrayGatherKernel : public TupleGatherKernel
+{
+public:
+  DataArrayGatherKernel(const DataArray<T>& source, DataArray<T>& destination)
+  : m_Source(source.getPointer(0))
+  , m_Destination(destination.getPointer(0))
+  , m_NumComps(source.getNumberOfComponents())
+  {
+  }
+
+  void copyTuples(size_t destTuple, size_t sourceTuple, size_t count) const override
+  {
+    const T* sourcePtr = m_Source + sourceTuple * m_NumComps;
+    std::copy(sourcePtr, sourcePtr + count * m_NumComps, m_Destination + destTuple * m_NumComps);
+  }
+
+  void gatherTuples(size_t destTuple, size_t count, const int64_t* indices, size_t sourceOffset) const override
+  {
+    T* destPtr = m_Destination + destTuple * m_NumComps;
+    const T* sourcePtr = m_Source + sourceOffset * m_NumComps;
+    if(m_NumComps == 1)
+    {
+      for(size_t i = 0; i < count; i++)
+      {
+        destPtr[i] = indices[i] < 0 ? static_cast<T>(0) : sourcePtr[indices[i]];
+      }
+      return;
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+      T* dest = destPtr + i * m_NumComps;
+      if(indices[i] < 0)
+      {
+        std::fill(dest, dest + m_NumComps, static_cast<T>(0));
+      }
+      else
+      {
+        const T* source = sourcePtr + static_cast<size_t>(indices[i]) * m_NumComps;
+        std::copy(source, source + m_NumComps, dest);
+      }
+    }
+  }
+
+  void zeroTuples(size_t destTuple, size_t count) const override
+  {
+    T* destPtr = m_Destination + destTuple * m_NumComps;
+    std::fill(destPtr, destPtr + count * m_NumComps, static_cast<T>(0));
+  }
+
+private:
+  const T* m_Source = nullptr;
+  T* m_Destination = nullptr;
+  size_t m_NumComps = 1;
+};
+
+using TupleGatherKernels = std::vector<std::unique_ptr<TupleGatherKernel>>;
+
+/**
+ * @brief AppendGatherKernel Adds a kernel that fills destination from source. Meant to be called through
+ * EXECUTE_FUNCTION_TEMPLATE so that the primitive type is resolved once per array.
+ */
+template <typename T>
+void AppendGatherKernel(const IDataArray::Pointer& source, const IDataArray::Pointer& destination, TupleGatherKernels& kernels)
+{
+  typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
+  typename DataArray<T>::Pointer destPtr = std::dynamic_pointer_cast<DataArray<T>>(destination);
+  if(nullptr == sourcePtr || nullptr == destPtr || destPtr->getNumberOfTuples() == 0)
+  {
+    return;
+  }
+  kernels.push_back(std::make_unique<DataArrayGatherKernel<T>>(*sourcePtr, *destPtr));
+}
+
+/**
+ * @brief The CopyPlanesImpl class fills the output tuples when every output Z plane is a copy of one input Z plane.
+ * Each block of output tuples is cut at plane boundaries and copied as contiguous runs for every array in turn.
+ */
+class CopyPlanesImpl
+{
+public:
+  CopyPlanesImpl(const TupleGatherKernels& kernels, const std::vector<size_t>& planeMap, size_t planeSize)
+  : m_Kernels(kernels)
+  , m_PlaneMap(planeMap)
+  , m_PlaneSize(planeSize)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t tuple = range.min();
+    while(tuple < range.max())
+    {
+      size_t plane = tuple / m_PlaneSize;
+      size_t offset = tuple - plane * m_PlaneSize;
+      size_t count = std::min(range.max(), (plane + 1) * m_PlaneSize) - tuple;
+      size_t sourceTuple = m_PlaneMap[plane] * m_PlaneSize + offset;
+      for(const auto& kernel : m_Kernels)
+      {
+        kernel->copyTuples(tuple, sourceTuple, count);
+      }
+      tuple += count;
+    }
+  }
+
+private:
+  const TupleGatherKernels& m_Kernels;
+  const std::vector<size_t>& m_PlaneMap;
+  size_t m_PlaneSize = 1;
+};
+
+/**
+ * @brief The GatherPlanesImpl class fills the output tuples when every output Z plane gathers from the same Z plane
+ * of the input through one in-plane index table (negative entries are zero filled). Use a plane size equal to the
+ * number of output tuples for a general index table.
+ */
+class GatherPlanesImpl
+{
+public:
+  GatherPlanesImpl(const TupleGatherKernels& kernels, const std::vector<int64_t>& planeIndices)
+  : m_Kernels(kernels)
+  , m_PlaneIndices(planeIndices)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t planeSize = m_PlaneIndices.size();
+    size_t tuple = range.min();
+    while(tuple < range.max())
+    {
+      size_t plane = tuple / planeSize;
+      size_t offset = tuple - plane * planeSize;
+      size_t count = std::min(range.max(), (plane + 1) * planeSize) - tuple;
+      for(const auto& kernel : m_Kernels)
+      {
+        kernel->gatherTuples(tuple, count, m_PlaneIndices.data() + offset, plane * planeSize);
+      }
+      tuple += count;
+    }
+  }
+
+private:
+  const TupleGatherKernels& m_Kernels;
+  const std::vector<int64_t>& m_PlaneIndices;
+};
+
+/**
+ * @brief The GatherRowsImpl class fills the output tuples of a regular grid whose source index is separable per axis.
+ * Output row r (of rowLength tuples) gathers from the source tuples rowOffsets[r] + columnIndices[i]. A negative row
+ * offset zero fills the whole row and a negative column index zero fills that column.
+ */
+class GatherRowsImpl
+{
+public:
+  GatherRowsImpl(const TupleGatherKernels& kernels, const std::vector<int64_t>& columnIndices, const std::vector<int64_t>& rowOffsets)
+  : m_Kernels(kernels)
+  , m_ColumnIndices(columnIndices)
+  , m_RowOffsets(rowOffsets)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t rowLength = m_ColumnIndices.size();
+    size_t tuple = range.min();
+    while(tuple < range.max())
+    {
+      size_t row = tuple / rowLength;
+      size_t offset = tuple - row * rowLength;
+      size_t count = std::min(range.max(), (row + 1) * rowLength) - tuple;
+      int64_t rowOffset = m_RowOffsets[row];
+      for(const auto& kernel : m_Kernels)
+      {
+        if(rowOffset < 0)
+        {
+          kernel->zeroTuples(tuple, count);
+        }
+        else
+        {
+          kernel->gatherTuples(tuple, count, m_ColumnIndices.data() + offset, static_cast<size_t>(rowOffset));
+        }
+      }
+      tuple += count;
+    }
+  }
+
+private:
+  const TupleGatherKernels& m_Kernels;
+  const std::vector<int64_t>& m_ColumnIndices;
+  const std::vector<int64_t>& m_RowOffsets;
+};
+
+} // namespace Sampling
@@ -37,6 +37,8 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -50,8 +52,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/ThirdOrderPolynomialFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/Utils/GatherDataArrays.hpp"
 #include "Sampling/SamplingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -229,78 +233,69 @@ void WarpRegularGrid::execute()
   FloatVec3Type res = m->getGeometryAs<ImageGeom>()->getSpacing();
   size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
+  // The warp only depends on the in-plane coordinates, so one index table of the source voxel for every voxel of
+  // a plane serves all the Z planes. Voxels warped outside of the plane are marked with -1 and are zero filled.
+  size_t planeSize = dims[0] * dims[1];
+  std::vector<int64_t> planeIndices(planeSize, -1);
   float newX = 0.0f, newY = 0.0f;
-  int col = 0.0f, row = 0.0f, plane = 0.0f;
-  size_t index;
-  size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
-
-  for(size_t i = 0; i < dims[2]; i++)
+  for(size_t j = 0; j < dims[1]; j++)
   {
-    QString ss = QObject::tr("Warping Data - %1 Percent Complete").arg(((float)i / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    for(size_t j = 0; j < dims[1]; j++)
+    for(size_t k = 0; k < dims[0]; k++)
     {
-      for(size_t k = 0; k < dims[0]; k++)
+      float x = static_cast<float>((k * res[0]));
+      float y = static_cast<float>((j * res[1]));
+
+      determine_warped_coordinates(x, y, newX, newY);
+      int col = newX / res[0];
+      int row = newY / res[1];
+
+      if(col > 0 && col < dims[0] && row > 0 && row < dims[1])
       {
-        x = static_cast<float>((k * res[0]));
-        y = static_cast<float>((j * res[1]));
-        z = static_cast<float>((i * res[2]));
-        index = (i * dims[0] * dims[1]) + (j * dims[0]) + k;
-
-        determine_warped_coordinates(x, y, newX, newY);
-        col = newX / res[0];
-        row = newY / res[1];
-        plane = i;
-
-        index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
-        if(col > 0 && col < dims[0] && row > 0 && row < dims[1])
-        {
-          goodPoint[index] = true;
-        }
-        else
-        {
-          goodPoint[index] = false;
-        }
+        planeIndices[(j * dims[0]) + k] = static_cast<int64_t>((row * dims[0]) + col);
       }
     }
   }
 
+  notifyStatusMessage("Warping Data");
+
+  Sampling::TupleGatherKernels kernels;
+  std::vector<IDataArray::Pointer> sourceArrays; // keeps the old arrays alive until the kernels have run
   QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  for(const QString& arrayName : voxelArrayNames)
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
+    IDataArray::Pointer p = cellAttrMat->getAttributeArray(arrayName);
     // Make a copy of the 'p' array that has the same name. When placed into
     // the data container this will over write the current array with
     // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
+    IDataArray::Pointer data = p->createNewArray(totalPoints, p->getComponentDimensions(), p->getName(), true);
+    if(nullptr != std::dynamic_pointer_cast<StringDataArray>(p))
     {
-      newIndicies_I = newindicies[i];
-
-      if(goodPoint[i])
+      for(size_t i = 0; i < totalPoints; i++)
       {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
+        int64_t planeIndex = planeIndices[i % planeSize];
+        if(planeIndex >= 0)
+        {
+          data->copyFromArray(i, p, (i / planeSize) * planeSize + static_cast<size_t>(planeIndex), 1);
+        }
       }
-      else
+    }
+    else
+    {
+      EXECUTE_FUNCTION_TEMPLATE(this, Sampling::AppendGatherKernel, p, p, data, kernels)
+      if(getErrorCode() < 0)
       {
-        int var = 0;
-        data->initializeTuple(i, &var);
+        return;
       }
     }
-    cellAttrMat->removeAttributeArray(*iter);
+    sourceArrays.push_back(p);
+    cellAttrMat->removeAttributeArray(arrayName);
     newCellAttrMat->insertOrAssign(data);
   }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
+  dataAlg.execute(Sampling::GatherPlanesImpl(kernels, planeIndices));
+
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   m->addOrReplaceAttributeMatrix(newCellAttrMat);
 }
@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Sampling/SamplingFilters/AppendImageGeometryZSlice.h"
+#include "SamplingTestFileLocations.h"
+
+class AppendImageGeometryZSliceTest
+{
+  const QString k_DestinationName = {"Destination"};
+  const QString k_Input1Name = {"Input 1"};
+  const QString k_Input2Name = {"Input 2"};
+  const QString k_CellDataName = {"CellData"};
+  const QString k_DataName = {"Data"};
+
+  static constexpr size_t k_XSize = 3;
+  static constexpr size_t k_YSize = 2;
+  static constexpr size_t k_DestZSize = 2;
+  static constexpr size_t k_Input1ZSize = 1;
+  static constexpr size_t k_Input2ZSize = 3;
+
+public:
+  AppendImageGeometryZSliceTest() = default;
+  ~AppendImageGeometryZSliceTest() = default;
+
+  AppendImageGeometryZSliceTest(const AppendImageGeometryZSliceTest&) = delete;            // Copy Constructor
+  AppendImageGeometryZSliceTest(AppendImageGeometryZSliceTest&&) = delete;                 // Move Constructor
+  AppendImageGeometryZSliceTest& operator=(const AppendImageGeometryZSliceTest&) = delete; // Copy Assignment
+  AppendImageGeometryZSliceTest& operator=(AppendImageGeometryZSliceTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // Adds an Image Geometry whose "Data" values are valueOffset + tuple index
+  // -----------------------------------------------------------------------------
+  void addImageDataContainer(const DataContainerArray::Pointer& dca, const QString& name, size_t xSize, size_t zSize, int32_t valueOffset)
+  {
+    DataContainer::Pointer dc = DataContainer::New(name);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> dims = {xSize, k_YSize, zSize};
+    ImageGeom::Pointer imageGeom = ImageGeom::New();
+    imageGeom->setDimensions(dims);
+    imageGeom->setOrigin({0.0F, 0.0F, 0.0F});
+    imageGeom->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(imageGeom);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    Int32ArrayType::Pointer data = Int32ArrayType::CreateArray(dims, {1ULL}, k_DataName, true);
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      data->setValue(i, valueOffset + static_cast<int32_t>(i));
+    }
+    cellAM->insertOrAssign(data);
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    addImageDataContainer(dca, k_DestinationName, k_XSize, k_DestZSize, 1000);
+    addImageDataContainer(dca, k_Input1Name, k_XSize, k_Input1ZSize, 2000);
+    addImageDataContainer(dca, k_Input2Name, k_XSize, k_Input2ZSize, 3000);
+    // An input whose X dimension does not match the destination
+    addImageDataContainer(dca, "Mismatched", k_XSize + 1, 1, 4000);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  AppendImageGeometryZSlice::Pointer createFilter(const DataContainerArray::Pointer& dca)
+  {
+    AppendImageGeometryZSlice::Pointer filter = AppendImageGeometryZSlice::New();
+    filter->setDataContainerArray(dca);
+    filter->setDestinationAttributeMatrix({k_DestinationName, k_CellDataName, ""});
+    filter->setInputAttributeMatrix({k_Input1Name, k_CellDataName, ""});
+    filter->setAdditionalInputAttributeMatrices({{k_Input2Name, k_CellDataName, ""}});
+    filter->setCheckResolution(true);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAppendMultipleInputs()
+  {
+    const size_t totalZ = k_DestZSize + k_Input1ZSize + k_Input2ZSize;
+
+    // Preflight reports the combined Z dimension
+    DataContainerArray::Pointer dca = createDataStructure();
+    AppendImageGeometryZSlice::Pointer filter = createFilter(dca);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+    SizeVec3Type dims = dca->getDataContainer(k_DestinationName)->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[2], totalZ);
+
+    dca = createDataStructure();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0);
+
+    dims = dca->getDataContainer(k_DestinationName)->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], k_XSize);
+    DREAM3D_REQUIRE_EQUAL(dims[1], k_YSize);
+    DREAM3D_REQUIRE_EQUAL(dims[2], totalZ);
+
+    Int32ArrayType::Pointer data = dca->getAttributeMatrix({k_DestinationName, k_CellDataName, ""})->getAttributeArrayAs<Int32ArrayType>(k_DataName);
+    DREAM3D_REQUIRE_VALID_POINTER(data.get());
+    DREAM3D_REQUIRE_EQUAL(data->getNumberOfTuples(), k_XSize * k_YSize * totalZ);
+
+    // The destination keeps its slices, followed by the Input Cell Data and then each Additional Input Cell Data in order
+    const size_t sliceSize = k_XSize * k_YSize;
+    const size_t input1Offset = k_DestZSize * sliceSize;
+    const size_t input2Offset = input1Offset + k_Input1ZSize * sliceSize;
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      int32_t expected = 0;
+      if(i < input1Offset)
+      {
+        expected = 1000 + static_cast<int32_t>(i);
+      }
+      else if(i < input2Offset)
+      {
+        expected = 2000 + static_cast<int32_t>(i - input1Offset);
+      }
+      else
+      {
+        expected = 3000 + static_cast<int32_t>(i - input2Offset);
+      }
+      DREAM3D_REQUIRE_EQUAL(data->getValue(i), expected);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestInvalidInputs()
+  {
+    // The destination can not also be one of the inputs
+    DataContainerArray::Pointer dca = createDataStructure();
+    AppendImageGeometryZSlice::Pointer filter = createFilter(dca);
+    filter->setAdditionalInputAttributeMatrices({{k_Input2Name, k_CellDataName, ""}, {k_DestinationName, k_CellDataName, ""}});
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -8208);
+
+    // Every additional input is checked against the destination dimensions
+    dca = createDataStructure();
+    filter = createFilter(dca);
+    filter->setAdditionalInputAttributeMatrices({{"Mismatched", k_CellDataName, ""}});
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -8202);
+
+    // A rejected preflight leaves the destination geometry untouched
+    SizeVec3Type dims = dca->getDataContainer(k_DestinationName)->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[2], k_DestZSize);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestAppendMultipleInputs())
+    DREAM3D_REGISTER_TEST(TestInvalidInputs())
+  }
+
+private:
+};
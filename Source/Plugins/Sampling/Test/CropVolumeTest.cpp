@@ -39,6 +39,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/CoreFilters/DataContainerWriter.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
@@ -136,6 +137,13 @@ class CropVolumeTest
   float originalRes[3] = {0.25, 0.25, 0.25};
   float originalOrigin[3] = {0, 0, 0};
 
+  const QString k_ScalarArrayName = {"Scalars"};
+  const QString k_VectorArrayName = {"Vectors"};
+  const QString k_StringArrayName = {"Strings"};
+  const SizeVec3Type k_MixedDims = {5, 4, 3};
+  const SizeVec3Type k_MixedMin = {1, 1, 1};
+  const SizeVec3Type k_MixedMax = {3, 2, 2};
+
 public:
   CropVolumeTest() = default;
   virtual ~CropVolumeTest() = default;
@@ -157,12 +165,12 @@ public:
 
       QVariant var;
       var.setValue(outputFile);
-      filter->setProperty("OutputFile(xxx);
-      require_equal<bool, bool>(propWasSet, "OutputFile", true, "true");
+      bool propWasSet = filter->setProperty("OutputFile", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
 
       var.setValue(false);
-      filter->setProperty("WriteXdmfFile(xxx);
-      require_equal<bool, bool>(propWasSet, "WriteXdmfFile", true, "true");
+      propWasSet = filter->setProperty("WriteXdmfFile", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
     }
 
     return filter;
@@ -876,6 +884,169 @@ public:
     checkRenumber<int32_t, int32_t>(data, s_CroppedX, s_CroppedY, s_CroppedZ);
   }
 
+  // -----------------------------------------------------------------------------
+  // Creates a 5x4x3 Image Geometry whose Cell data holds a scalar, a 3 component and a string array. Every
+  // value encodes the index of its voxel so the cropped values can be traced back to the source voxel.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createMixedArrayTestStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> tDims = {k_MixedDims[0], k_MixedDims[1], k_MixedDims[2]};
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_MixedDims);
+    image->setOrigin({0.0F, 0.0F, 0.0F});
+    image->setSpacing({1.0F, 1.0F, 1.0F});
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    const size_t numTuples = k_MixedDims[0] * k_MixedDims[1] * k_MixedDims[2];
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(tDims, {1ULL}, k_ScalarArrayName, true);
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(tDims, {3ULL}, k_VectorArrayName, true);
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(numTuples, k_StringArrayName, true);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      scalars->setValue(i, static_cast<int32_t>(i));
+      for(size_t c = 0; c < 3; c++)
+      {
+        vectors->setComponent(i, static_cast<int>(c), static_cast<float>(i * 3 + c));
+      }
+      strings->setValue(i, QString("Voxel %1").arg(i));
+    }
+    cellAM->insertOrAssign(scalars);
+    cellAM->insertOrAssign(vectors);
+    cellAM->insertOrAssign(strings);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  CropImageGeometry::Pointer createMixedArrayCropFilter(const DataContainerArray::Pointer& dca, bool createNewDC)
+  {
+    CropImageGeometry::Pointer cropVolume = CropImageGeometry::New();
+    cropVolume->setDataContainerArray(dca);
+    cropVolume->setCellAttributeMatrixPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, ""));
+    cropVolume->setXMin(static_cast<int>(k_MixedMin[0]));
+    cropVolume->setYMin(static_cast<int>(k_MixedMin[1]));
+    cropVolume->setZMin(static_cast<int>(k_MixedMin[2]));
+    cropVolume->setXMax(static_cast<int>(k_MixedMax[0]));
+    cropVolume->setYMax(static_cast<int>(k_MixedMax[1]));
+    cropVolume->setZMax(static_cast<int>(k_MixedMax[2]));
+    cropVolume->setRenumberFeatures(false);
+    cropVolume->setSaveAsNewDataContainer(createNewDC);
+    if(createNewDC)
+    {
+      cropVolume->setNewDataContainerName(DataArrayPath(k_NewDataContainerName, "", ""));
+    }
+    return cropVolume;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Checks the geometry, the Attribute Matrix and every array of the cropped Cell data
+  // -----------------------------------------------------------------------------
+  void checkMixedArrayCrop(const DataContainerArray::Pointer& dca, const QString& dcName)
+  {
+    const SizeVec3Type croppedDims = {k_MixedMax[0] - k_MixedMin[0] + 1, k_MixedMax[1] - k_MixedMin[1] + 1, k_MixedMax[2] - k_MixedMin[2] + 1};
+    const size_t croppedTuples = croppedDims[0] * croppedDims[1] * croppedDims[2];
+
+    SizeVec3Type dims = dca->getDataContainer(dcName)->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], croppedDims[0])
+    DREAM3D_REQUIRE_EQUAL(dims[1], croppedDims[1])
+    DREAM3D_REQUIRE_EQUAL(dims[2], croppedDims[2])
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath(dcName, k_CellAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(cellAM.get())
+    DREAM3D_REQUIRE_EQUAL(cellAM->getNumberOfTuples(), croppedTuples)
+    std::vector<size_t> tDims = cellAM->getTupleDimensions();
+    DREAM3D_REQUIRE_EQUAL(tDims.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(tDims[0], croppedDims[0])
+    DREAM3D_REQUIRE_EQUAL(tDims[1], croppedDims[1])
+    DREAM3D_REQUIRE_EQUAL(tDims[2], croppedDims[2])
+
+    Int32ArrayType::Pointer scalars = cellAM->getAttributeArrayAs<Int32ArrayType>(k_ScalarArrayName);
+    FloatArrayType::Pointer vectors = cellAM->getAttributeArrayAs<FloatArrayType>(k_VectorArrayName);
+    StringDataArray::Pointer strings = cellAM->getAttributeArrayAs<StringDataArray>(k_StringArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(scalars.get())
+    DREAM3D_REQUIRE_VALID_POINTER(vectors.get())
+    DREAM3D_REQUIRE_VALID_POINTER(strings.get())
+    DREAM3D_REQUIRE_EQUAL(scalars->getNumberOfTuples(), croppedTuples)
+    DREAM3D_REQUIRE_EQUAL(vectors->getNumberOfTuples(), croppedTuples)
+    DREAM3D_REQUIRE_EQUAL(vectors->getNumberOfComponents(), 3)
+    DREAM3D_REQUIRE_EQUAL(strings->getNumberOfTuples(), croppedTuples)
+
+    for(size_t z = 0; z < croppedDims[2]; z++)
+    {
+      for(size_t y = 0; y < croppedDims[1]; y++)
+      {
+        for(size_t x = 0; x < croppedDims[0]; x++)
+        {
+          size_t index = (z * croppedDims[0] * croppedDims[1]) + (y * croppedDims[0]) + x;
+          size_t sourceIndex = ((z + k_MixedMin[2]) * k_MixedDims[0] * k_MixedDims[1]) + ((y + k_MixedMin[1]) * k_MixedDims[0]) + (x + k_MixedMin[0]);
+          DREAM3D_REQUIRE_EQUAL(scalars->getValue(index), static_cast<int32_t>(sourceIndex))
+          for(size_t c = 0; c < 3; c++)
+          {
+            DREAM3D_REQUIRE_EQUAL(vectors->getComponent(index, static_cast<int>(c)), static_cast<float>(sourceIndex * 3 + c))
+          }
+          DREAM3D_REQUIRE_EQUAL(strings->getValue(index), QString("Voxel %1").arg(sourceIndex))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Crops a scalar, a multi-component and a string array in place
+  // -----------------------------------------------------------------------------
+  int TestCropMixedArraysInPlace()
+  {
+    DataContainerArray::Pointer dca = createMixedArrayTestStructure();
+    CropImageGeometry::Pointer cropVolume = createMixedArrayCropFilter(dca, false);
+    cropVolume->preflight();
+    DREAM3D_REQUIRE_EQUAL(cropVolume->getErrorCode(), 0)
+
+    dca = createMixedArrayTestStructure();
+    cropVolume->setDataContainerArray(dca);
+    cropVolume->execute();
+    DREAM3D_REQUIRE_EQUAL(cropVolume->getErrorCode(), 0)
+
+    checkMixedArrayCrop(dca, k_DataContainerName);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Crops a scalar, a multi-component and a string array into a new Data Container, leaving the source intact
+  // -----------------------------------------------------------------------------
+  int TestCropMixedArraysNewDataContainer()
+  {
+    DataContainerArray::Pointer dca = createMixedArrayTestStructure();
+    CropImageGeometry::Pointer cropVolume = createMixedArrayCropFilter(dca, true);
+    cropVolume->preflight();
+    DREAM3D_REQUIRE_EQUAL(cropVolume->getErrorCode(), 0)
+
+    dca = createMixedArrayTestStructure();
+    cropVolume->setDataContainerArray(dca);
+    cropVolume->execute();
+    DREAM3D_REQUIRE_EQUAL(cropVolume->getErrorCode(), 0)
+
+    checkMixedArrayCrop(dca, k_NewDataContainerName);
+
+    const size_t numTuples = k_MixedDims[0] * k_MixedDims[1] * k_MixedDims[2];
+    SizeVec3Type dims = dca->getDataContainer(k_DataContainerName)->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], k_MixedDims[0])
+    DREAM3D_REQUIRE_EQUAL(dims[1], k_MixedDims[1])
+    DREAM3D_REQUIRE_EQUAL(dims[2], k_MixedDims[2])
+    AttributeMatrix::Pointer sourceAM = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_EQUAL(sourceAM->getNumberOfTuples(), numTuples)
+    StringDataArray::Pointer strings = sourceAM->getAttributeArrayAs<StringDataArray>(k_StringArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(strings.get())
+    DREAM3D_REQUIRE_EQUAL(strings->getNumberOfTuples(), numTuples)
+    DREAM3D_REQUIRE_EQUAL(strings->getValue(numTuples - 1), QString("Voxel %1").arg(numTuples - 1))
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   void operator()()
   {
@@ -885,6 +1056,8 @@ public:
     DREAM3D_REGISTER_TEST(TestCropVolume_2());
     DREAM3D_REGISTER_TEST(TestCropVolume_3());
     DREAM3D_REGISTER_TEST(TestCropVolume_4());
+    DREAM3D_REGISTER_TEST(TestCropMixedArraysInPlace());
+    DREAM3D_REGISTER_TEST(TestCropMixedArraysNewDataContainer());
   }
 
 private:
@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindTriangleGeomNeighbors.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
@@ -47,10 +50,15 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -58,6 +66,58 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+constexpr uint64_t k_InvalidPair = std::numeric_limits<uint64_t>::max();
+
+/**
+ * @brief Packs a (feature, neighbor) pair into a key that sorts by feature first and then by neighbor
+ */
+uint64_t MakeNeighborPair(int32_t feature, int32_t neighbor)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(feature)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(neighbor));
+}
+
+/**
+ * @brief The FindNeighborPairsImpl class writes both (feature, neighbor) directions of every face that separates
+ * two valid features. Faces touching feature 0, -1 or an out of range feature are written as k_InvalidPair.
+ */
+class FindNeighborPairsImpl
+{
+public:
+  FindNeighborPairsImpl(const int32_t* faceLabels, size_t totalFeatures, std::vector<uint64_t>& neighborPairs)
+  : m_FaceLabels(faceLabels)
+  , m_TotalFeatures(totalFeatures)
+  , m_NeighborPairs(neighborPairs)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t j = range.min(); j < range.max(); j++)
+    {
+      int32_t feature1 = m_FaceLabels[2 * j];
+      int32_t feature2 = m_FaceLabels[2 * j + 1];
+      if(feature1 > 0 && feature2 > 0 && static_cast<size_t>(feature1) < m_TotalFeatures && static_cast<size_t>(feature2) < m_TotalFeatures)
+      {
+        m_NeighborPairs[2 * j] = MakeNeighborPair(feature1, feature2);
+        m_NeighborPairs[2 * j + 1] = MakeNeighborPair(feature2, feature1);
+      }
+      else
+      {
+        m_NeighborPairs[2 * j] = k_InvalidPair;
+        m_NeighborPairs[2 * j + 1] = k_InvalidPair;
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FaceLabels;
+  size_t m_TotalFeatures;
+  std::vector<uint64_t>& m_NeighborPairs;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -157,87 +217,45 @@ void FindTriangleGeomNeighbors::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName());
   size_t totalFaces = m_FaceLabelsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
-  int32_t feature1 = 0;
-  int32_t feature2 = 0;
-  int32_t nnum = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
-  for(size_t i = 1; i < totalFeatures; i++)
+  // Every face contributes a (feature, neighbor) pair in each direction. Sorting and removing the duplicates
+  // leaves each feature's unique neighbors contiguous and in ascending order.
+  notifyStatusMessage("Finding Neighbors || Sorting Neighbor Pairs");
+  std::vector<uint64_t> neighborPairs(2 * totalFaces, k_InvalidPair);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0ULL, totalFaces);
+  dataAlg.execute(FindNeighborPairsImpl(m_FaceLabels, totalFeatures, neighborPairs));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(neighborPairs.begin(), neighborPairs.end());
+#else
+  std::sort(neighborPairs.begin(), neighborPairs.end());
+#endif
+  neighborPairs.erase(std::unique(neighborPairs.begin(), neighborPairs.end()), neighborPairs.end());
+  // The invalid pairs sort to the end
+  if(!neighborPairs.empty() && neighborPairs.back() == k_InvalidPair)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
+    neighborPairs.pop_back();
   }
 
-  for(size_t j = 0; j < totalFaces; j++)
+  if(getCancel())
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalFaces) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    feature1 = m_FaceLabels[2 * j];
-    feature2 = m_FaceLabels[2 * j + 1];
-    if(feature1 > 0)
-    {
-      if(feature2 > 0)
-      {
-        nnum = m_NumNeighbors[feature1];
-        neighborlist[feature1].push_back(feature2);
-        nnum++;
-        m_NumNeighbors[feature1] = nnum;
-      }
-    }
-    if(feature2 > 0)
-    {
-      if(feature1 > 0)
-      {
-        nnum = m_NumNeighbors[feature2];
-        neighborlist[feature2].push_back(feature1);
-        nnum++;
-        m_NumNeighbors[feature2] = nnum;
-      }
-    }
+    return;
   }
 
+  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
+  uint64_t currentMillis = millis;
+
   // We do this to create new set of NeighborList objects
+  size_t pairIndex = 0;
   for(size_t i = 1; i < totalFeatures; i++)
   {
     currentMillis = QDateTime::currentMSecsSinceEpoch();
     if(currentMillis - millis > 1000)
     {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
+      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
       notifyStatusMessage(ss);
       millis = QDateTime::currentMSecsSinceEpoch();
     }
@@ -247,34 +265,14 @@ void FindTriangleGeomNeighbors::execute()
       return;
     }
 
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key(); // get the neighbor feature
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
-
     // Set the vector for each list into the NeighborList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    while(pairIndex < neighborPairs.size() && (neighborPairs[pairIndex] >> 32) == i)
+    {
+      sharedNeiLst->push_back(static_cast<int32_t>(static_cast<uint32_t>(neighborPairs[pairIndex] & 0xFFFFFFFFULL)));
+      pairIndex++;
+    }
+    m_NumNeighbors[i] = static_cast<int32_t>(sharedNeiLst->size());
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 }
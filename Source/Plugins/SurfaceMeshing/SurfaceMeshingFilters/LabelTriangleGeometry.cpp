@@ -14,6 +14,10 @@
 
 #include "LabelTriangleGeometry.h"
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -26,10 +30,15 @@
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -39,6 +48,79 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+/**
+ * @brief The TriangleEdge struct is one edge of a triangle with its vertex ids in ascending order
+ */
+struct TriangleEdge
+{
+  MeshIndexType v0;
+  MeshIndexType v1;
+  MeshIndexType tri;
+
+  bool operator<(const TriangleEdge& other) const
+  {
+    return std::tie(v0, v1, tri) < std::tie(other.v0, other.v1, other.tri);
+  }
+};
+
+/**
+ * @brief The FindTriangleEdgesImpl class writes the 3 edges of every triangle
+ */
+class FindTriangleEdgesImpl
+{
+public:
+  FindTriangleEdgesImpl(const MeshIndexType* triangles, std::vector<TriangleEdge>& edges)
+  : m_Triangles(triangles)
+  , m_Edges(edges)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      const MeshIndexType* verts = m_Triangles + 3 * i;
+      for(size_t e = 0; e < 3; e++)
+      {
+        MeshIndexType v0 = verts[e];
+        MeshIndexType v1 = verts[(e + 1) % 3];
+        m_Edges[3 * i + e] = {std::min(v0, v1), std::max(v0, v1), i};
+      }
+    }
+  }
+
+private:
+  const MeshIndexType* m_Triangles;
+  std::vector<TriangleEdge>& m_Edges;
+};
+
+MeshIndexType FindRoot(std::vector<MeshIndexType>& parents, MeshIndexType tri)
+{
+  while(parents[tri] != tri)
+  {
+    parents[tri] = parents[parents[tri]];
+    tri = parents[tri];
+  }
+  return tri;
+}
+
+/**
+ * @brief Merges the regions of two triangles. The smaller root always survives so that the root of a region
+ * is its first triangle.
+ */
+void UniteTriangles(std::vector<MeshIndexType>& parents, MeshIndexType tri1, MeshIndexType tri2)
+{
+  MeshIndexType root1 = FindRoot(parents, tri1);
+  MeshIndexType root2 = FindRoot(parents, tri2);
+  if(root1 != root2)
+  {
+    parents[std::max(root1, root2)] = std::min(root1, root2);
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -151,62 +233,67 @@ void LabelTriangleGeometry::execute()
 
   DataContainer::Pointer dataContainerCAD = getDataContainerArray()->getDataContainer(getCADDataContainerPath());
 
-  int check = triangle->findElementNeighbors();
-  if(check < 0)
+  // first identify connected triangle sets as features. Every triangle starts as its own region and the regions
+  // of triangles that share an edge are merged.
+  std::vector<MeshIndexType> parents(numTris);
+  std::iota(parents.begin(), parents.end(), 0);
+
+  ElementDynamicList::Pointer triangleNeighbors = triangle->getElementNeighbors();
+  if(nullptr != triangleNeighbors.get())
   {
-    QString ss = "Error finding element neighbors";
-    setErrorCondition(check, ss);
-    return;
+    // Reuse the element neighbors if they were already generated (Generate Geometry Connectivity)
+    for(size_t i = 0; i < numTris; i++)
+    {
+      uint16_t tCount = triangleNeighbors->getNumberOfElements(i);
+      MeshIndexType* data = triangleNeighbors->getElementListPointer(i);
+      for(uint16_t j = 0; j < tCount; j++)
+      {
+        UniteTriangles(parents, i, data[j]);
+      }
+    }
+  }
+  else
+  {
+    // Sorting the edges brings the triangles that share an edge next to each other, which avoids building the
+    // vertex to triangle and triangle neighbor lists on the geometry
+    notifyStatusMessage("Sorting Triangle Edges");
+    std::vector<TriangleEdge> edges(3 * numTris);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0ULL, numTris);
+    dataAlg.execute(FindTriangleEdgesImpl(triangle->getTriangles()->getPointer(0), edges));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_sort(edges.begin(), edges.end());
+#else
+    std::sort(edges.begin(), edges.end());
+#endif
+
+    for(size_t e = 1; e < edges.size(); e++)
+    {
+      if(edges[e].v0 == edges[e - 1].v0 && edges[e].v1 == edges[e - 1].v1)
+      {
+        UniteTriangles(parents, edges[e - 1].tri, edges[e].tri);
+      }
+    }
   }
 
-  ElementDynamicList::Pointer m_TriangleNeighbors = triangle->getElementNeighbors();
+  if(getCancel())
+  {
+    return;
+  }
 
-  size_t chunkSize = 1000;
-  std::vector<int32_t> triList(chunkSize, -1);
-  std::vector<uint32_t> triangleCounts = {0, 0};
-  // first identify connected triangle sets as features
-  size_t size = 0;
+  // Regions are numbered in the order of their first triangle
   int32_t regionCount = 1;
   for(size_t i = 0; i < numTris; i++)
   {
-    if(m_RegionId[i] == 0)
-    {
-      m_RegionId[i] = regionCount;
-      triangleCounts[regionCount]++;
+    MeshIndexType root = FindRoot(parents, i);
+    m_RegionId[i] = (root == i) ? regionCount++ : m_RegionId[root];
+  }
 
-      size = 0;
-      triList[size] = i;
-      size++;
-      while(size > 0)
-      {
-        MeshIndexType tri = triList[size - 1];
-        size -= 1;
-        uint16_t tCount = m_TriangleNeighbors->getNumberOfElements(tri);
-        MeshIndexType* data = m_TriangleNeighbors->getElementListPointer(tri);
-        for(int j = 0; j < tCount; j++)
-        {
-          MeshIndexType neighTri = data[j];
-          if(m_RegionId[neighTri] == 0)
-          {
-            m_RegionId[neighTri] = regionCount;
-            triangleCounts[regionCount]++;
-            triList[size] = neighTri;
-            size++;
-            if(size >= triList.size())
-            {
-              size = triList.size();
-              triList.resize(size + chunkSize);
-              for(std::vector<int64_t>::size_type k = size; k < triList.size(); ++k)
-              {
-                triList[k] = -1;
-              }
-            }
-          }
-        }
-      }
-      regionCount++;
-      triangleCounts.push_back(0);
-    }
+  std::vector<uint64_t> triangleCounts(static_cast<size_t>(regionCount) + 1, 0);
+  for(size_t i = 0; i < numTris; i++)
+  {
+    triangleCounts[m_RegionId[i]]++;
   }
 
   // Resize the Triangle Region AttributeMatrix
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "QuickSurfaceMesh.h"
 
+#include "Generic/GenericFilters/Utils/FilterTrace.hpp"
+
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
@@ -1530,11 +1532,14 @@ void QuickSurfaceMesh::execute()
   }
   IGeometryGrid::Pointer grid = m->getGeometryAs<IGeometryGrid>();
 
+  FilterTrace::Session trace(getNameOfClass());
+
   SizeVec3Type udims = grid->getDimensions();
 
   size_t xP = udims[0];
   size_t yP = udims[1];
   size_t zP = udims[2];
+  size_t totalPoints = xP * yP * zP;
 
   std::vector<std::set<int32_t>> ownerLists;
 
@@ -1546,75 +1551,88 @@ void QuickSurfaceMesh::execute()
 
   if(getFixProblemVoxels())
   {
+    FilterTrace::ScopedPhase phase(trace, "Correct Problem Voxels", totalPoints);
     correctProblemVoxels();
   }
 
-  determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
+  {
+    FilterTrace::ScopedPhase phase(trace, "Determine Active Nodes", totalPoints, possibleNumNodes * sizeof(size_t));
+    determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
+  }
+  trace.counter("Nodes", nodeCount);
+  trace.counter("Triangles", triangleCount);
 
   // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triangleCount);
   triangleGeom->resizeVertexList(nodeCount);
 
-  createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
-
-  MeshIndexType* triangle = triangleGeom->getTriPointer(0);
-
-  FloatArrayType::Pointer vertices = triangleGeom->getVertices();
-  SharedEdgeList::Pointer edges = EdgeGeom::CreateSharedEdgeList(0);
-  EdgeGeom::Pointer edgeGeom = EdgeGeom::CreateGeometry(edges, vertices, SIMPL::Geometry::EdgeGeometry);
-  tripleLineDC->setGeometry(edgeGeom);
-
-  MeshIndexType edgeCount = 0;
-  for(MeshIndexType i = 0; i < triangleCount; i++)
   {
-    MeshIndexType n1 = triangle[3 * i + 0];
-    MeshIndexType n2 = triangle[3 * i + 1];
-    MeshIndexType n3 = triangle[3 * i + 2];
-    if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n2] >= 3)
-    {
-      edgeCount++;
-    }
-    if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n3] >= 3)
-    {
-      edgeCount++;
-    }
-    if(m_NodeTypes[n2] >= 3 && m_NodeTypes[n3] >= 3)
-    {
-      edgeCount++;
-    }
+    FilterTrace::ScopedPhase phase(trace, "Create Nodes And Triangles", totalPoints, possibleNumNodes * sizeof(size_t));
+    createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
   }
 
-  edgeGeom->resizeEdgeList(edgeCount);
-  MeshIndexType* edge = edgeGeom->getEdgePointer(0);
-  edgeCount = 0;
-  for(MeshIndexType i = 0; i < triangleCount; i++)
   {
-    MeshIndexType n1 = triangle[3 * i + 0];
-    MeshIndexType n2 = triangle[3 * i + 1];
-    MeshIndexType n3 = triangle[3 * i + 2];
-    if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n2] >= 3)
-    {
-      edge[2 * edgeCount] = n1;
-      edge[2 * edgeCount + 1] = n2;
-      edgeCount++;
-    }
-    if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n3] >= 3)
+    FilterTrace::ScopedPhase phase(trace, "Create Triple Line Edges", triangleCount);
+    MeshIndexType* triangle = triangleGeom->getTriPointer(0);
+
+    FloatArrayType::Pointer vertices = triangleGeom->getVertices();
+    SharedEdgeList::Pointer edges = EdgeGeom::CreateSharedEdgeList(0);
+    EdgeGeom::Pointer edgeGeom = EdgeGeom::CreateGeometry(edges, vertices, SIMPL::Geometry::EdgeGeometry);
+    tripleLineDC->setGeometry(edgeGeom);
+
+    MeshIndexType edgeCount = 0;
+    for(MeshIndexType i = 0; i < triangleCount; i++)
     {
-      edge[2 * edgeCount] = n1;
-      edge[2 * edgeCount + 1] = n3;
-      edgeCount++;
+      MeshIndexType n1 = triangle[3 * i + 0];
+      MeshIndexType n2 = triangle[3 * i + 1];
+      MeshIndexType n3 = triangle[3 * i + 2];
+      if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n2] >= 3)
+      {
+        edgeCount++;
+      }
+      if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n3] >= 3)
+      {
+        edgeCount++;
+      }
+      if(m_NodeTypes[n2] >= 3 && m_NodeTypes[n3] >= 3)
+      {
+        edgeCount++;
+      }
     }
-    if(m_NodeTypes[n2] >= 3 && m_NodeTypes[n3] >= 3)
+
+    edgeGeom->resizeEdgeList(edgeCount);
+    MeshIndexType* edge = edgeGeom->getEdgePointer(0);
+    edgeCount = 0;
+    for(MeshIndexType i = 0; i < triangleCount; i++)
     {
-      edge[2 * edgeCount] = n2;
-      edge[2 * edgeCount + 1] = n3;
-      edgeCount++;
+      MeshIndexType n1 = triangle[3 * i + 0];
+      MeshIndexType n2 = triangle[3 * i + 1];
+      MeshIndexType n3 = triangle[3 * i + 2];
+      if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n2] >= 3)
+      {
+        edge[2 * edgeCount] = n1;
+        edge[2 * edgeCount + 1] = n2;
+        edgeCount++;
+      }
+      if(m_NodeTypes[n1] >= 3 && m_NodeTypes[n3] >= 3)
+      {
+        edge[2 * edgeCount] = n1;
+        edge[2 * edgeCount + 1] = n3;
+        edgeCount++;
+      }
+      if(m_NodeTypes[n2] >= 3 && m_NodeTypes[n3] >= 3)
+      {
+        edge[2 * edgeCount] = n2;
+        edge[2 * edgeCount + 1] = n3;
+        edgeCount++;
+      }
     }
   }
   if(m_GenerateTripleLines)
   {
-      generateTripleLines();
+    FilterTrace::ScopedPhase phase(trace, "Generate Triple Lines");
+    generateTripleLines();
   }
 }
 
@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SharedFeatureFaceFilter.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -55,6 +58,105 @@ enum createdPathID : RenameDataPath::DataID_t
   AttributeMatrixID21 = 21,
 };
 
+namespace
+{
+/**
+ * @brief The FaceLabelPairTable class is an open addressing hash table that maps a packed (smaller label, larger label)
+ * pair to the Feature face id assigned to it. Ids are handed out by the caller starting at 1, so an id of 0 marks an
+ * empty slot. The table doubles whenever it becomes half full.
+ */
+class FaceLabelPairTable
+{
+public:
+  FaceLabelPairTable()
+  {
+    m_Keys.resize(1024, 0);
+    m_Ids.resize(1024, 0);
+  }
+
+  static uint64_t PackLabels(int32_t label0, int32_t label1)
+  {
+    return static_cast<uint64_t>(static_cast<uint32_t>(label0)) | (static_cast<uint64_t>(static_cast<uint32_t>(label1)) << 32);
+  }
+
+  /**
+   * @brief findOrInsert Returns the id stored for key, or stores newId for it if the key is not in the table yet
+   * @param key Packed label pair
+   * @param newId Id to store for a new key (must be > 0)
+   * @return
+   */
+  int32_t findOrInsert(uint64_t key, int32_t newId)
+  {
+    size_t slot = findSlot(key);
+    if(m_Ids[slot] != 0)
+    {
+      return m_Ids[slot];
+    }
+    m_Keys[slot] = key;
+    m_Ids[slot] = newId;
+    m_Size++;
+    if(2 * m_Size > m_Ids.size())
+    {
+      grow();
+    }
+    return newId;
+  }
+
+  /**
+   * @brief find Returns the id stored for key, or 0 if the key is not in the table
+   * @param key Packed label pair
+   * @return
+   */
+  int32_t find(uint64_t key) const
+  {
+    return m_Ids[findSlot(key)];
+  }
+
+private:
+  std::vector<uint64_t> m_Keys;
+  std::vector<int32_t> m_Ids;
+  size_t m_Size = 0;
+
+  static size_t Hash(uint64_t key)
+  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+  }
+
+  size_t findSlot(uint64_t key) const
+  {
+    size_t mask = m_Ids.size() - 1;
+    size_t slot = Hash(key) & mask;
+    while(m_Ids[slot] != 0 && m_Keys[slot] != key)
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void grow()
+  {
+    std::vector<uint64_t> keys(2 * m_Keys.size(), 0);
+    std::vector<int32_t> ids(2 * m_Ids.size(), 0);
+    m_Keys.swap(keys);
+    m_Ids.swap(ids);
+    for(size_t i = 0; i < ids.size(); i++)
+    {
+      if(ids[i] != 0)
+      {
+        size_t slot = findSlot(keys[i]);
+        m_Keys[slot] = keys[i];
+        m_Ids[slot] = ids[i];
+      }
+    }
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -182,70 +284,49 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
+  // Feature face ids are handed out in order of first appearance of each (smaller label, larger label) pair
+  FaceLabelPairTable faceIdTable;
   int32_t index = 1;
-  struct
-  {
-    int g;
-    int r;
-  } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
   int32_t fl0 = -1;
   int32_t fl1 = -1;
 
-  std::vector<std::pair<int32_t, int32_t>> faceLabelMap;
-  faceLabelMap.push_back(std::pair<int32_t, int32_t>(0, 0));
+  std::vector<int32_t> faceLabels = {0, 0};
+  std::vector<int32_t> faceSizes = {0};
 
   // Loop through all the Triangles and figure out how many triangles we have in each one.
   for(int64_t t = 0; t < totalPoints; ++t)
   {
     fl0 = m_SurfaceMeshFaceLabels[t * 2];
     fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if(fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
+    if(fl1 < fl0)
     {
-      faceId.g = fl1;
-      faceId.r = fl0;
+      std::swap(fl0, fl1);
     }
 
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter == faceSizeMap.end())
+    int32_t featureFaceId = faceIdTable.findOrInsert(FaceLabelPairTable::PackLabels(fl0, fl1), index);
+    if(featureFaceId == index)
     {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back(std::pair<int32_t, int32_t>(faceId.g, faceId.r));
+      faceLabels.push_back(fl0);
+      faceLabels.push_back(fl1);
+      faceSizes.push_back(0);
       ++index;
     }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
+    faceSizes[featureFaceId]++;
+    m_SurfaceMeshFeatureFaceIds[t] = featureFaceId;
   }
 
+  // Feature face 0 reports the number of triangles whose labels are both 0
+  int32_t zeroFaceId = faceIdTable.find(FaceLabelPairTable::PackLabels(0, 0));
+  faceSizes[0] = (zeroFaceId != 0) ? faceSizes[zeroFaceId] : 0;
+
   // resize + update pointers
   std::vector<size_t> tDims(1, index);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
   m_SurfaceMeshFeatureFaceNumTriangles = m_SurfaceMeshFeatureFaceNumTrianglesPtr.lock()->getPointer(0);
 
-  for(int32_t i = 0; i < index; i++)
-  {
-    // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
-
-    // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
-  }
+  std::copy(faceLabels.begin(), faceLabels.end(), m_SurfaceMeshFeatureFaceLabels);
+  std::copy(faceSizes.begin(), faceSizes.end(), m_SurfaceMeshFeatureFaceNumTriangles);
 }
 
 // -----------------------------------------------------------------------------
@@ -489,6 +489,103 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  // Faces touching feature 0 or -1 add no neighbors, duplicate faces add a neighbor once and a face with the same
+  // label on both sides lists the feature as its own neighbor once, as the neighbor counting always did. Feature 4
+  // has no faces at all.
+  // -----------------------------------------------------------------------------
+  int TestInvalidAndEqualLabels()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    // Only the face labels are read, so the triangles do not need to form a closed surface
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(10);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(8, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    size_t* tris = triangle->getTriPointer(0);
+    for(size_t v = 0; v < 10; v++)
+    {
+      vertices[3 * v + 0] = static_cast<float>(v);
+      vertices[3 * v + 1] = static_cast<float>(v % 2);
+      vertices[3 * v + 2] = 0.0f;
+    }
+    for(size_t t = 0; t < 8; t++)
+    {
+      tris[3 * t + 0] = t;
+      tris[3 * t + 1] = t + 1;
+      tris[3 * t + 2] = t + 2;
+    }
+
+    std::vector<size_t> tDims(1, 8);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    tDims[0] = 5;
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceFeatureAttributeMatrixName, AttributeMatrix::Type::FaceFeature);
+    tdc->addOrReplaceAttributeMatrix(featAttrMat);
+    std::vector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(8, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+    faceAttrMat->insertOrAssign(faceLabels);
+
+    const int32_t labels[8][2] = {{1, 2}, {0, 1}, {-1, 3}, {2, 2}, {3, 0}, {2, -1}, {2, 1}, {3, 1}};
+    for(size_t t = 0; t < 8; t++)
+    {
+      faceLabels->setComponent(t, 0, labels[t][0]);
+      faceLabels->setComponent(t, 1, labels[t][1]);
+    }
+
+    QString filtName = "FindTriangleGeomNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer neighborsFilter = factory->create();
+    DREAM3D_REQUIRE(neighborsFilter.get() != nullptr)
+
+    neighborsFilter->setDataContainerArray(dca);
+
+    bool propWasSet = true;
+    QVariant var;
+
+    DataArrayPath path(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    var.setValue(path);
+    propWasSet = neighborsFilter->setProperty("FaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    path.update(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceFeatureAttributeMatrixName, "");
+    var.setValue(path);
+    propWasSet = neighborsFilter->setProperty("FeatureAttributeMatrixPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    neighborsFilter->execute();
+    int32_t err = neighborsFilter->getErrorCode();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    AttributeMatrix::Pointer faceFeatAttrMat = tdc->getAttributeMatrix(SIMPL::Defaults::FaceFeatureAttributeMatrixName);
+    Int32ArrayType::Pointer numNeighbors = faceFeatAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumNeighbors);
+    NeighborList<int32_t>::Pointer neighborList = faceFeatAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get());
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get());
+    DREAM3D_REQUIRE_EQUAL(numNeighbors->getNumberOfTuples(), 5);
+
+    const std::vector<std::vector<int32_t>> expectedNeighbors = {{}, {2, 3}, {1, 2}, {1}, {}};
+    for(size_t i = 1; i < 5; i++)
+    {
+      std::vector<int32_t> neighbors = neighborList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(i), static_cast<int32_t>(expectedNeighbors[i].size()));
+      DREAM3D_REQUIRE_EQUAL(neighbors.size(), expectedNeighbors[i].size());
+      for(size_t n = 0; n < neighbors.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(neighbors[n], expectedNeighbors[i][n]);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -500,6 +597,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(TestFindTriangleGeomNeighborsTest())
+    DREAM3D_REGISTER_TEST(TestInvalidAndEqualLabels())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
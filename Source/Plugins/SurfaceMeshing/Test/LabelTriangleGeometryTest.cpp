@@ -0,0 +1,250 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class LabelTriangleGeometryTest
+{
+  const QString k_FaceDataName = {"FaceData"};
+  const QString k_RegionDataName = {"RegionData"};
+  const QString k_RegionIdsName = {"RegionIds"};
+  const QString k_NumTrianglesName = {"NumTriangles"};
+
+public:
+  LabelTriangleGeometryTest() = default;
+  ~LabelTriangleGeometryTest() = default;
+
+  /**
+   * @brief Returns the name of the class for LabelTriangleGeometryTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("LabelTriangleGeometryTest");
+  }
+
+  LabelTriangleGeometryTest(const LabelTriangleGeometryTest&) = delete;            // Copy Constructor Not Implemented
+  LabelTriangleGeometryTest(LabelTriangleGeometryTest&&) = delete;                 // Move Constructor Not Implemented
+  LabelTriangleGeometryTest& operator=(const LabelTriangleGeometryTest&) = delete; // Copy Assignment Not Implemented
+  LabelTriangleGeometryTest& operator=(LabelTriangleGeometryTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the LabelTriangleGeometry Filter from the FilterManager
+    QString filtName = "LabelTriangleGeometry";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Four bodies whose triangles are interleaved:
+  //   a tetrahedron on vertices 0-3 (triangles 0, 3, 6 and 7)
+  //   two triangles on vertices 4-6 and 6-8 that only share vertex 6 (triangles 1 and 4), so they are two bodies
+  //   a strip of two triangles on vertices 9-12 that share the edge 10-11 with opposite windings (triangles 2 and 5)
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(13);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(8, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+
+    const float vertices[13][3] = {{0.0F, 0.0F, 0.0F}, {1.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}, {0.0F, 0.0F, 1.0F}, {3.0F, 0.0F, 0.0F}, {4.0F, 0.0F, 0.0F}, {4.0F, 1.0F, 0.0F},
+                                   {5.0F, 1.0F, 0.0F}, {5.0F, 2.0F, 0.0F}, {7.0F, 0.0F, 0.0F}, {8.0F, 0.0F, 0.0F}, {7.0F, 1.0F, 0.0F}, {8.0F, 1.0F, 0.0F}};
+    float* vertexPtr = triangle->getVertexPointer(0);
+    for(size_t v = 0; v < 13; v++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        vertexPtr[3 * v + c] = vertices[v][c];
+      }
+    }
+
+    const MeshIndexType tris[8][3] = {{0, 2, 1}, {4, 5, 6}, {9, 10, 11}, {0, 1, 3}, {6, 7, 8}, {10, 12, 11}, {0, 3, 2}, {1, 2, 3}};
+    MeshIndexType* triPtr = triangle->getTriPointer(0);
+    for(size_t t = 0; t < 8; t++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        triPtr[3 * t + c] = tris[t][c];
+      }
+    }
+
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New({8}, k_FaceDataName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  int runFilter(const DataContainerArray::Pointer& dca)
+  {
+    QString filtName = "LabelTriangleGeometry";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer labelFilter = factory->create();
+    DREAM3D_REQUIRE(labelFilter.get() != nullptr)
+
+    labelFilter->setDataContainerArray(dca);
+
+    bool propWasSet = true;
+    QVariant var;
+
+    DataArrayPath path(SIMPL::Defaults::TriangleDataContainerName, "", "");
+    var.setValue(path);
+    propWasSet = labelFilter->setProperty("CADDataContainerPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    path.update(SIMPL::Defaults::TriangleDataContainerName, k_FaceDataName, k_RegionIdsName);
+    var.setValue(path);
+    propWasSet = labelFilter->setProperty("RegionIdArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(k_RegionDataName);
+    propWasSet = labelFilter->setProperty("TriangleAttributeMatrixName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(k_NumTrianglesName);
+    propWasSet = labelFilter->setProperty("NumTrianglesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    labelFilter->execute();
+    int32_t err = labelFilter->getErrorCode();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Regions are numbered in the order of their first triangle, and NumTriangles keeps the unused tuple 0 and the
+  // trailing empty tuple the filter has always written
+  // -----------------------------------------------------------------------------
+  int checkRegions(const DataContainerArray::Pointer& dca)
+  {
+    DataContainer::Pointer tdc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    Int32ArrayType::Pointer regionIds = tdc->getAttributeMatrix(k_FaceDataName)->getAttributeArrayAs<Int32ArrayType>(k_RegionIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(regionIds.get());
+    const int32_t expectedRegionIds[8] = {1, 2, 3, 1, 4, 3, 1, 1};
+    DREAM3D_REQUIRE_EQUAL(regionIds->getNumberOfTuples(), 8);
+    for(size_t t = 0; t < 8; t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(regionIds->getValue(t), expectedRegionIds[t]);
+    }
+
+    AttributeMatrix::Pointer regionAttrMat = tdc->getAttributeMatrix(k_RegionDataName);
+    DREAM3D_REQUIRE_VALID_POINTER(regionAttrMat.get());
+    UInt64ArrayType::Pointer numTriangles = regionAttrMat->getAttributeArrayAs<UInt64ArrayType>(k_NumTrianglesName);
+    DREAM3D_REQUIRE_VALID_POINTER(numTriangles.get());
+    const uint64_t expectedNumTriangles[6] = {0, 4, 1, 2, 1, 0};
+    DREAM3D_REQUIRE_EQUAL(regionAttrMat->getNumberOfTuples(), 6);
+    DREAM3D_REQUIRE_EQUAL(numTriangles->getNumberOfTuples(), 6);
+    for(size_t r = 0; r < 6; r++)
+    {
+      DREAM3D_REQUIRE_EQUAL(numTriangles->getValue(r), expectedNumTriangles[r]);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Without element neighbors on the geometry the filter unites the triangles through their sorted edges
+  // -----------------------------------------------------------------------------
+  int TestLabelSortedEdges()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE(triangle->getElementNeighbors().get() == nullptr)
+
+    int err = runFilter(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    DREAM3D_REQUIRE(triangle->getElementNeighbors().get() == nullptr)
+    return checkRegions(dca);
+  }
+
+  // -----------------------------------------------------------------------------
+  // With element neighbors already on the geometry the filter reuses them
+  // -----------------------------------------------------------------------------
+  int TestLabelElementNeighbors()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE(triangle->findElementNeighbors() >= 0)
+    DREAM3D_REQUIRE(triangle->getElementNeighbors().get() != nullptr)
+
+    int err = runFilter(dca);
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS);
+    return checkRegions(dca);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestLabelSortedEdges())
+    DREAM3D_REGISTER_TEST(TestLabelElementNeighbors())
+  }
+
+private:
+};
@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "InsertAtoms.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/DynamicListArray.hpp"
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -75,79 +78,63 @@ enum createdPathID : RenameDataPath::DataID_t
 };
 
 /**
- * @brief The InsertAtomsImpl class implements a threaded algorithm that inserts vertex points ('atoms') onto surface meshed Features
+ * @brief The InsertAtomsImpl class implements a threaded algorithm that inserts vertex points ('atoms') onto surface meshed Features.
+ * The surface of each Feature is rotated into its crystal frame, where every lattice row runs along x. Each row is intersected
+ * with the Feature's Triangles once and the atoms that fall between an entering and an exiting crossing are emitted directly.
+ * The algorithm runs twice: the first pass only counts the atoms of each Feature, and the second pass writes them into the
+ * preallocated output at each Feature's offset.
  */
 class InsertAtomsImpl
 {
   TriangleGeom::Pointer m_Faces;
   Int32Int32DynamicListArray::Pointer m_FaceIds;
-  VertexGeom::Pointer m_FaceBBs;
   float* m_AvgQuats;
   FloatVec3Type m_LatticeConstants;
   uint32_t m_Basis;
-  QVector<VertexGeom::Pointer> m_Points;
-  QVector<BoolArrayType::Pointer> m_InFeature;
+  int64_t* m_AtomCounts;
+  const int64_t* m_AtomOffsets;
+  float* m_Vertices;
+  int32_t* m_AtomFeatureLabels;
+
+  static constexpr int32_t k_MaxSiteAtoms = 5;
 
 public:
-  InsertAtomsImpl(const TriangleGeom::Pointer& faces, const Int32Int32DynamicListArray::Pointer& faceIds, const VertexGeom::Pointer& faceBBs, float* avgQuats, FloatVec3Type latticeConstants,
-                  uint32_t basis, const QVector<VertexGeom::Pointer>& points, const QVector<BoolArrayType::Pointer>& inFeature)
+  InsertAtomsImpl(const TriangleGeom::Pointer& faces, const Int32Int32DynamicListArray::Pointer& faceIds, float* avgQuats, FloatVec3Type latticeConstants, uint32_t basis, int64_t* atomCounts,
+                  const int64_t* atomOffsets, float* vertices, int32_t* atomFeatureLabels)
   : m_Faces(faces)
   , m_FaceIds(faceIds)
-  , m_FaceBBs(faceBBs)
   , m_AvgQuats(avgQuats)
   , m_LatticeConstants(latticeConstants)
   , m_Basis(basis)
-  , m_Points(points)
-  , m_InFeature(inFeature)
+  , m_AtomCounts(atomCounts)
+  , m_AtomOffsets(atomOffsets)
+  , m_Vertices(vertices)
+  , m_AtomFeatureLabels(atomFeatureLabels)
   {
   }
   virtual ~InsertAtomsImpl() = default;
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
-    FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Lower_Left"), true);
-    FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Upper_Right"), true);
-    FloatArrayType::Pointer ll_rotPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Lower_Left_Rotated"), true);
-    FloatArrayType::Pointer ur_rotPtr = FloatArrayType::CreateArray(3, std::string("_INTERNAL_USE_ONLY_Upper_Right_Rotated"), true);
-    float* ll = llPtr->getPointer(0);
-    float* ur = urPtr->getPointer(0);
-    float* ll_rot = ll_rotPtr->getPointer(0);
-    float* ur_rot = ur_rotPtr->getPointer(0);
-    float* point = nullptr;
-    char code = ' ';
-    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-
     for(size_t iter = start; iter < end; iter++)
     {
-      Int32Int32DynamicListArray::ElementList& faceIds = m_FaceIds->getElementList(iter);
+      if(nullptr == m_Vertices)
       {
-        float* currentAvgQuatPtr = m_AvgQuats + iter * 4;
-        QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-        OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g);
+        int64_t count = 0;
+        insertAtoms(iter, [&count](const float* /*coords*/) { count++; });
+        m_AtomCounts[iter] = count;
       }
-      // find bounding box for current feature
-      GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), faceIds, ll, ur);
-      GeometryMath::FindBoundingBoxOfRotatedFaces(m_Faces.get(), faceIds, g, ll_rot, ur_rot);
-      GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
-
-      generatePoints(iter, m_Points, m_InFeature, m_AvgQuats, m_LatticeConstants, m_Basis, ll_rot, ur_rot);
-
-      // check points in vertex array to see if they are in the bounding box of the feature
-      int64_t numPoints = m_Points[iter]->getNumberOfVertices();
-      VertexGeom::Pointer vertArray = m_Points[iter];
-      BoolArrayType::Pointer boolArray = m_InFeature[iter];
-      for(int64_t i = 0; i < numPoints; i++)
+      else
       {
-        point = vertArray->getVertexPointer(i);
-        if(!boolArray->getValue(i))
-        {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), faceIds, m_FaceBBs.get(), point, ll, ur, radius);
-          if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-          {
-            m_InFeature[iter]->setValue(i, true);
-          }
-        }
+        int64_t index = m_AtomOffsets[iter];
+        int32_t featureId = static_cast<int32_t>(iter);
+        insertAtoms(iter, [&](const float* coords) {
+          m_Vertices[3 * index] = coords[0];
+          m_Vertices[3 * index + 1] = coords[1];
+          m_Vertices[3 * index + 2] = coords[2];
+          m_AtomFeatureLabels[index] = featureId;
+          index++;
+        });
       }
     }
   }
@@ -159,129 +146,288 @@ public:
   }
 #endif
 
-  void generatePoints(size_t iter, QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature, float* m_AvgQuats, FloatVec3Type latticeConstants, uint32_t basis, const float* ll,
-                      const float* ur) const
+  /**
+   * @brief generateSite Computes the crystal frame positions of the atoms on lattice site (i, j, k) in the order the basis adds them
+   * @param i Lattice index along x
+   * @param j Lattice index along y
+   * @param k Lattice index along z
+   * @param ll Lower corner of the lattice
+   * @param site Atom positions
+   * @return Number of atoms on the site
+   */
+  int32_t generateSite(int64_t i, int64_t j, int64_t k, const float* ll, float site[k_MaxSiteAtoms][3]) const
   {
-    float gT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    const FloatVec3Type& latticeConstants = m_LatticeConstants;
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    int32_t count = 0;
+    auto addAtom = [&]() {
+      site[count][0] = coords[0];
+      site[count][1] = coords[1];
+      site[count][2] = coords[2];
+      count++;
+    };
+
+    coords[0] = float(i) * latticeConstants[0] + ll[0];
+    coords[1] = float(j) * latticeConstants[1] + ll[1];
+    coords[2] = float(k) * latticeConstants[2] + ll[2];
+    addAtom();
+    if(m_Basis == 1)
+    {
+      coords[0] = coords[0] + (0.5f * latticeConstants[0]);
+      coords[1] = coords[1] + (0.5f * latticeConstants[1]);
+      coords[2] = coords[2] + (0.5f * latticeConstants[2]);
+      addAtom();
+    }
+    if(m_Basis == 2)
+    {
+      // makes the (0.5,0.5,0) atom
+      coords[0] = coords[0] + (0.5f * latticeConstants[0]);
+      coords[1] = coords[1] + (0.5f * latticeConstants[1]);
+      addAtom();
+      // makes the (0.5,0,0.5) atom
+      coords[1] = coords[1] - (0.5f * latticeConstants[1]);
+      coords[2] = coords[2] + (0.5f * latticeConstants[2]);
+      addAtom();
+      // makes the (0,0.5,0.5) atom
+      coords[0] = coords[0] - (0.5f * latticeConstants[0]);
+      coords[1] = coords[1] + (0.5f * latticeConstants[1]);
+      addAtom();
+    }
+    if(m_Basis == 3)
+    {
+      // (+0.25,+0.25,+0.25) for (0,0,0)
+      coords[0] = coords[0] + (0.25f * latticeConstants[0]);
+      coords[1] = coords[1] - (0.25f * latticeConstants[1]);
+      coords[2] = coords[2] - (0.25f * latticeConstants[2]);
+      addAtom();
+      // (+0.25,+0.25,+0.25) for (0.5,0.5,0)
+      coords[0] = coords[0] + (0.5f * latticeConstants[0]);
+      coords[1] = coords[1] + (0.5f * latticeConstants[1]);
+      addAtom();
+      // (+0.25,+0.25,+0.25) for (0.5,0,0.5)
+      coords[1] = coords[1] - (0.5f * latticeConstants[1]);
+      coords[2] = coords[2] + (0.5f * latticeConstants[2]);
+      addAtom();
+      // (+0.25,+0.25,+0.25) for (0,0.5,0.5)
+      coords[0] = coords[0] - (0.5f * latticeConstants[0]);
+      coords[1] = coords[1] + (0.5f * latticeConstants[1]);
+      addAtom();
+    }
+    return count;
+  }
+
+  /**
+   * @brief edgeSide Returns which side of the (y,z) projection of edge p->q the row at (u,v) passes. The edge
+   * is always evaluated with its end points in the same order, so the two Triangles sharing an edge see exactly
+   * opposite values. A row that hits the edge exactly is treated as displaced by (e, e^2) (simulation of simplicity),
+   * so every row crosses the surface through the interior of exactly one of the Triangles that meet there.
+   * @param p Edge start point
+   * @param q Edge end point
+   * @param u Row y coordinate
+   * @param v Row z coordinate
+   * @param weight Unperturbed signed area, used to interpolate the crossing
+   * @return -1, 1, or 0 for an edge that is a single point in projection
+   */
+  static int32_t edgeSide(const float* p, const float* q, float u, float v, float& weight)
+  {
+    bool swapped = (p[1] > q[1]) || (p[1] == q[1] && p[2] > q[2]);
+    if(swapped)
+    {
+      std::swap(p, q);
+    }
+    float du = q[1] - p[1];
+    float dv = q[2] - p[2];
+    weight = du * (v - p[2]) - dv * (u - p[1]);
+    float side = weight;
+    if(side == 0.0f)
+    {
+      side = (dv != 0.0f) ? -dv : du;
+    }
+    if(swapped)
+    {
+      weight = -weight;
+      side = -side;
+    }
+    return (side > 0.0f) ? 1 : ((side < 0.0f) ? -1 : 0);
+  }
+
+  /**
+   * @brief insertAtoms Calls func with the sample frame position of every atom that falls inside Feature iter,
+   * in lattice order
+   * @param iter Feature Id
+   * @param func Callable taking the atom position
+   */
+  template <typename Func>
+  void insertAtoms(size_t iter, Func&& func) const
+  {
+    Int32Int32DynamicListArray::ElementList& faceIds = m_FaceIds->getElementList(iter);
+    if(faceIds.ncells <= 0)
+    {
+      return;
+    }
+
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float gT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     {
       float* currentAvgQuatPtr = m_AvgQuats + iter * 4;
       QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-      float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
       OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g);
       MatrixMath::Transpose3x3(g, gT);
     }
-    float minx = ll[0];
-    float miny = ll[1];
-    float minz = ll[2];
-    float maxx = ur[0];
-    float maxy = ur[1];
-    float maxz = ur[2];
-    float deltaX = maxx - minx;
-    float deltaY = maxy - miny;
-    float deltaZ = maxz - minz;
-    int64_t atomMult = 1;
-    if(basis == 0)
+
+    // find bounding box for current feature in the crystal frame
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
+    GeometryMath::FindBoundingBoxOfRotatedFaces(m_Faces.get(), faceIds, g, ll, ur);
+
+    const FloatVec3Type& latticeConstants = m_LatticeConstants;
+    int64_t xPoints = (int64_t((ur[0] - ll[0]) / latticeConstants[0]) + 1);
+    int64_t yPoints = (int64_t((ur[1] - ll[1]) / latticeConstants[1]) + 1);
+    int64_t zPoints = (int64_t((ur[2] - ll[2]) / latticeConstants[2]) + 1);
+    if(xPoints <= 0 || yPoints <= 0 || zPoints <= 0)
     {
-      atomMult = 1;
+      return;
     }
-    if(basis == 1)
+    float site[k_MaxSiteAtoms][3];
+    const int32_t siteAtoms = generateSite(0, 0, 0, ll, site);
+
+    // rotate the Feature's Triangles into the crystal frame and bucket them by the lattice planes they can reach
+    const size_t numTris = static_cast<size_t>(faceIds.ncells);
+    std::vector<float> tris(9 * numTris);
+    std::vector<int64_t> triRows(4 * numTris);
+    std::vector<int64_t> planeOffsets(zPoints + 1, 0);
+    float* nodes = m_Faces->getVertexPointer(0);
+    MeshIndexType* triangles = m_Faces->getTriPointer(0);
+    for(size_t t = 0; t < numTris; t++)
     {
-      atomMult = 2;
+      MeshIndexType* tri = triangles + 3 * static_cast<size_t>(faceIds.cells[t]);
+      float* corners = tris.data() + 9 * t;
+      for(size_t c = 0; c < 3; c++)
+      {
+        MatrixMath::Multiply3x3with3x1(g, nodes + 3 * tri[c], corners + 3 * c);
+      }
+      // The basis offsets stay within one lattice constant of the site, so a two row margin is conservative
+      for(size_t d = 1; d < 3; d++)
+      {
+        float minCoord = std::min({corners[d], corners[3 + d], corners[6 + d]});
+        float maxCoord = std::max({corners[d], corners[3 + d], corners[6 + d]});
+        int64_t numRows = (d == 1) ? yPoints : zPoints;
+        int64_t lo = static_cast<int64_t>(std::floor((minCoord - ll[d]) / latticeConstants[d])) - 2;
+        int64_t hi = static_cast<int64_t>(std::floor((maxCoord - ll[d]) / latticeConstants[d])) + 2;
+        triRows[4 * t + 2 * (d - 1)] = std::max(lo, static_cast<int64_t>(0));
+        triRows[4 * t + 2 * (d - 1) + 1] = std::min(hi, numRows - 1);
+      }
+      for(int64_t k = triRows[4 * t + 2]; k <= triRows[4 * t + 3]; k++)
+      {
+        planeOffsets[k + 1]++;
+      }
     }
-    if(basis == 2)
+    for(int64_t k = 0; k < zPoints; k++)
     {
-      atomMult = 4;
+      planeOffsets[k + 1] += planeOffsets[k];
     }
-    if(basis == 3)
+    std::vector<size_t> planeTris(planeOffsets[zPoints]);
     {
-      atomMult = 8;
+      std::vector<int64_t> fill(planeOffsets.begin(), planeOffsets.end() - 1);
+      for(size_t t = 0; t < numTris; t++)
+      {
+        for(int64_t k = triRows[4 * t + 2]; k <= triRows[4 * t + 3]; k++)
+        {
+          planeTris[fill[k]++] = t;
+        }
+      }
     }
-    int64_t xPoints = (int64_t(deltaX / latticeConstants[0]) + 1);
-    int64_t yPoints = (int64_t(deltaY / latticeConstants[1]) + 1);
-    int64_t zPoints = (int64_t(deltaZ / latticeConstants[2]) + 1);
-    int64_t nPoints = atomMult * xPoints * yPoints * zPoints;
-
-    points[iter]->resizeVertexList(nPoints);
-    inFeature[iter]->resizeTuples(nPoints);
 
-    int64_t count = 0;
-    float coords[3] = {0.0f, 0.0f, 0.0f};
+    // every basis atom of a site lies on its own row, indexed by j * siteAtoms + atom
+    const size_t numRows = static_cast<size_t>(yPoints * siteAtoms);
+    std::vector<float> rowY(numRows);
+    std::vector<float> rowZ(numRows);
+    std::vector<std::vector<float>> rowCrossings(numRows);
+    std::vector<size_t> rowCursors(numRows);
     float coordsT[3] = {0.0f, 0.0f, 0.0f};
     for(int64_t k = 0; k < zPoints; k++)
     {
+      if(planeOffsets[k] == planeOffsets[k + 1])
+      {
+        continue;
+      }
       for(int64_t j = 0; j < yPoints; j++)
       {
-        for(int64_t i = 0; i < xPoints; i++)
+        generateSite(0, j, k, ll, site);
+        for(int32_t a = 0; a < siteAtoms; a++)
         {
-          coords[0] = float(i) * latticeConstants[0] + minx;
-          coords[1] = float(j) * latticeConstants[1] + miny;
-          coords[2] = float(k) * latticeConstants[2] + minz;
-          MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-          points[iter]->setCoords(count, coordsT);
-          count++;
-          if(basis == 1)
-          {
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-          }
-          if(basis == 2)
+          rowY[j * siteAtoms + a] = site[a][1];
+          rowZ[j * siteAtoms + a] = site[a][2];
+        }
+      }
+      for(size_t r = 0; r < numRows; r++)
+      {
+        rowCrossings[r].clear();
+        rowCursors[r] = 0;
+      }
+
+      for(int64_t idx = planeOffsets[k]; idx < planeOffsets[k + 1]; idx++)
+      {
+        size_t t = planeTris[idx];
+        const float* p0 = tris.data() + 9 * t;
+        const float* p1 = p0 + 3;
+        const float* p2 = p0 + 6;
+        for(int64_t j = triRows[4 * t]; j <= triRows[4 * t + 1]; j++)
+        {
+          for(int32_t a = 0; a < siteAtoms; a++)
           {
-            // makes the (0.5,0.5,0) atom
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // makes the (0.5,0,0.5) atom
-            coords[0] = coords[0];
-            coords[1] = coords[1] - (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // makes the (0,0.5,0.5) atom
-            coords[0] = coords[0] - (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
+            size_t r = static_cast<size_t>(j * siteAtoms + a);
+            float w0 = 0.0f, w1 = 0.0f, w2 = 0.0f;
+            int32_t s0 = edgeSide(p1, p2, rowY[r], rowZ[r], w0);
+            int32_t s1 = edgeSide(p2, p0, rowY[r], rowZ[r], w1);
+            int32_t s2 = edgeSide(p0, p1, rowY[r], rowZ[r], w2);
+            if(s0 == 0 || s0 != s1 || s0 != s2)
+            {
+              continue;
+            }
+            float sum = w0 + w1 + w2;
+            float x = (sum != 0.0f) ? (w0 * p0[0] + w1 * p1[0] + w2 * p2[0]) / sum : (p0[0] + p1[0] + p2[0]) / 3.0f;
+            x = std::max(x, std::min({p0[0], p1[0], p2[0]}));
+            x = std::min(x, std::max({p0[0], p1[0], p2[0]}));
+            rowCrossings[r].push_back(x);
           }
-          if(basis == 3)
+        }
+      }
+      for(size_t r = 0; r < numRows; r++)
+      {
+        std::sort(rowCrossings[r].begin(), rowCrossings[r].end());
+      }
+
+      // atoms between an entering and an exiting crossing (inclusive) are inside the Feature
+      for(int64_t j = 0; j < yPoints; j++)
+      {
+        const size_t firstRow = static_cast<size_t>(j * siteAtoms);
+        bool anyCrossings = false;
+        for(int32_t a = 0; a < siteAtoms; a++)
+        {
+          anyCrossings = anyCrossings || rowCrossings[firstRow + a].size() > 1;
+        }
+        if(!anyCrossings)
+        {
+          continue;
+        }
+        for(int64_t i = 0; i < xPoints; i++)
+        {
+          generateSite(i, j, k, ll, site);
+          for(int32_t a = 0; a < siteAtoms; a++)
           {
-            // (+0.25,+0.25,+0.25) for (0,0,0)
-            coords[0] = coords[0] + (0.25f * latticeConstants[0]);
-            coords[1] = coords[1] - (0.25f * latticeConstants[1]);
-            coords[2] = coords[2] - (0.25f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0.5,0.5,0)
-            coords[0] = coords[0] + (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0.5,0,0.5)
-            coords[0] = coords[0];
-            coords[1] = coords[1] - (0.5f * latticeConstants[1]);
-            coords[2] = coords[2] + (0.5f * latticeConstants[2]);
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
-            // (+0.25,+0.25,+0.25) for (0,0.5,0.5)
-            coords[0] = coords[0] - (0.5f * latticeConstants[0]);
-            coords[1] = coords[1] + (0.5f * latticeConstants[1]);
-            coords[2] = coords[2];
-            MatrixMath::Multiply3x3with3x1(gT, coords, coordsT);
-            points[iter]->setCoords(count, coordsT);
-            count++;
+            const std::vector<float>& crossings = rowCrossings[firstRow + a];
+            size_t& cursor = rowCursors[firstRow + a];
+            float x = site[a][0];
+            while(cursor + 1 < crossings.size() && crossings[cursor + 1] < x)
+            {
+              cursor += 2;
+            }
+            if(cursor + 1 < crossings.size() && crossings[cursor] <= x)
+            {
+              MatrixMath::Multiply3x3with3x1(gT, site[a], coordsT);
+              func(coordsT);
+            }
           }
         }
       }
@@ -451,57 +597,6 @@ void InsertAtoms::dataCheck()
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void InsertAtoms::assign_points(QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature)
-{
-  size_t count = 0;
-  int32_t numFeatures = points.size();
-  for(int32_t i = 0; i < numFeatures; i++)
-  {
-    int64_t numPoints = points[i]->getNumberOfVertices();
-    bool* inside = inFeature[i]->getPointer(0);
-    for(int64_t j = 0; j < numPoints; j++)
-    {
-      if(inside[j])
-      {
-        count++;
-      }
-    }
-  }
-
-  DataContainer::Pointer v = getDataContainerArray()->getDataContainer(getVertexDataContainerName());
-
-  VertexGeom::Pointer vertices = VertexGeom::CreateGeometry(count, SIMPL::VertexData::SurfaceMeshNodes);
-
-  AttributeMatrix::Pointer vertexAttrMat = v->getAttributeMatrix(getVertexAttributeMatrixName());
-  std::vector<size_t> tDims(1, count);
-  vertexAttrMat->resizeAttributeArrays(tDims);
-  updateVertexInstancePointers();
-
-  count = 0;
-  float coords[3] = {0.0f, 0.0f, 0.0f};
-  for(int32_t i = 0; i < numFeatures; i++)
-  {
-    int64_t numPoints = points[i]->getNumberOfVertices();
-    bool* inside = inFeature[i]->getPointer(0);
-    for(int64_t j = 0; j < numPoints; j++)
-    {
-      if(inside[j])
-      {
-        coords[0] = points[i]->getVertexPointer(j)[0];
-        coords[1] = points[i]->getVertexPointer(j)[1];
-        coords[2] = points[i]->getVertexPointer(j)[2];
-        vertices->setCoords(count, coords);
-        m_AtomFeatureLabels[count] = i;
-        count++;
-      }
-    }
-  }
-  v->setGeometry(vertices);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -569,13 +664,6 @@ void InsertAtoms::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  // create array to hold bounding vertices for each face
-  FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, std::string("Lower_Left_Internal_Use_Only"), true);
-  FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, std::string("Upper_Right_Internal_Use_Only"), true);
-  float* ll = llPtr->getPointer(0);
-  float* ur = urPtr->getPointer(0);
-  VertexGeom::Pointer faceBBs = VertexGeom::CreateGeometry(2 * numFaces, "faceBBs");
-
   // walk through faces to see how many features there are
   int32_t g1 = 0, g2 = 0;
   int32_t maxFeatureId = 0;
@@ -636,34 +724,53 @@ void InsertAtoms::execute()
     {
       faceLists->insertCellReference(g2, (linkLoc[g2])++, i);
     }
-    // find bounding box for each face
-    GeometryMath::FindBoundingBoxOfFace(triangleGeom.get(), i, ll, ur);
-    faceBBs->setCoords(2 * i, ll);
-    faceBBs->setCoords(2 * i + 1, ur);
   }
 
-  // generate the list of sampling points fom subclass
-  QVector<VertexGeom::Pointer> points(numFeatures);
-  QVector<BoolArrayType::Pointer> inFeature(numFeatures);
+  // count the atoms inside each Feature so the output can be allocated once
+  std::vector<int64_t> atomCounts(numFeatures, 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), InsertAtomsImpl(triangleGeom, faceLists, m_AvgQuats, latticeConstants, m_Basis, atomCounts.data(), nullptr, nullptr, nullptr),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    InsertAtomsImpl serial(triangleGeom, faceLists, m_AvgQuats, latticeConstants, m_Basis, atomCounts.data(), nullptr, nullptr, nullptr);
+    serial.checkPoints(0, numFeatures);
+  }
+
+  std::vector<int64_t> atomOffsets(numFeatures, 0);
+  int64_t totalAtoms = 0;
   for(int32_t i = 0; i < numFeatures; i++)
   {
-    points[i] = VertexGeom::CreateGeometry(0, "_INTERNAL_USE_ONLY_points");
-    inFeature[i] = BoolArrayType::CreateArray(0, std::string("_INTERNAL_USE_ONLY_inside"), true);
+    atomOffsets[i] = totalAtoms;
+    totalAtoms += atomCounts[i];
   }
 
+  DataContainer::Pointer v = getDataContainerArray()->getDataContainer(getVertexDataContainerName());
+  VertexGeom::Pointer vertices = VertexGeom::CreateGeometry(totalAtoms, SIMPL::VertexData::SurfaceMeshNodes);
+  AttributeMatrix::Pointer vertexAttrMat = v->getAttributeMatrix(getVertexAttributeMatrixName());
+  std::vector<size_t> tDims(1, static_cast<size_t>(totalAtoms));
+  vertexAttrMat->resizeAttributeArrays(tDims);
+  updateVertexInstancePointers();
+
+  // write the atoms of each Feature straight into the output
+  float* atoms = vertices->getVertexPointer(0);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), InsertAtomsImpl(triangleGeom, faceLists, faceBBs, m_AvgQuats, latticeConstants, m_Basis, points, inFeature), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
+                      InsertAtomsImpl(triangleGeom, faceLists, m_AvgQuats, latticeConstants, m_Basis, atomCounts.data(), atomOffsets.data(), atoms, m_AtomFeatureLabels), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    InsertAtomsImpl serial(triangleGeom, faceLists, faceBBs, m_AvgQuats, latticeConstants, m_Basis, points, inFeature);
+    InsertAtomsImpl serial(triangleGeom, faceLists, m_AvgQuats, latticeConstants, m_Basis, atomCounts.data(), atomOffsets.data(), atoms, m_AtomFeatureLabels);
     serial.checkPoints(0, numFeatures);
   }
-
-  assign_points(points, inFeature);
+  v->setGeometry(vertices);
 }
 
 // -----------------------------------------------------------------------------
@@ -246,13 +246,6 @@ protected:
    */
   void initialize();
 
-  /**
-   * @brief assign_points Assigns Feature Ids to the generated 'atoms'
-   * @param points VertexGeom object of 'atom' points
-   * @param inFeature Boolean array to determine inside/outside relationships for points
-   */
-  virtual void assign_points(QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature);
-
   /**
    * @brief updateVertexInstancePointers updates raw Vertex pointers
    */
@@ -37,6 +37,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <random>
@@ -344,6 +345,9 @@ void InsertPrecipitatePhases::initialize()
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
   m_rdfMax = m_rdfMin = m_StepSize = 0.0f;
   m_numRDFbins = 0;
+  m_RdfGrid.clear();
+  m_RdfGridRadius = 0.0f;
+  m_RdfComparedBins = 0;
 
   m_PrecipitatePhases.clear();
   m_PrecipitatePhaseFractions.clear();
@@ -1318,6 +1322,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   {
     // calculate the initial current RDF - this will change as we move particles
     // around
+    initializeRDFGrid();
     for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
       m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
@@ -1500,6 +1505,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     {
       testFile.close();
     }
+    m_RdfGrid.clear();
   }
 
   if(write_test_outputs)
@@ -1690,6 +1696,11 @@ void InsertPrecipitatePhases::move_precipitate(int32_t gnum, float xc, float yc,
     int64_t& pl = m_PlaneList[gnum][i];
     pl += shiftplane;
   }
+
+  if(m_RdfGrid.isActive())
+  {
+    m_RdfGrid.update(gnum, m_Centroids + 3 * gnum);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1949,6 +1960,38 @@ void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bo
   z = m_Centroids[3 * gnum + 2];
   size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
+  if(m_RdfGrid.isActive())
+  {
+    // Only pairs that land in a compared bin are counted, and only the normalized bins they touch are refreshed
+    float center[3] = {x, y, z};
+    int32_t binIncrement = double_count ? 2 * add : add;
+    m_RdfGrid.forEachCandidate(center, m_RdfGridRadius, [&](size_t n) {
+      if(m_FeaturePhases[n] != phase || n == static_cast<size_t>(gnum))
+      {
+        return;
+      }
+      xn = m_Centroids[3 * n];
+      yn = m_Centroids[3 * n + 1];
+      zn = m_Centroids[3 * n + 2];
+      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+
+      rdfBin = (r - m_rdfMin) / m_StepSize;
+
+      if(r < m_rdfMin)
+      {
+        rdfBin = -1;
+      }
+      size_t bin = static_cast<size_t>(rdfBin + 1);
+      if(bin >= m_RdfComparedBins)
+      {
+        return;
+      }
+      m_RdfCurrentDist[bin] += binIncrement;
+      m_RdfCurrentDistNorm[bin] = m_RdfCurrentDist[bin] / m_RdfRandom[bin];
+    });
+    return;
+  }
+
   for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
   {
     if(m_FeaturePhases[n] == phase && n != gnum)
@@ -2055,7 +2098,38 @@ float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, boo
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void InsertPrecipitatePhases::initializeRDFGrid()
+{
+  m_RdfGrid.clear();
+
+  // check_RDFerror only compares the leading bins that the current and target distributions have in common
+  m_RdfComparedBins = std::min(m_RdfCurrentDist.size(), m_RdfTargetDist.size());
+  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  if(m_RdfComparedBins == 0 || m_RdfRandom.size() < m_RdfComparedBins || numFeatures <= static_cast<size_t>(m_FirstPrecipitateFeature))
+  {
+    return;
+  }
+
+  // A pair lands in a compared bin only if it is closer than m_rdfMin + (m_RdfComparedBins - 1) * m_StepSize;
+  // the extra bin covers round off in the bin computation
+  m_RdfGridRadius = m_rdfMin + static_cast<float>(m_RdfComparedBins) * m_StepSize;
+  float size[3] = {m_SizeX, m_SizeY, m_SizeZ};
+  uint64_t numPPTfeatures = numFeatures - m_FirstPrecipitateFeature;
+  if(!m_RdfGrid.initialize(m_RdfGridRadius, size, numFeatures, 8 * numPPTfeatures + 8))
+  {
+    return;
+  }
+  for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
+  {
+    m_RdfGrid.update(n, m_Centroids + 3 * n);
+  }
+  m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, static_cast<int32_t>(numPPTfeatures));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0;
   float sum_array1 = 0.0f;
@@ -2076,9 +2150,9 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
 
   for(size_t i = 0; i < array1Size; i++)
   {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
+    float value1 = array1[i] / sum_array1;
+    float value2 = array2[i] / sum_array2;
+    bhattdist = bhattdist + sqrtf((value1 * value2));
   }
 }
 
@@ -47,6 +47,7 @@
 #include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/Utils/FeatureCentroidGrid.hpp"
 
 class IDataArray;
 using IDataArrayShPtrType = std::shared_ptr<IDataArray>;
@@ -623,6 +624,12 @@ protected:
    */
   float check_RDFerror(int32_t gadd, int32_t gremove, bool double_count);
 
+  /**
+   * @brief initializeRDFGrid Bins the precipitate centroids into a cell list sized to the largest separation that
+   * can fall into a compared RDF bin, so that determine_currentRDF only visits nearby precipitates
+   */
+  void initializeRDFGrid();
+
   /**
    * @brief assign_voxels Assigns precipitate Id values to voxels within the packing grid
    */
@@ -642,7 +649,7 @@ protected:
    * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+  void compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& sqrerror);
 
   /**
    * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
@@ -772,6 +779,11 @@ private:
   float m_StepSize = 0.0f;
   int32_t m_numRDFbins = 0;
 
+  // Cell list of precipitate centroids; while active only the RDF bins that enter the error are maintained
+  FeatureCentroidGrid m_RdfGrid;
+  float m_RdfGridRadius = 0.0f;
+  size_t m_RdfComparedBins = 0;
+
   std::vector<int32_t> m_PrecipitatePhases;
   std::vector<float> m_PrecipitatePhaseFractions;
 
@@ -35,6 +35,8 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include <QtCore/QDebug>
@@ -68,6 +70,8 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
+#include "Generic/GenericFilters/Utils/FilterTrace.hpp"
+
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
@@ -868,17 +872,26 @@ void PackPrimaryPhases::execute()
     return;
   }
 
+  FilterTrace::Session trace(getNameOfClass());
+
   if(getFeatureGeneration() == 0)
   {
     notifyStatusMessage("Packing Features || Initializing Volume");
     // this initializes the arrays to hold the details of the locations of all of the features during packing
-    Int32ArrayType::Pointer featureOwnersPtr = initializePackingGrid();
+    Int32ArrayType::Pointer featureOwnersPtr;
+    {
+      FilterTrace::ScopedPhase phase(trace, "Initialize Packing Grid");
+      featureOwnersPtr = initializePackingGrid();
+    }
     if(getErrorCode() < 0)
     {
       return;
     }
     notifyStatusMessage("Packing Features || Placing Features");
-    placeFeatures(featureOwnersPtr);
+    {
+      FilterTrace::ScopedPhase phase(trace, "Place Features");
+      placeFeatures(featureOwnersPtr);
+    }
     if(getErrorCode() < 0)
     {
       return;
@@ -892,6 +905,7 @@ void PackPrimaryPhases::execute()
   if(getFeatureGeneration() == 1)
   {
     notifyStatusMessage("Loading Features");
+    FilterTrace::ScopedPhase phase(trace, "Load Features");
     loadFeatures();
     if(getCancel())
     {
@@ -900,7 +914,10 @@ void PackPrimaryPhases::execute()
   }
 
   notifyStatusMessage("Packing Features || Assigning Voxels");
-  assignVoxels();
+  {
+    FilterTrace::ScopedPhase phase(trace, "Assign Voxels");
+    assignVoxels();
+  }
   if(getErrorCode() < 0)
   {
     return;
@@ -911,7 +928,10 @@ void PackPrimaryPhases::execute()
   }
 
   notifyStatusMessage("Packing Features || Assigning Gaps");
-  assignGapsOnly();
+  {
+    FilterTrace::ScopedPhase phase(trace, "Assign Gaps");
+    assignGapsOnly();
+  }
   if(getCancel())
   {
     return;
@@ -923,6 +943,7 @@ void PackPrimaryPhases::execute()
 
   if(m_WriteGoalAttributes)
   {
+    FilterTrace::ScopedPhase phase(trace, "Write Goal Attributes");
     writeGoalAttributes();
   }
   if(getErrorCode() < 0)
@@ -931,6 +952,10 @@ void PackPrimaryPhases::execute()
   }
 
   moveShapeDescriptions();
+  if(trace.isActive() && !m_FeaturePhasesPtr.expired())
+  {
+    trace.counter("Features", m_FeaturePhasesPtr.lock()->getNumberOfTuples());
+  }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
@@ -1149,6 +1174,8 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   m_CurrentNeighborhoodError = 0.0f;
   m_OldNeighborhoodError = 0.0f;
   m_CurrentSizeDistError = 0.0f;
+  m_NeighborhoodHistogramsActive = false;
+  m_CentroidGrid.clear();
   m_OldSizeDistError = 0.0f;
   int32_t acceptedmoves = 0;
   float totalprimaryfractions = 0.0f;
@@ -1495,6 +1522,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   float timeDiff = 0.0f;
 
   // determine neighborhoods and initial neighbor distribution errors
+  initializeCentroidGrid();
   for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
   {
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -1510,6 +1538,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     }
     determineNeighbors(i, true);
   }
+  initializeNeighborhoodHistograms();
   m_OldNeighborhoodError = checkNeighborhoodError(-1000, -1000);
 
   // begin swaping/moving/adding/removing features to try to improve packing
@@ -1722,6 +1751,10 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     }
   }
 
+  m_NeighborhoodHistogramsActive = false;
+  m_NeighborhoodHistograms.clear();
+  m_CentroidGrid.clear();
+
   if(!m_VtkOutputFile.isEmpty())
   {
     int32_t err = writeVtkFile(featureOwnersPtr->getPointer(0), exclusionOwnersPtr->getPointer(0));
@@ -1947,6 +1980,11 @@ void PackPrimaryPhases::moveFeature(size_t gnum, float xc, float yc, float zc)
     int64_t& pl = m_PlaneList[gnum][i];
     pl += shiftplane;
   }
+
+  if(m_CentroidGrid.isActive())
+  {
+    m_CentroidGrid.update(gnum, m_Centroids + 3 * gnum);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1957,9 +1995,7 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
   float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float dia = 0.0f, dia2 = 0.0f;
-  float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+  float dia = 0.0f;
   x = m_Centroids[3 * gnum];
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
@@ -1974,24 +2010,181 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
   {
     increment = -1;
   }
-  for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
-  {
-    xn = m_Centroids[3 * n];
-    yn = m_Centroids[3 * n + 1];
-    zn = m_Centroids[3 * n + 2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
+
+  auto addToNeighborhood = [&](size_t featureId) {
+    if(m_NeighborhoodHistogramsActive)
+    {
+      updateNeighborhoodHistogram(featureId, -1);
+    }
+    m_Neighborhoods[featureId] = m_Neighborhoods[featureId] + increment;
+    if(m_NeighborhoodHistogramsActive)
+    {
+      updateNeighborhoodHistogram(featureId, 1);
+    }
+  };
+
+  auto checkNeighbor = [&](size_t n) {
+    float xn = m_Centroids[3 * n];
+    float yn = m_Centroids[3 * n + 1];
+    float zn = m_Centroids[3 * n + 2];
+    float dia2 = m_EquivalentDiameters[n];
+    float dx = fabs(x - xn);
+    float dy = fabs(y - yn);
+    float dz = fabs(z - zn);
     if(dx < dia && dy < dia && dz < dia)
     {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+      addToNeighborhood(gnum);
     }
     if(dx < dia2 && dy < dia2 && dz < dia2)
     {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      addToNeighborhood(n);
+    }
+  };
+
+  if(!m_CentroidGrid.isActive())
+  {
+    for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
+    {
+      checkNeighbor(n);
     }
+    return;
   }
+
+  // Both tests require every component of the centroid separation to be below the diameter of one of the
+  // two Features, so only Features within the largest primary Feature diameter can pass either of them
+  float center[3] = {x, y, z};
+  m_CentroidGrid.forEachCandidate(center, m_MaxPrimaryDiameter, checkNeighbor);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initializeCentroidGrid()
+{
+  m_CentroidGrid.clear();
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+  if(totalFeatures <= static_cast<size_t>(m_FirstPrimaryFeature))
+  {
+    return;
+  }
+
+  m_MaxPrimaryDiameter = 0.0f;
+  for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
+  {
+    m_MaxPrimaryDiameter = std::max(m_MaxPrimaryDiameter, m_EquivalentDiameters[n]);
+  }
+
+  // Keep the number of cells on the order of the number of Features so sparse packings do not allocate mostly empty cells
+  float size[3] = {m_SizeX, m_SizeY, m_SizeZ};
+  uint64_t numPrimaryFeatures = totalFeatures - m_FirstPrimaryFeature;
+  if(!m_CentroidGrid.initialize(m_MaxPrimaryDiameter, size, totalFeatures, 8 * numPrimaryFeatures + 8))
+  {
+    return;
+  }
+  for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
+  {
+    m_CentroidGrid.update(n, m_Centroids + 3 * n);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initializeNeighborhoodHistograms()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
+
+  m_NeighborhoodHistogramsActive = false;
+  m_NeighborhoodHistograms.clear();
+  m_PrimaryPhaseIndices.clear();
+
+  size_t numPhases = m_SimNeighborDist.size();
+  m_NeighborhoodHistograms.resize(numPhases);
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    int32_t phase = m_PrimaryPhases[iter];
+    PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[phase]);
+    NeighborhoodHistogram& histogram = m_NeighborhoodHistograms[iter];
+    histogram.maxFeatureDia = pp->getMaxFeatureDiameter();
+    histogram.minFeatureDia = pp->getMinFeatureDiameter();
+    histogram.oneOverBinStepSize = 1.0f / pp->getBinStepSize();
+    histogram.oneOverNeighborDistStep = 1.0f / m_NeighborDistStep[iter];
+    histogram.binCounts.assign(m_SimNeighborDist[iter].size() * 40, 0);
+    histogram.diaCounts.assign(m_SimNeighborDist[iter].size(), 0);
+    if(phase >= static_cast<int32_t>(m_PrimaryPhaseIndices.size()))
+    {
+      m_PrimaryPhaseIndices.resize(phase + 1, -1);
+    }
+    m_PrimaryPhaseIndices[phase] = static_cast<int32_t>(iter);
+  }
+
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    updateNeighborhoodHistogram(i, 1);
+  }
+  m_NeighborhoodHistogramsActive = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::findNeighborhoodBin(size_t gnum, size_t& phaseIndex, size_t& diabin, size_t& nnumbin) const
+{
+  int32_t phase = m_FeaturePhases[gnum];
+  if(phase < 0 || phase >= static_cast<int32_t>(m_PrimaryPhaseIndices.size()) || m_PrimaryPhaseIndices[phase] < 0)
+  {
+    return false;
+  }
+  phaseIndex = static_cast<size_t>(m_PrimaryPhaseIndices[phase]);
+  const NeighborhoodHistogram& histogram = m_NeighborhoodHistograms[phaseIndex];
+  size_t numDiaBins = histogram.diaCounts.size();
+  if(numDiaBins == 0)
+  {
+    return false;
+  }
+
+  float dia = m_EquivalentDiameters[gnum];
+  if(dia > histogram.maxFeatureDia)
+  {
+    dia = histogram.maxFeatureDia;
+  }
+  if(dia < histogram.minFeatureDia)
+  {
+    dia = histogram.minFeatureDia;
+  }
+  diabin = static_cast<size_t>(((dia - histogram.minFeatureDia) * histogram.oneOverBinStepSize));
+  if(diabin >= numDiaBins)
+  {
+    diabin = numDiaBins - 1;
+  }
+  int32_t nnum = m_Neighborhoods[gnum];
+  nnumbin = static_cast<size_t>(nnum * histogram.oneOverNeighborDistStep);
+  if(nnumbin >= 40)
+  {
+    nnumbin = 39;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateNeighborhoodHistogram(size_t gnum, int32_t increment)
+{
+  size_t phaseIndex = 0;
+  size_t diabin = 0;
+  size_t nnumbin = 0;
+  if(!findNeighborhoodBin(gnum, phaseIndex, diabin, nnumbin))
+  {
+    return;
+  }
+  NeighborhoodHistogram& histogram = m_NeighborhoodHistograms[phaseIndex];
+  histogram.binCounts[diabin * 40 + nnumbin] += increment;
+  histogram.diaCounts[diabin] += increment;
 }
 
 // -----------------------------------------------------------------------------
@@ -2046,34 +2239,56 @@ float PackPrimaryPhases::checkNeighborhoodError(int32_t gadd, int32_t gremove)
     float oneOverBinStepSize = 1.0f / pp->getBinStepSize();
 
     size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
-    for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+    if(m_NeighborhoodHistogramsActive)
     {
-      nnum = 0;
-      index = static_cast<int32_t>(i);
-      if(index != gremove && m_FeaturePhases[index] == phase)
+      // The histogram already holds every Feature of this phase, so only the removed Feature has to be taken out
+      const NeighborhoodHistogram& histogram = m_NeighborhoodHistograms[iter];
+      for(size_t i = 0; i < curSImNeighborDist_Size; i++)
       {
-        dia = m_EquivalentDiameters[index];
-        if(dia > maxFeatureDia)
-        {
-          dia = maxFeatureDia;
-        }
-        if(dia < minFeatureDia)
-        {
-          dia = minFeatureDia;
-        }
-        diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
-        if(diabin >= curSImNeighborDist_Size)
+        for(size_t j = 0; j < 40; j++)
         {
-          diabin = curSImNeighborDist_Size - 1;
+          curSimNeighborDist[i][j] = static_cast<float>(histogram.binCounts[i * 40 + j]);
         }
-        nnum = m_Neighborhoods[index];
-        nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
-        if(nnumbin >= 40)
+        count[i] = histogram.diaCounts[i];
+      }
+      size_t phaseIndex = 0;
+      if(gremove >= m_FirstPrimaryFeature && static_cast<size_t>(gremove) < totalFeatures && findNeighborhoodBin(gremove, phaseIndex, diabin, nnumbin) && phaseIndex == iter)
+      {
+        curSimNeighborDist[diabin][nnumbin]--;
+        count[diabin]--;
+      }
+    }
+    else
+    {
+      for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+      {
+        nnum = 0;
+        index = static_cast<int32_t>(i);
+        if(index != gremove && m_FeaturePhases[index] == phase)
         {
-          nnumbin = 39;
+          dia = m_EquivalentDiameters[index];
+          if(dia > maxFeatureDia)
+          {
+            dia = maxFeatureDia;
+          }
+          if(dia < minFeatureDia)
+          {
+            dia = minFeatureDia;
+          }
+          diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
+          if(diabin >= curSImNeighborDist_Size)
+          {
+            diabin = curSImNeighborDist_Size - 1;
+          }
+          nnum = m_Neighborhoods[index];
+          nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
+          if(nnumbin >= 40)
+          {
+            nnumbin = 39;
+          }
+          curSimNeighborDist[diabin][nnumbin]++;
+          count[diabin]++;
         }
-        curSimNeighborDist[diabin][nnumbin]++;
-        count[diabin]++;
       }
     }
     if(gadd > 0 && m_FeaturePhases[gadd] == phase)
@@ -45,6 +45,8 @@
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
 
+#include "SyntheticBuilding/SyntheticBuildingFilters/Utils/FeatureCentroidGrid.hpp"
+
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 
 struct Feature_t
@@ -530,6 +532,35 @@ protected:
    */
   float checkNeighborhoodError(int32_t gadd, int32_t gremove);
 
+  /**
+   * @brief initializeCentroidGrid Bins the primary Feature centroids into a uniform grid whose cell size is tied to the
+   * largest primary Feature equivalent diameter, so that determineNeighbors only visits Features in the surrounding cells
+   */
+  void initializeCentroidGrid();
+
+  /**
+   * @brief initializeNeighborhoodHistograms Counts the current neighborhood of every primary Feature into per phase
+   * histograms that determineNeighbors keeps up to date, so checkNeighborhoodError does not have to recount every Feature
+   */
+  void initializeNeighborhoodHistograms();
+
+  /**
+   * @brief findNeighborhoodBin Finds the neighborhood histogram bin of a Feature from its equivalent diameter and current neighborhood
+   * @param gnum Id for the Feature
+   * @param phaseIndex Index of the Feature phase in the primary phases
+   * @param diabin Diameter bin
+   * @param nnumbin Neighborhood bin
+   * @return True if the Feature belongs to a primary phase
+   */
+  bool findNeighborhoodBin(size_t gnum, size_t& phaseIndex, size_t& diabin, size_t& nnumbin) const;
+
+  /**
+   * @brief updateNeighborhoodHistogram Adds or removes a Feature from the bin of its current neighborhood
+   * @param gnum Id for the Feature
+   * @param increment Value to add to the bin
+   */
+  void updateNeighborhoodHistogram(size_t gnum, int32_t increment);
+
   /**
    * @brief check_fillingerror Computes the percentage of unassigned or multiple assigned packing points
    * @param gadd Value that determines whether to add point Ids to be filled
@@ -731,6 +762,24 @@ private:
   float m_CurrentNeighborhoodError, m_OldNeighborhoodError;
   float m_CurrentSizeDistError, m_OldSizeDistError;
 
+  // Uniform grid of primary Feature centroids used to limit the neighborhood search to nearby Features
+  FeatureCentroidGrid m_CentroidGrid;
+  float m_MaxPrimaryDiameter = 0.0f;
+
+  // Per primary phase neighborhood histograms (diameter bin * 40 + neighborhood bin) kept in step with m_Neighborhoods
+  struct NeighborhoodHistogram
+  {
+    float minFeatureDia = 0.0f;
+    float maxFeatureDia = 0.0f;
+    float oneOverBinStepSize = 0.0f;
+    float oneOverNeighborDistStep = 0.0f;
+    std::vector<int32_t> binCounts;
+    std::vector<int32_t> diaCounts;
+  };
+  std::vector<NeighborhoodHistogram> m_NeighborhoodHistograms;
+  std::vector<int32_t> m_PrimaryPhaseIndices;
+  bool m_NeighborhoodHistogramsActive = false;
+
   QString m_ErrorOutputFile;
   QString m_VtkOutputFile;
 
@@ -0,0 +1,201 @@
+/* ============================================================================
+ * Copyright (c) 2021-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The FeatureCentroidGrid class bins Feature centroids into a uniform grid over the packing box so that
+ * the Features within a given distance of a point can be found by visiting the surrounding cells instead of every
+ * Feature. Features are moved between cells as their centroids change. Centroids outside the box are clamped into
+ * the boundary cells, and query windows are padded slightly so that round off in the caller's distance test can
+ * never exclude a Feature the caller would accept.
+ */
+class FeatureCentroidGrid
+{
+public:
+  FeatureCentroidGrid() = default;
+  ~FeatureCentroidGrid() = default;
+
+  FeatureCentroidGrid(const FeatureCentroidGrid&) = delete;            // Copy Constructor Not Implemented
+  FeatureCentroidGrid(FeatureCentroidGrid&&) = delete;                 // Move Constructor Not Implemented
+  FeatureCentroidGrid& operator=(const FeatureCentroidGrid&) = delete; // Copy Assignment Not Implemented
+  FeatureCentroidGrid& operator=(FeatureCentroidGrid&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief initialize Sets up an empty grid. The cell size is doubled until the grid has at most maxCells cells.
+   * @param cellSize Smallest cell edge length
+   * @param boxSize Extent of the packing box
+   * @param numFeatures Number of Feature ids that may be inserted
+   * @param maxCells Upper bound on the number of cells
+   * @return False if the cell size is not a positive finite value, in which case the grid stays inactive
+   */
+  bool initialize(float cellSize, const float boxSize[3], size_t numFeatures, uint64_t maxCells)
+  {
+    clear();
+    if(!(cellSize > 0.0f) || !std::isfinite(cellSize))
+    {
+      return false;
+    }
+
+    m_CellSize = cellSize;
+    while(true)
+    {
+      uint64_t numCells = 1;
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Dims[d] = std::max(static_cast<int64_t>(1), static_cast<int64_t>(std::ceil(boxSize[d] / m_CellSize)));
+        numCells *= static_cast<uint64_t>(m_Dims[d]);
+      }
+      if(numCells <= std::max(maxCells, static_cast<uint64_t>(1)))
+      {
+        break;
+      }
+      m_CellSize *= 2.0f;
+    }
+
+    m_Cells.resize(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+    m_FeatureCells.assign(numFeatures, -1);
+    m_FeatureSlots.assign(numFeatures, 0);
+    return true;
+  }
+
+  /**
+   * @brief clear Releases the grid
+   */
+  void clear()
+  {
+    m_CellSize = 0.0f;
+    m_Dims[0] = m_Dims[1] = m_Dims[2] = 0;
+    m_Cells.clear();
+    m_FeatureCells.clear();
+    m_FeatureSlots.clear();
+  }
+
+  /**
+   * @brief isActive Returns whether the grid has been initialized
+   * @return
+   */
+  bool isActive() const
+  {
+    return !m_Cells.empty();
+  }
+
+  /**
+   * @brief update Inserts a Feature, or moves it into the cell that contains its current centroid
+   * @param featureId Id of the Feature
+   * @param centroid Centroid of the Feature
+   */
+  void update(size_t featureId, const float* centroid)
+  {
+    if(featureId >= m_FeatureCells.size())
+    {
+      return;
+    }
+
+    int64_t newCell = (cellCoordinate(centroid[2], 2) * m_Dims[1] + cellCoordinate(centroid[1], 1)) * m_Dims[0] + cellCoordinate(centroid[0], 0);
+    int64_t oldCell = m_FeatureCells[featureId];
+    if(newCell == oldCell)
+    {
+      return;
+    }
+
+    if(oldCell >= 0)
+    {
+      // Swap the last Feature of the old cell into the vacated slot
+      std::vector<size_t>& cell = m_Cells[oldCell];
+      size_t slot = m_FeatureSlots[featureId];
+      cell[slot] = cell.back();
+      m_FeatureSlots[cell[slot]] = slot;
+      cell.pop_back();
+    }
+    std::vector<size_t>& cell = m_Cells[newCell];
+    m_FeatureSlots[featureId] = cell.size();
+    cell.push_back(featureId);
+    m_FeatureCells[featureId] = newCell;
+  }
+
+  /**
+   * @brief forEachCandidate Calls func(featureId) for every Feature in the cells that overlap the cube of half
+   * width radius around center. This is a superset of the Features whose centroid components are all within
+   * radius of center; the caller applies its own distance test.
+   * @param center Query point
+   * @param radius Half width of the query cube
+   * @param func Callable taking the Feature id
+   */
+  template <typename Func>
+  void forEachCandidate(const float center[3], float radius, Func&& func) const
+  {
+    int64_t minCell[3] = {0, 0, 0};
+    int64_t maxCell[3] = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      float pad = radius + 1.0E-5f * (radius + std::fabs(center[d]));
+      minCell[d] = cellCoordinate(center[d] - pad, d);
+      maxCell[d] = cellCoordinate(center[d] + pad, d);
+    }
+    for(int64_t plane = minCell[2]; plane <= maxCell[2]; plane++)
+    {
+      for(int64_t row = minCell[1]; row <= maxCell[1]; row++)
+      {
+        for(int64_t column = minCell[0]; column <= maxCell[0]; column++)
+        {
+          for(const size_t& featureId : m_Cells[(plane * m_Dims[1] + row) * m_Dims[0] + column])
+          {
+            func(featureId);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  float m_CellSize = 0.0f;
+  int64_t m_Dims[3] = {0, 0, 0};
+  std::vector<std::vector<size_t>> m_Cells;
+  std::vector<int64_t> m_FeatureCells;
+  std::vector<size_t> m_FeatureSlots;
+
+  int64_t cellCoordinate(float value, size_t dim) const
+  {
+    float cell = std::floor(value / m_CellSize);
+    return static_cast<int64_t>(std::max(0.0f, std::min(cell, static_cast<float>(m_Dims[dim] - 1))));
+  }
+};
@@ -0,0 +1,426 @@
+/* ============================================================================
+ * Copyright (c) 2009-2021 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#if defined(_WIN32)
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/IGeometry.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/TestObserver.h"
+
+#include "PipelineBenchmark.h"
+
+/**
+ * PipelineBenchmark runs a list of pipelines filter by filter and records the wall time, the
+ * process peak resident set size and the throughput (geometry elements per second) of every
+ * filter. Any filter exposing an IntVec3Type "Dimensions" property that creates a volume
+ * (InitializeSyntheticVolume, CreateImageGeometry) is resized to each requested cube edge length
+ * so the same synthetic pipelines can be timed from 128^3 up to 1024^3. The results are written as
+ * JSON so that two builds can be compared with any diff tool or script.
+ *
+ * The peak resident set size is the process wide high water mark at the time the filter
+ * finished, so it never decreases within a single run. Run one size per invocation to get an
+ * uncontaminated number for the larger sizes.
+ */
+
+namespace
+{
+const QStringList k_ResizableFilters = {"InitializeSyntheticVolume", "CreateImageGeometry"};
+const QString k_OutputFileProperty("OutputFile");
+const QString k_DimensionsProperty("Dimensions");
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t GetPeakResidentSetSize()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(counters.PeakWorkingSetSize);
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  // Linux reports the high water mark in kilobytes
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t GetLargestGeometrySize(const DataContainerArray::Pointer& dca)
+{
+  size_t numElements = 0;
+  for(const auto& dc : dca->getDataContainers())
+  {
+    IGeometry::Pointer geom = dc->getGeometry();
+    if(nullptr != geom)
+    {
+      numElements = std::max(numElements, geom->getNumberOfElements());
+    }
+  }
+  return numElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer ReadPipeline(const QString& pipelineFile)
+{
+  QFileInfo fi(pipelineFile);
+  if(!fi.exists())
+  {
+    std::cout << "The pipeline file '" << pipelineFile.toStdString() << "' does not exist" << std::endl;
+    return FilterPipeline::NullPointer();
+  }
+
+  if(fi.suffix() == "dream3d")
+  {
+    H5FilterParametersReader::Pointer dream3dReader = H5FilterParametersReader::New();
+    return dream3dReader->readPipelineFromFile(pipelineFile);
+  }
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  return jsonReader->readPipelineFromFile(pipelineFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AdjustDataPath(QString filePath)
+{
+  // The prebuilt pipelines use paths relative to the DREAM3D_Data directory and write into Data/Output
+  QString outputPrefix = QString::fromLatin1("Data/Output/");
+  int index = filePath.indexOf(outputPrefix);
+  if(index >= 0)
+  {
+    return PipelineBenchmark::TestTempDir + "/" + filePath.mid(index + outputPrefix.size());
+  }
+  if(filePath.startsWith("Data/"))
+  {
+    return PipelineBenchmark::DataDir + "/" + filePath;
+  }
+  return filePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ConfigurePipeline(const FilterPipeline::Pointer& pipeline, int dimension)
+{
+  for(const auto& filter : pipeline->getFilterContainer())
+  {
+    if(dimension > 0 && k_ResizableFilters.contains(filter->getNameOfClass()))
+    {
+      QVariant var;
+      var.setValue(IntVec3Type(dimension, dimension, dimension));
+      if(!filter->setProperty(k_DimensionsProperty.toLatin1().constData(), var))
+      {
+        std::cout << "Unable to set the Dimensions of filter " << filter->getNameOfClass().toStdString() << std::endl;
+      }
+    }
+
+    QVariant outputFile = filter->property(k_OutputFileProperty.toLatin1().constData());
+    if(outputFile.isValid() && !outputFile.toString().isEmpty())
+    {
+      QString adjusted = AdjustDataPath(outputFile.toString());
+      QFileInfo fi(adjusted);
+      QDir().mkpath(fi.absolutePath());
+      filter->setProperty(k_OutputFileProperty.toLatin1().constData(), adjusted);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject BenchmarkPipeline(const QString& pipelineFile, int dimension, int iteration, const QStringList& selectedFilters, int& err)
+{
+  QJsonObject run;
+  run["Pipeline"] = QFileInfo(pipelineFile).completeBaseName();
+  run["Pipeline_File"] = QFileInfo(pipelineFile).absoluteFilePath();
+  run["Dimension"] = dimension;
+  run["Iteration"] = iteration;
+
+  FilterPipeline::Pointer pipeline = ReadPipeline(pipelineFile);
+  if(nullptr == pipeline.get())
+  {
+    err = -1;
+    run["Error_Code"] = err;
+    return run;
+  }
+  ConfigurePipeline(pipeline, dimension);
+
+  TestObserver obs;
+  pipeline->addMessageReceiver(&obs);
+  err = pipeline->preflightPipeline();
+  if(err < 0)
+  {
+    std::cout << "Errors preflighting the pipeline " << pipelineFile.toStdString() << std::endl;
+    run["Error_Code"] = err;
+    return run;
+  }
+
+  // Execute the filters one at a time, the same way FilterPipeline::execute() does, so that each
+  // one can be timed on its own
+  QJsonArray filterResults;
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  BenchmarkClock::time_point pipelineStart = BenchmarkClock::now();
+  int index = 0;
+  for(const auto& filter : pipeline->getFilterContainer())
+  {
+    index++;
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    std::cout << "  [" << index << "] " << filter->getHumanLabel().toStdString() << std::flush;
+
+    filter->setDataContainerArray(dca);
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    filter->execute();
+    double seconds = std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+    filter->setDataContainerArray(DataContainerArray::New());
+    err = filter->getErrorCode();
+
+    size_t numElements = GetLargestGeometrySize(dca);
+    std::cout << "  " << seconds << " s" << std::endl;
+
+    if(selectedFilters.isEmpty() || selectedFilters.contains(filter->getNameOfClass()))
+    {
+      QJsonObject result;
+      result["Index"] = index;
+      result["Filter_Name"] = filter->getNameOfClass();
+      result["Filter_Human_Label"] = filter->getHumanLabel();
+      result["Wall_Time_Seconds"] = seconds;
+      result["Peak_RSS_Bytes"] = static_cast<double>(GetPeakResidentSetSize());
+      result["Elements"] = static_cast<double>(numElements);
+      result["Elements_Per_Second"] = seconds > 0.0 ? static_cast<double>(numElements) / seconds : 0.0;
+      result["Error_Code"] = err;
+      filterResults.append(result);
+    }
+
+    if(err < 0)
+    {
+      std::cout << "Filter " << filter->getNameOfClass().toStdString() << " failed with error " << err << std::endl;
+      break;
+    }
+  }
+  double totalSeconds = std::chrono::duration<double>(BenchmarkClock::now() - pipelineStart).count();
+
+  size_t numElements = GetLargestGeometrySize(dca);
+  run["Wall_Time_Seconds"] = totalSeconds;
+  run["Peak_RSS_Bytes"] = static_cast<double>(GetPeakResidentSetSize());
+  run["Elements"] = static_cast<double>(numElements);
+  run["Elements_Per_Second"] = totalSeconds > 0.0 ? static_cast<double>(numElements) / totalSeconds : 0.0;
+  run["Error_Code"] = err;
+  run["Filters"] = filterResults;
+  return run;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ReadPipelineList(const QString& listFile)
+{
+  QStringList pipelines;
+  QFile source(listFile);
+  if(!source.open(QFile::ReadOnly))
+  {
+    return pipelines;
+  }
+  QTextStream in(&source);
+  while(!in.atEnd())
+  {
+    QString line = in.readLine().trimmed();
+    if(!line.isEmpty() && !line.startsWith("#"))
+    {
+      pipelines.push_back(line);
+    }
+  }
+  return pipelines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> ParseDimensions(const QString& value)
+{
+  QVector<int> dimensions;
+  for(const QString& token : value.split(",", QString::SkipEmptyParts))
+  {
+    bool ok = false;
+    int dim = token.trimmed().toInt(&ok);
+    if(ok && dim > 0)
+    {
+      dimensions.push_back(dim);
+    }
+  }
+  return dimensions;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("PipelineBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Times each filter of a set of DREAM3D pipelines and writes the results as JSON");
+  parser.addHelpOption();
+  QCommandLineOption pipelineOption({"p", "pipeline"}, "Pipeline file to benchmark. May be given more than once.", "file");
+  QCommandLineOption listOption({"l", "list"}, "Text file with one pipeline file per line.", "file", PipelineBenchmark::PipelineListFile);
+  QCommandLineOption dimsOption({"d", "dimensions"}, "Comma separated cube edge lengths for the generated volume, e.g. 128,256,512. Use 0 to keep the pipeline's own size.",
+                                "sizes", PipelineBenchmark::DefaultDimensions);
+  QCommandLineOption iterationsOption({"n", "iterations"}, "Number of times each pipeline is run at each size.", "count", "1");
+  QCommandLineOption filterOption({"f", "filter"}, "Only report this filter class. May be given more than once.", "class");
+  QCommandLineOption outputOption({"o", "output"}, "JSON file the results are written into.", "file", PipelineBenchmark::DefaultOutputFile);
+  parser.addOptions({pipelineOption, listOption, dimsOption, iterationsOption, filterOption, outputOption});
+  parser.process(app);
+
+  QStringList pipelines = parser.values(pipelineOption);
+  if(pipelines.isEmpty())
+  {
+    pipelines = ReadPipelineList(parser.value(listOption));
+  }
+  if(pipelines.isEmpty())
+  {
+    std::cout << "No pipelines were given to benchmark" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QVector<int> dimensions = ParseDimensions(parser.value(dimsOption));
+  if(dimensions.isEmpty())
+  {
+    dimensions.push_back(0);
+  }
+  int iterations = std::max(1, parser.value(iterationsOption).toInt());
+  QStringList selectedFilters = parser.values(filterOption);
+
+  QDir().mkpath(PipelineBenchmark::TestTempDir);
+
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  int err = EXIT_SUCCESS;
+  QJsonArray runs;
+  for(const QString& pipelineFile : pipelines)
+  {
+    for(int dimension : dimensions)
+    {
+      for(int iteration = 0; iteration < iterations; iteration++)
+      {
+        std::cout << QFileInfo(pipelineFile).completeBaseName().toStdString() << " @ " << dimension << "^3 [" << iteration << "]" << std::endl;
+        int runErr = 0;
+        runs.append(BenchmarkPipeline(pipelineFile, dimension, iteration, selectedFilters, runErr));
+        if(runErr < 0)
+        {
+          err = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  QJsonObject root;
+  root["Date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+  root["SIMPLib_Version"] = SIMPLib::Version::Complete();
+  root["Runs"] = runs;
+
+  QFile output(parser.value(outputOption));
+  if(!output.open(QFile::WriteOnly))
+  {
+    std::cout << "Unable to open the output file " << output.fileName().toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+  output.write(QJsonDocument(root).toJson());
+  output.close();
+  std::cout << "Benchmark results written to " << output.fileName().toStdString() << std::endl;
+
+  QDir(PipelineBenchmark::TestTempDir).removeRecursively();
+
+  return err;
+}